@@ -0,0 +1,410 @@
+// headless benchmark: plays each level with a scripted input sequence in a hidden window
+// and prints frame time percentiles, per phase CPU time and draw calls as JSON, plus the
+// startup time: World::init and drawing the start screen until every texture is uploaded
+//
+// chameleon_bench [--frames N] [--hz rate] [--levels 1,2,...] [--scenario file] [--out file]
+//                 [--baseline file] [--tolerance 0.1]
+//
+// --scenario runs a generated level (chameleon_scenario_gen) after the levels, reported as
+// level 998000 (LEVEL_SCENARIO)
+//
+// no GPU needed: run under Mesa llvmpipe, e.g. LIBGL_ALWAYS_SOFTWARE=1 xvfb-run ./chameleon_bench
+// the output is also the baseline format, save a run and pass it back with --baseline to
+// fail (exit code 1) when a level's p95 frame time grows by more than the tolerance
+
+// internal
+#include "common.hpp"
+#include "world.hpp"
+
+#define GL3W_IMPLEMENTATION
+#include <gl3w.h>
+
+// stdlib
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+using Clock = std::chrono::steady_clock;
+
+// global, same as the game
+World world;
+
+// held key and for how many frames, the sequence repeats for the whole run
+struct script_step
+{
+	int key;
+	int frames;
+};
+
+// walks a square, dashes and cycles colours (arrow keys with the default wasd controls)
+const script_step SCRIPT[] = {
+	{GLFW_KEY_D, 40},
+	{GLFW_KEY_UP, 1},
+	{GLFW_KEY_S, 40},
+	{GLFW_KEY_SPACE, 1},
+	{GLFW_KEY_A, 40},
+	{GLFW_KEY_LEFT, 1},
+	{GLFW_KEY_W, 40},
+	{GLFW_KEY_RIGHT, 1},
+	{GLFW_KEY_D, 20},
+	{GLFW_KEY_SPACE, 1},
+	{GLFW_KEY_DOWN, 1},
+};
+const int SCRIPT_LENGTH = sizeof(SCRIPT) / sizeof(SCRIPT[0]);
+
+const unsigned int LEVELS[] = {LEVEL_1, LEVEL_2, LEVEL_3, LEVEL_4, LEVEL_5};
+
+struct bench_options
+{
+	int frames = 1200;
+	float hz = 25.f;
+	std::vector<unsigned int> levels;
+	const char *scenario = nullptr;
+	const char *out = nullptr;
+	const char *baseline = nullptr;
+	float tolerance = 0.1f;
+};
+
+struct level_result
+{
+	unsigned int level;
+	int frames;
+	float p50;
+	float p95;
+	float p99;
+	float mean;
+	float max;
+	float draw_calls; // per frame
+	std::map<std::string, float> phases; // mean ms per frame
+};
+
+struct startup_result
+{
+	float init_ms;
+	float textures_ms; // after init, until the last texture is uploaded
+	int packed;        // textures found in data/textures.pak
+	texture_residency resident; // after the last level
+};
+
+////////////////////
+// DRAW CALL COUNTING
+////////////////////
+
+// gl3w calls through function pointers, wrapping them counts every draw without touching the entities
+int g_draw_calls = 0;
+PFNGLDRAWELEMENTSPROC g_draw_elements = nullptr;
+PFNGLDRAWARRAYSPROC g_draw_arrays = nullptr;
+PFNGLDRAWARRAYSINSTANCEDPROC g_draw_arrays_instanced = nullptr;
+
+void APIENTRY count_draw_elements(GLenum mode, GLsizei count, GLenum type, const void *indices)
+{
+	g_draw_calls++;
+	g_draw_elements(mode, count, type, indices);
+}
+
+void APIENTRY count_draw_arrays(GLenum mode, GLint first, GLsizei count)
+{
+	g_draw_calls++;
+	g_draw_arrays(mode, first, count);
+}
+
+void APIENTRY count_draw_arrays_instanced(GLenum mode, GLint first, GLsizei count, GLsizei instances)
+{
+	g_draw_calls++;
+	g_draw_arrays_instanced(mode, first, count, instances);
+}
+
+void hook_draw_calls()
+{
+	g_draw_elements = gl3wDrawElements;
+	g_draw_arrays = gl3wDrawArrays;
+	g_draw_arrays_instanced = gl3wDrawArraysInstanced;
+	gl3wDrawElements = count_draw_elements;
+	gl3wDrawArrays = count_draw_arrays;
+	gl3wDrawArraysInstanced = count_draw_arrays_instanced;
+}
+
+////////////////////
+// RUN
+////////////////////
+
+float elapsed_ms(Clock::time_point start)
+{
+	return std::chrono::duration<float, std::milli>(Clock::now() - start).count();
+}
+
+// nearest rank on sorted samples
+float percentile(const std::vector<float> &sorted, float p)
+{
+	if (sorted.empty())
+		return 0.f;
+	size_t rank = (size_t)(p * (sorted.size() - 1) + 0.5f);
+	return sorted[std::min(rank, sorted.size() - 1)];
+}
+
+// level has to be started
+bool run_level(unsigned int level, const bench_options &options, level_result &result)
+{
+	float step_ms = 1000.f / options.hz;
+	std::vector<float> frame_ms;
+	frame_ms.reserve(options.frames);
+	std::map<std::string, float> phases;
+	long long draw_calls = 0;
+
+	int step = 0;
+	int held = 0;
+	for (int frame = 0; frame < options.frames; frame++)
+	{
+		// scripted input
+		if (held == 0)
+		{
+			world.inject_key(SCRIPT[step].key, GLFW_PRESS);
+			held = SCRIPT[step].frames;
+		}
+
+		Clock::time_point start = Clock::now();
+		world.update(step_ms);
+		float update_ms = elapsed_ms(start);
+
+		// glFinish keeps the rasterizer's work inside the frame it belongs to
+		Clock::time_point draw_start = Clock::now();
+		g_draw_calls = 0;
+		world.draw();
+		glFinish();
+		float draw_ms = elapsed_ms(draw_start);
+
+		frame_ms.push_back(elapsed_ms(start));
+		draw_calls += g_draw_calls;
+		phases["update"] += update_ms;
+		phases["draw"] += draw_ms;
+		for (const job_timing &timing : world.get_job_timings())
+			phases[std::string("update.") + timing.name] += timing.ms;
+
+		if (--held == 0)
+		{
+			world.inject_key(SCRIPT[step].key, GLFW_RELEASE);
+			step = (step + 1) % SCRIPT_LENGTH;
+		}
+	}
+
+	// leave nothing held for the next level
+	if (held > 0)
+		world.inject_key(SCRIPT[step].key, GLFW_RELEASE);
+
+	float total = 0.f;
+	for (float ms : frame_ms)
+		total += ms;
+	std::sort(frame_ms.begin(), frame_ms.end());
+
+	result.level = level;
+	result.frames = options.frames;
+	result.p50 = percentile(frame_ms, 0.50f);
+	result.p95 = percentile(frame_ms, 0.95f);
+	result.p99 = percentile(frame_ms, 0.99f);
+	result.mean = total / options.frames;
+	result.max = frame_ms.back();
+	result.draw_calls = (float)draw_calls / options.frames;
+	for (auto &phase : phases)
+		result.phases[phase.first] = phase.second / options.frames;
+	return true;
+}
+
+////////////////////
+// REPORT
+////////////////////
+
+// one level per line so the baseline reader doesn't need a json parser
+void write_report(FILE *out, const bench_options &options, const startup_result &startup, const std::vector<level_result> &results)
+{
+	fprintf(out, "{\n");
+	fprintf(out, "\"frames\": %d, \"hz\": %.1f, \"threads\": %d,\n", options.frames, options.hz, (int)std::thread::hardware_concurrency());
+	fprintf(out, "\"startup_ms\": {\"init\": %.3f, \"textures\": %.3f, \"packed\": %d},\n", startup.init_ms, startup.textures_ms,
+			startup.packed);
+	fprintf(out, "\"textures\": {\"count\": %d, \"kb\": %.1f, \"owners_kb\": {", startup.resident.textures,
+			startup.resident.bytes / 1024.0);
+	for (size_t i = 0; i < startup.resident.owners.size(); i++)
+	{
+		const owner_residency &owner = startup.resident.owners[i];
+		fprintf(out, "%s\"%s\": %.1f", i == 0 ? "" : ", ", owner.owner.c_str(), owner.bytes / 1024.0);
+	}
+	fprintf(out, "}},\n");
+	fprintf(out, "\"levels\": [\n");
+	for (size_t i = 0; i < results.size(); i++)
+	{
+		const level_result &r = results[i];
+		fprintf(out, "{\"level\": %u, \"frame_ms\": {\"p50\": %.3f, \"p95\": %.3f, \"p99\": %.3f, \"mean\": %.3f, \"max\": %.3f}, \"draw_calls\": %.1f, \"phases_ms\": {",
+				r.level, r.p50, r.p95, r.p99, r.mean, r.max, r.draw_calls);
+		bool first = true;
+		for (auto &phase : r.phases)
+		{
+			fprintf(out, "%s\"%s\": %.3f", first ? "" : ", ", phase.first.c_str(), phase.second);
+			first = false;
+		}
+		fprintf(out, "}}%s\n", i + 1 < results.size() ? "," : "");
+	}
+	fprintf(out, "]\n}\n");
+}
+
+// reads "level" and "p95" back from a previous report
+bool read_baseline(const char *path, std::map<unsigned int, float> &p95)
+{
+	FILE *file = fopen(path, "r");
+	if (file == nullptr)
+	{
+		fprintf(stderr, "Failed to open baseline %s\n", path);
+		return false;
+	}
+
+	char line[4096];
+	while (fgets(line, sizeof(line), file) != nullptr)
+	{
+		const char *level = strstr(line, "\"level\":");
+		const char *p = strstr(line, "\"p95\":");
+		unsigned int id;
+		float ms;
+		if (level != nullptr && p != nullptr && sscanf(level, "\"level\": %u", &id) == 1 && sscanf(p, "\"p95\": %f", &ms) == 1)
+			p95[id] = ms;
+	}
+	fclose(file);
+	return true;
+}
+
+bool parse_options(int argc, char *argv[], bench_options &options)
+{
+	for (int i = 1; i < argc; i++)
+	{
+		bool has_value = i + 1 < argc;
+		if (strcmp(argv[i], "--frames") == 0 && has_value)
+			options.frames = std::max(1, atoi(argv[++i]));
+		else if (strcmp(argv[i], "--hz") == 0 && has_value)
+			options.hz = std::max(1.f, (float)atof(argv[++i]));
+		else if (strcmp(argv[i], "--scenario") == 0 && has_value)
+			options.scenario = argv[++i];
+		else if (strcmp(argv[i], "--out") == 0 && has_value)
+			options.out = argv[++i];
+		else if (strcmp(argv[i], "--baseline") == 0 && has_value)
+			options.baseline = argv[++i];
+		else if (strcmp(argv[i], "--tolerance") == 0 && has_value)
+			options.tolerance = (float)atof(argv[++i]);
+		else if (strcmp(argv[i], "--levels") == 0 && has_value)
+		{
+			// 1..5
+			for (char *token = strtok(argv[++i], ","); token != nullptr; token = strtok(nullptr, ","))
+			{
+				int n = atoi(token);
+				if (n < 1 || n > 5)
+				{
+					fprintf(stderr, "Unknown level %s, expected 1..5\n", token);
+					return false;
+				}
+				options.levels.push_back(LEVELS[n - 1]);
+			}
+		}
+		else
+		{
+			fprintf(stderr, "Unknown argument %s\n", argv[i]);
+			return false;
+		}
+	}
+
+	// only the scenario when it's given alone
+	if (options.levels.empty() && options.scenario == nullptr)
+		options.levels.assign(LEVELS, LEVELS + 5);
+	return true;
+}
+} // namespace
+
+int main(int argc, char *argv[])
+{
+	bench_options options;
+	if (!parse_options(argc, argv, options))
+		return EXIT_FAILURE;
+
+	Scenario scenario;
+	if (options.scenario != nullptr && !scenario.load(options.scenario))
+		return EXIT_FAILURE;
+
+	// no sound card on build machines
+	SDL_setenv("SDL_AUDIODRIVER", "dummy", 0);
+
+	startup_result startup;
+	Clock::time_point start = Clock::now();
+	if (!world.init(false))
+	{
+		fprintf(stderr, "Failed to initialize the world\n");
+		return EXIT_FAILURE;
+	}
+	startup.init_ms = elapsed_ms(start);
+	world.set_vsync(false);
+
+	// the start screen is drawn while textures decode, like the game's first frames
+	start = Clock::now();
+	while (world.get_pending_textures() > 0)
+		world.draw();
+	startup.textures_ms = elapsed_ms(start);
+	startup.packed = world.get_packed_textures();
+	hook_draw_calls();
+
+	std::vector<level_result> results;
+	for (unsigned int level : options.levels)
+	{
+		level_result result;
+		if (!world.start_level(level) || !run_level(level, options, result))
+		{
+			world.destroy();
+			return EXIT_FAILURE;
+		}
+		results.push_back(result);
+	}
+	if (options.scenario != nullptr)
+	{
+		level_result result;
+		if (!world.start_scenario(scenario) || !run_level(LEVEL_SCENARIO, options, result))
+		{
+			world.destroy();
+			return EXIT_FAILURE;
+		}
+		results.push_back(result);
+	}
+	startup.resident = world.get_texture_residency();
+	world.destroy();
+
+	FILE *out = stdout;
+	if (options.out != nullptr && (out = fopen(options.out, "w")) == nullptr)
+	{
+		fprintf(stderr, "Failed to open %s\n", options.out);
+		return EXIT_FAILURE;
+	}
+	write_report(out, options, startup, results);
+	if (out != stdout)
+		fclose(out);
+
+	if (options.baseline == nullptr)
+		return EXIT_SUCCESS;
+
+	std::map<unsigned int, float> baseline;
+	if (!read_baseline(options.baseline, baseline))
+		return EXIT_FAILURE;
+
+	bool regressed = false;
+	for (const level_result &r : results)
+	{
+		auto it = baseline.find(r.level);
+		if (it == baseline.end())
+			continue;
+		if (r.p95 > it->second * (1.f + options.tolerance))
+		{
+			fprintf(stderr, "Regression: level %u p95 %.3f ms, baseline %.3f ms\n", r.level, r.p95, it->second);
+			regressed = true;
+		}
+	}
+	return regressed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
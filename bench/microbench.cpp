@@ -0,0 +1,348 @@
+// microbenchmarks for the gameplay kernels the frame is spent in, on every shipped level
+//
+// chameleon_microbench [google benchmark flags]
+//
+// reports JSON on stdout by default, names are stable ("group/kernel/level:N/arg:M") so a
+// recorded run can be diffed against a new one, e.g. with google benchmark's compare.py:
+//   chameleon_microbench --benchmark_out=baseline.json
+//   chameleon_microbench --benchmark_out=new.json
+//   compare.py benchmarks baseline.json new.json
+//
+// the kernels run on the chameleon_core simulation classes, no window or GL context is
+// created, so it runs on machines without a display or GPU
+
+// internal
+#include "bullets_sim.hpp"
+#include "char_sim.hpp"
+#include "level_grid.hpp"
+#include "spotter_sim.hpp"
+#include "wanderer_sim.hpp"
+
+#include <benchmark/benchmark.h>
+
+// stdlib
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+struct level_info
+{
+	unsigned int level;
+	const char *name;
+};
+
+const level_info LEVELS[] = {
+	{LEVEL_TUTORIAL, "tutorial"},
+	{LEVEL_1, "1"},
+	{LEVEL_2, "2"},
+	{LEVEL_3, "3"},
+	{LEVEL_4, "4"},
+	{LEVEL_5, "5"},
+};
+
+const int PATH_LIMITS[] = {0, 10, 40};
+const int BULLET_COUNTS[] = {8, 64, 512};
+
+// samples per benchmark, the loop walks them so branch predictors can't learn one input
+const int SAMPLES = 1024;
+
+// segments no longer than a spotter's view, like the line of sight checks in game
+const float SEGMENT_LENGTH = 100.f;
+
+LevelGrid g_level;
+CharSim g_char;
+SpotterSim g_spotter;
+WandererSim g_wanderer;
+
+////////////////////
+// INPUTS
+////////////////////
+
+// same seed every run, inputs only depend on the level
+std::mt19937 make_rng(unsigned int level)
+{
+	return std::mt19937(level * 2654435761u);
+}
+
+std::vector<vec2> floor_tiles(const LevelGrid &grid)
+{
+	std::vector<vec2> tiles;
+	for (int y = 0; y < grid.get_height(); y++)
+		for (int x = 0; x < grid.get_width(); x++)
+			if (!grid.is_wall_tile(x, y))
+				tiles.push_back({(float)x, (float)y});
+	return tiles;
+}
+
+vec2 pick(const std::vector<vec2> &tiles, std::mt19937 &rng)
+{
+	return tiles[std::uniform_int_distribution<size_t>(0, tiles.size() - 1)(rng)];
+}
+
+// floor tile farthest from the spawn, the longest search the level can ask for
+vec2 farthest_tile(const std::vector<vec2> &tiles, vec2 from)
+{
+	vec2 best = from;
+	float best_distance = -1.f;
+	for (vec2 tile : tiles)
+	{
+		float distance = std::abs(tile.x - from.x) + std::abs(tile.y - from.y);
+		if (distance > best_distance)
+		{
+			best = tile;
+			best_distance = distance;
+		}
+	}
+	return best;
+}
+
+////////////////////
+// BENCHMARKS
+////////////////////
+
+void bm_check_wall_segment(benchmark::State &state, unsigned int level)
+{
+	g_level.load(level);
+	std::mt19937 rng = make_rng(level);
+	std::vector<vec2> tiles = floor_tiles(g_level);
+	std::uniform_real_distribution<float> angle(0.f, 6.2831853f);
+
+	std::vector<vec2> from(SAMPLES);
+	std::vector<vec2> to(SAMPLES);
+	for (int i = 0; i < SAMPLES; i++)
+	{
+		from[i] = LevelGrid::get_tile_center_coords(pick(tiles, rng));
+		float a = angle(rng);
+		to[i] = add(from[i], {std::cos(a) * SEGMENT_LENGTH, std::sin(a) * SEGMENT_LENGTH});
+	}
+
+	int i = 0;
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(g_level.is_segment_blocked(from[i], to[i]));
+		i = (i + 1) % SAMPLES;
+	}
+}
+
+void bm_check_wall_char(benchmark::State &state, unsigned int level)
+{
+	g_level.load(level);
+	std::mt19937 rng = make_rng(level);
+	std::vector<vec2> tiles = floor_tiles(g_level);
+
+	std::vector<vec2> positions(SAMPLES);
+	for (int i = 0; i < SAMPLES; i++)
+		positions[i] = LevelGrid::get_tile_center_coords(pick(tiles, rng));
+
+	// diagonal movement tests both a row and a column
+	g_char.set_direction('R', true);
+	g_char.set_direction('D', true);
+
+	int i = 0;
+	for (auto _ : state)
+	{
+		// check_wall pushes the char out of walls, every iteration starts from the sample
+		g_char.set_position(positions[i]);
+		g_char.check_wall(40.f);
+		i = (i + 1) % SAMPLES;
+	}
+
+	g_char.set_direction('R', false);
+	g_char.set_direction('D', false);
+}
+
+void bm_get_tile_type(benchmark::State &state, unsigned int level)
+{
+	g_level.load(level);
+	std::mt19937 rng = make_rng(level);
+	const LevelGrid &grid = g_level;
+	std::uniform_real_distribution<float> x(0.f, grid.get_width() * TILE_SIZE);
+	std::uniform_real_distribution<float> y(0.f, grid.get_height() * TILE_SIZE);
+
+	std::vector<vec2> positions(SAMPLES);
+	for (vec2 &position : positions)
+		position = {x(rng), y(rng)};
+
+	int i = 0;
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(g_level.get_tile_type(positions[i]));
+		i = (i + 1) % SAMPLES;
+	}
+}
+
+void bm_calculate_immediate_path(benchmark::State &state, unsigned int level, int limit)
+{
+	g_level.load(level);
+	std::vector<vec2> tiles = floor_tiles(g_level);
+	vec2 start = LevelGrid::get_grid_coords(g_level.get_spawn_pos());
+	vec2 goal = farthest_tile(tiles, start);
+	vec2 start_position = LevelGrid::get_tile_center_coords(start);
+
+	for (auto _ : state)
+	{
+		g_wanderer.set_position(start_position);
+		g_wanderer.calculate_immediate_path(goal, limit);
+	}
+}
+
+void bm_is_colliding_bullets(benchmark::State &state, int count)
+{
+	g_level.load(LEVEL_1);
+	vec2 center = {SCREEN_WIDTH / 2.f, SCREEN_HEIGHT / 2.f};
+	g_char.set_position(center);
+
+	// nothing hits, so every call walks all bullets like the common case in game
+	std::mt19937 rng = make_rng(count);
+	std::uniform_real_distribution<float> x(0.f, SCREEN_WIDTH);
+	std::uniform_real_distribution<float> y(0.f, SCREEN_HEIGHT);
+	BulletsSim bullets;
+	while ((int)bullets.m_bullets.size() < count)
+	{
+		BulletsSim::Bullet bullet = {1.f, {x(rng), y(rng)}, 5.f, {0.f, 0.f}};
+		if (std::abs(bullet.position.x - center.x) > 2 * TILE_SIZE || std::abs(bullet.position.y - center.y) > 2 * TILE_SIZE)
+			bullets.m_bullets.push_back(bullet);
+	}
+
+	for (auto _ : state)
+		benchmark::DoNotOptimize(g_char.is_colliding(bullets));
+	state.SetItemsProcessed(state.iterations() * count);
+}
+
+void bm_is_in_sight(benchmark::State &state, unsigned int level)
+{
+	g_level.load(level);
+	std::mt19937 rng = make_rng(level);
+	std::vector<vec2> tiles = floor_tiles(g_level);
+
+	vec2 spotter_position = LevelGrid::get_tile_center_coords(pick(tiles, rng));
+	g_spotter.set_position(spotter_position);
+	g_spotter.direction = {1.f, 0.f};
+
+	// chars around the spotter, in and out of its view
+	std::uniform_real_distribution<float> offset(-2.f * SEGMENT_LENGTH, 2.f * SEGMENT_LENGTH);
+	std::vector<vec2> positions(SAMPLES);
+	for (vec2 &position : positions)
+		position = add(spotter_position, {offset(rng), offset(rng)});
+
+	int i = 0;
+	for (auto _ : state)
+	{
+		g_char.set_position(positions[i]);
+		benchmark::DoNotOptimize(g_spotter.is_in_sight(g_char, g_level));
+		i = (i + 1) % SAMPLES;
+	}
+}
+
+// the cone is cached, this is what a level change or a moved spotter costs
+void bm_compute_visibility(benchmark::State &state, unsigned int level)
+{
+	g_level.load(level);
+	std::mt19937 rng = make_rng(level);
+	std::vector<vec2> tiles = floor_tiles(g_level);
+	g_spotter.set_position(LevelGrid::get_tile_center_coords(pick(tiles, rng)));
+
+	for (auto _ : state)
+		g_spotter.compute_visibility(g_level);
+}
+
+void bm_mul_mat3(benchmark::State &state)
+{
+	mat3 a = {{1.f, 0.5f, 0.f}, {-0.5f, 1.f, 0.f}, {10.f, 20.f, 1.f}};
+	mat3 b = {{0.9f, 0.1f, 0.f}, {-0.1f, 0.9f, 0.f}, {-3.f, 4.f, 1.f}};
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(a);
+		benchmark::DoNotOptimize(b);
+		benchmark::DoNotOptimize(mul(a, b));
+	}
+}
+
+// what every entity does per draw before setting its uniforms
+void bm_transform(benchmark::State &state)
+{
+	Transform transform;
+	vec2 position = {600.f, 400.f};
+	vec2 scale = {0.4f, 0.4f};
+	float rotation = 0.7f;
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(position);
+		transform.begin();
+		transform.translate(position);
+		transform.rotate(rotation);
+		transform.scale(scale);
+		transform.end();
+		benchmark::DoNotOptimize(transform.out);
+	}
+}
+
+void register_benchmarks()
+{
+	for (const level_info &info : LEVELS)
+	{
+		std::string suffix = std::string("/level:") + info.name;
+		benchmark::RegisterBenchmark(("map/check_wall_segment" + suffix).c_str(), bm_check_wall_segment, info.level);
+		benchmark::RegisterBenchmark(("map/check_wall_char" + suffix).c_str(), bm_check_wall_char, info.level);
+		benchmark::RegisterBenchmark(("map/get_tile_type" + suffix).c_str(), bm_get_tile_type, info.level);
+		for (int limit : PATH_LIMITS)
+			benchmark::RegisterBenchmark(("wanderer/calculate_immediate_path" + suffix + "/limit:" + std::to_string(limit)).c_str(), bm_calculate_immediate_path, info.level, limit);
+		benchmark::RegisterBenchmark(("spotter/is_in_sight" + suffix).c_str(), bm_is_in_sight, info.level);
+		benchmark::RegisterBenchmark(("spotter/compute_visibility" + suffix).c_str(), bm_compute_visibility, info.level);
+	}
+
+	for (int count : BULLET_COUNTS)
+		benchmark::RegisterBenchmark(("char/is_colliding_bullets/bullets:" + std::to_string(count)).c_str(), bm_is_colliding_bullets, count);
+
+	benchmark::RegisterBenchmark("geometry/mul_mat3", bm_mul_mat3);
+	benchmark::RegisterBenchmark("entity/transform", bm_transform);
+}
+
+////////////////////
+// SETUP
+////////////////////
+
+bool init_entities()
+{
+	if (!g_level.load(LEVEL_TUTORIAL))
+	{
+		fprintf(stderr, "Failed to load the tutorial level\n");
+		return false;
+	}
+
+	g_char.init(g_level.get_spawn_pos(), g_level);
+	g_spotter.init();
+
+	// the path only matters for init, the benchmarks pick their own goals
+	vec2 spawn = LevelGrid::get_grid_coords(g_level.get_spawn_pos());
+	g_wanderer.init({spawn, spawn}, g_level, g_char);
+	return true;
+}
+} // namespace
+
+int main(int argc, char *argv[])
+{
+	// json unless the command line asks for another format, later flags win
+	std::vector<char *> args(argv, argv + argc);
+	char json_format[] = "--benchmark_format=json";
+	args.insert(args.begin() + 1, json_format);
+	int args_count = (int)args.size();
+
+	benchmark::Initialize(&args_count, args.data());
+	if (benchmark::ReportUnrecognizedArguments(args_count, args.data()))
+		return EXIT_FAILURE;
+
+	if (!init_entities())
+		return EXIT_FAILURE;
+
+	register_benchmarks();
+	benchmark::RunSpecifiedBenchmarks();
+	benchmark::Shutdown();
+	return EXIT_SUCCESS;
+}
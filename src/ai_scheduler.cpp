@@ -0,0 +1,112 @@
+// header
+#include "ai_scheduler.hpp"
+
+AiScheduler::AiScheduler() : m_tick(0),
+							 m_focus({0.f, 0.f}),
+							 m_view_min({0.f, 0.f}),
+							 m_view_max({0.f, 0.f})
+{
+}
+
+void AiScheduler::set_budget(const lod_budget &budget)
+{
+	m_budget = budget;
+	if (m_budget.mid_interval < 1)
+		m_budget.mid_interval = 1;
+	if (m_budget.far_interval < 1)
+		m_budget.far_interval = 1;
+}
+
+const lod_budget &AiScheduler::get_budget() const
+{
+	return m_budget;
+}
+
+const lod_stats &AiScheduler::get_stats() const
+{
+	return m_stats;
+}
+
+void AiScheduler::reset_stats()
+{
+	m_stats = lod_stats();
+}
+
+void AiScheduler::reset()
+{
+	for (auto &slots : m_slots)
+		slots.clear();
+}
+
+void AiScheduler::begin_tick(vec2 focus, vec2 view_point, vec2 view_size)
+{
+	m_tick++;
+	m_focus = focus;
+	m_view_min = {view_point.x - m_budget.view_margin, view_point.y - m_budget.view_margin};
+	m_view_max = {view_point.x + view_size.x + m_budget.view_margin, view_point.y + view_size.y + m_budget.view_margin};
+	m_stats.near = 0;
+	m_stats.mid = 0;
+	m_stats.far = 0;
+}
+
+int AiScheduler::schedule(int type, int index, vec2 position, bool alert, float &ms)
+{
+	std::vector<lod_slot> &slots = m_slots[type];
+	if ((int)slots.size() <= index)
+		slots.resize(index + 1, {NEAR, 0.f});
+	lod_slot &slot = slots[index];
+
+	int band = alert ? NEAR : classify(position);
+	if (alert && slot.band != NEAR)
+		m_stats.promotions++;
+	slot.band = band;
+	slot.pending_ms += ms;
+
+	int interval = 1;
+	if (band == NEAR)
+	{
+		m_stats.near++;
+	}
+	else if (band == MID)
+	{
+		m_stats.mid++;
+		interval = m_budget.mid_interval;
+	}
+	else
+	{
+		m_stats.far++;
+		interval = m_budget.far_interval;
+	}
+
+	// the index offsets the phase so a band doesn't update all at once
+	if ((m_tick + index) % interval != 0)
+	{
+		m_stats.skipped++;
+		return RUN_SKIP;
+	}
+
+	ms = slot.pending_ms;
+	slot.pending_ms = 0.f;
+
+	if (band == FAR)
+	{
+		m_stats.coarse_updates++;
+		return RUN_COARSE;
+	}
+	m_stats.full_updates++;
+	return RUN_FULL;
+}
+
+int AiScheduler::classify(vec2 position) const
+{
+	if (position.x >= m_view_min.x && position.x <= m_view_max.x &&
+		position.y >= m_view_min.y && position.y <= m_view_max.y)
+		return NEAR;
+
+	float d_sq = sq_len(sub(position, m_focus));
+	if (d_sq < m_budget.near_radius * m_budget.near_radius)
+		return NEAR;
+	if (d_sq < m_budget.mid_radius * m_budget.mid_radius)
+		return MID;
+	return FAR;
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+// internal
+#include "geometry.hpp"
+
+// stlib
+#include <vector>
+
+// distance bands in world px, radii are measured from the char
+struct lod_budget
+{
+	float near_radius = 200.f; // must cover the widest guard sight radius (spotter: 70)
+	float mid_radius = 400.f;
+	float view_margin = 40.f;  // grows the camera rect, guards inside it are always near
+	int mid_interval = 3;      // ticks between mid band updates
+	int far_interval = 10;     // ticks between far band (coarse) updates
+};
+
+// band counts are for the last tick, the rest accumulate until reset_stats
+struct lod_stats
+{
+	int near = 0;
+	int mid = 0;
+	int far = 0;
+	int full_updates = 0;
+	int coarse_updates = 0;
+	int skipped = 0;
+	int promotions = 0; // mid/far guards forced to full rate by alert mode
+};
+
+// AI level of detail, decides per guard and per tick whether to run the full
+// update, a coarse update or nothing. Skipped time is accumulated and handed
+// to the next update that runs, so slow bands still cover the same distance.
+class AiScheduler
+{
+public:
+	// bands
+	static constexpr int NEAR = 0;
+	static constexpr int MID = 1;
+	static constexpr int FAR = 2;
+
+	// what schedule() asks the caller to run
+	static constexpr int RUN_SKIP = 0;
+	static constexpr int RUN_FULL = 1;
+	static constexpr int RUN_COARSE = 2;
+
+private:
+	struct lod_slot
+	{
+		int band;
+		float pending_ms;
+	};
+
+	// one list per guard type (SpatialGrid::WANDERER, SPOTTER, SHOOTER)
+	std::vector<lod_slot> m_slots[3];
+	lod_budget m_budget;
+	lod_stats m_stats;
+	unsigned int m_tick;
+
+	vec2 m_focus;
+	vec2 m_view_min;
+	vec2 m_view_max;
+
+private:
+	int classify(vec2 position) const;
+
+public:
+	AiScheduler();
+
+	void set_budget(const lod_budget &budget);
+	const lod_budget &get_budget() const;
+	const lod_stats &get_stats() const;
+	void reset_stats();
+
+	// drops every slot, call when the guard lists are cleared
+	void reset();
+
+	// once per tick before any schedule() call, view is the camera rect
+	void begin_tick(vec2 focus, vec2 view_point, vec2 view_size);
+
+	// alert guards are always near, ms is replaced by the time the update has to cover
+	int schedule(int type, int index, vec2 position, bool alert, float &ms);
+};
@@ -0,0 +1,262 @@
+// header
+#include "asset_archive.hpp"
+
+// stlib
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+static_assert(sizeof(AssetArchive::header) == 32, "header layout");
+static_assert(sizeof(AssetArchive::entry) == 32, "entry layout");
+
+namespace
+{
+size_t align(size_t bytes, size_t alignment)
+{
+	return (bytes + alignment - 1) / alignment * alignment;
+}
+
+int level_count(int width, int height, bool mips)
+{
+	int levels = 1;
+	while (mips && (width >> levels > 0 || height >> levels > 0))
+		levels++;
+	return levels;
+}
+
+// each texel averages the 2x2 block above it, edges of odd sizes repeat the last texel
+void downsample(const unsigned char *src, int width, int height, unsigned char *dst)
+{
+	int w = std::max(1, width / 2);
+	int h = std::max(1, height / 2);
+	for (int y = 0; y < h; y++)
+	{
+		int y0 = std::min(2 * y, height - 1);
+		int y1 = std::min(2 * y + 1, height - 1);
+		for (int x = 0; x < w; x++)
+		{
+			int x0 = std::min(2 * x, width - 1);
+			int x1 = std::min(2 * x + 1, width - 1);
+			for (int c = 0; c < 4; c++)
+			{
+				int sum = src[(y0 * width + x0) * 4 + c] + src[(y0 * width + x1) * 4 + c] +
+						  src[(y1 * width + x0) * 4 + c] + src[(y1 * width + x1) * 4 + c];
+				dst[(y * w + x) * 4 + c] = (unsigned char)((sum + 2) / 4);
+			}
+		}
+	}
+}
+
+bool write_padding(FILE *file, size_t bytes)
+{
+	static const unsigned char zeros[AssetArchive::PAYLOAD_ALIGNMENT] = {};
+	return bytes == 0 || fwrite(zeros, 1, bytes, file) == bytes;
+}
+} // namespace
+
+size_t AssetArchive::chain_bytes(int width, int height, int levels)
+{
+	size_t bytes = 0;
+	for (int level = 0; level < levels; level++)
+		bytes += (size_t)std::max(1, width >> level) * std::max(1, height >> level) * 4;
+	return bytes;
+}
+
+// the table and names are laid out first, then each payload is streamed behind them
+bool AssetArchive::write(const char *path, const std::vector<archive_source> &sources, bool mips)
+{
+	std::vector<const archive_source *> sorted;
+	for (const archive_source &source : sources)
+	{
+		if (source.width <= 0 || source.height <= 0 || source.pixels.size() != (size_t)source.width * source.height * 4)
+		{
+			fprintf(stderr, "Invalid texture %s\n", source.name.c_str());
+			return false;
+		}
+		sorted.push_back(&source);
+	}
+	std::sort(sorted.begin(), sorted.end(), [](const archive_source *a, const archive_source *b) {
+		return a->name < b->name;
+	});
+
+	header h = {};
+	h.magic = MAGIC;
+	h.version = VERSION;
+	h.entry_count = (uint32_t)sorted.size();
+	h.entries_offset = sizeof(header);
+	h.names_offset = h.entries_offset + h.entry_count * sizeof(entry);
+
+	std::vector<entry> entries(sorted.size());
+	std::string names;
+	size_t offset = 0;
+	for (size_t i = 0; i < sorted.size(); i++)
+	{
+		entries[i].name_offset = h.names_offset + (uint32_t)names.size();
+		names += sorted[i]->name;
+		names += '\0';
+	}
+	offset = align(h.names_offset + names.size(), PAYLOAD_ALIGNMENT);
+	for (size_t i = 0; i < sorted.size(); i++)
+	{
+		const archive_source &source = *sorted[i];
+		entry &e = entries[i];
+		e.width = (uint32_t)source.width;
+		e.height = (uint32_t)source.height;
+		e.levels = (uint32_t)level_count(source.width, source.height, mips);
+		e.offset = offset;
+		e.size = chain_bytes(source.width, source.height, (int)e.levels);
+		offset = align(offset + e.size, PAYLOAD_ALIGNMENT);
+	}
+	h.size = offset;
+
+	FILE *file = fopen(path, "wb");
+	if (file == nullptr)
+	{
+		fprintf(stderr, "Failed to open %s\n", path);
+		return false;
+	}
+
+	bool ok = fwrite(&h, sizeof(header), 1, file) == 1;
+	ok = ok && (entries.empty() || fwrite(entries.data(), sizeof(entry), entries.size(), file) == entries.size());
+	ok = ok && fwrite(names.data(), 1, names.size(), file) == names.size();
+	size_t written = h.names_offset + names.size();
+
+	std::vector<unsigned char> level;
+	std::vector<unsigned char> next;
+	for (size_t i = 0; i < sorted.size() && ok; i++)
+	{
+		const archive_source &source = *sorted[i];
+		const entry &e = entries[i];
+		ok = write_padding(file, (size_t)e.offset - written);
+
+		level = source.pixels;
+		int width = source.width;
+		int height = source.height;
+		for (uint32_t l = 0; l < e.levels && ok; l++)
+		{
+			ok = fwrite(level.data(), 1, level.size(), file) == level.size();
+			if (l + 1 == e.levels)
+				break;
+
+			next.resize((size_t)std::max(1, width / 2) * std::max(1, height / 2) * 4);
+			downsample(level.data(), width, height, next.data());
+			level.swap(next);
+			width = std::max(1, width / 2);
+			height = std::max(1, height / 2);
+		}
+		written = (size_t)(e.offset + e.size);
+	}
+	ok = ok && write_padding(file, (size_t)h.size - written);
+
+	ok = fclose(file) == 0 && ok;
+	if (!ok)
+		fprintf(stderr, "Failed to write %s\n", path);
+	return ok;
+}
+
+bool AssetArchive::open(const char *path)
+{
+	close();
+	if (!m_file.open(path))
+		return false;
+
+	return validate(path);
+}
+
+void AssetArchive::close()
+{
+	m_file.close();
+}
+
+// every offset, size and name is checked once here, find() trusts them afterwards
+bool AssetArchive::validate(const char *path)
+{
+	size_t size = m_file.get_size();
+	const char *error = nullptr;
+	if (size < sizeof(header))
+		error = "truncated";
+	else
+	{
+		const header &h = get_header();
+		uint64_t entries_end = h.entries_offset + (uint64_t)h.entry_count * sizeof(entry);
+		if (h.magic != MAGIC)
+			error = "not an asset archive";
+		else if (h.version != VERSION)
+			error = "unsupported version";
+		else if (h.size > size)
+			error = "truncated";
+		else if (h.entries_offset % 8 != 0 || h.entries_offset < sizeof(header) || entries_end > h.names_offset ||
+				 h.names_offset > h.size)
+			error = "table out of bounds";
+
+		const char *previous = nullptr;
+		for (uint32_t i = 0; i < h.entry_count && error == nullptr; i++)
+		{
+			const entry &e = get_entries()[i];
+			const char *name = reinterpret_cast<const char *>(m_file.get_data()) + e.name_offset;
+			if (e.name_offset < h.names_offset || e.name_offset >= h.size ||
+				memchr(name, '\0', (size_t)(h.size - e.name_offset)) == nullptr)
+				error = "name out of bounds";
+			else if (previous != nullptr && strcmp(previous, name) >= 0)
+				error = "entries out of order";
+			else if (e.width == 0 || e.height == 0 || e.levels == 0 || e.levels > 32 ||
+					 e.size != chain_bytes((int)e.width, (int)e.height, (int)e.levels))
+				error = "invalid texture";
+			else if (e.offset % PAYLOAD_ALIGNMENT != 0 || e.offset > h.size || e.size > h.size - e.offset)
+				error = "payload out of bounds";
+			previous = name;
+		}
+	}
+
+	if (error == nullptr)
+		return true;
+
+	fprintf(stderr, "Invalid asset archive %s: %s\n", path, error);
+	close();
+	return false;
+}
+
+const AssetArchive::header &AssetArchive::get_header() const
+{
+	return *reinterpret_cast<const header *>(m_file.get_data());
+}
+
+const AssetArchive::entry *AssetArchive::get_entries() const
+{
+	return reinterpret_cast<const entry *>(m_file.get_data() + get_header().entries_offset);
+}
+
+const char *AssetArchive::get_name(const entry &e) const
+{
+	return reinterpret_cast<const char *>(m_file.get_data()) + e.name_offset;
+}
+
+bool AssetArchive::is_open() const
+{
+	return m_file.is_open();
+}
+
+int AssetArchive::get_count() const
+{
+	return is_open() ? (int)get_header().entry_count : 0;
+}
+
+bool AssetArchive::find(const char *name, archive_texture &texture) const
+{
+	if (!is_open() || name == nullptr)
+		return false;
+
+	const entry *begin = get_entries();
+	const entry *end = begin + get_header().entry_count;
+	const entry *it = std::lower_bound(begin, end, name, [this](const entry &e, const char *n) {
+		return strcmp(get_name(e), n) < 0;
+	});
+	if (it == end || strcmp(get_name(*it), name) != 0)
+		return false;
+
+	texture.width = (int)it->width;
+	texture.height = (int)it->height;
+	texture.levels = (int)it->levels;
+	texture.pixels = m_file.get_data() + it->offset;
+	return true;
+}
@@ -0,0 +1,89 @@
+#pragma once
+
+// internal
+#include "mapped_file.hpp"
+
+// stlib
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// a decoded texture to pack, RGBA8 rows top to bottom
+struct archive_source
+{
+	std::string name; // relative to data/textures, '/' separated
+	int width = 0;
+	int height = 0;
+	std::vector<unsigned char> pixels;
+};
+
+// a packed texture, levels are stored one after the other from the full size down,
+// each level half the size of the previous one and at least 1x1
+struct archive_texture
+{
+	int width;
+	int height;
+	int levels;
+	const unsigned char *pixels;
+};
+
+// textures decoded ahead of time, memory mapped and uploaded straight from the mapping
+//
+// little endian, in this order:
+//   header
+//   entries   sorted by name
+//   names     NUL terminated
+//   payloads  RGBA8 level chains, 64 byte aligned
+class AssetArchive
+{
+public:
+	static constexpr uint32_t MAGIC = 0x4b415043; // "CPAK"
+	static constexpr uint32_t VERSION = 1;
+	static constexpr size_t PAYLOAD_ALIGNMENT = 64;
+
+	struct header
+	{
+		uint32_t magic;
+		uint32_t version;
+		uint64_t size; // whole file in bytes
+		uint32_t entry_count;
+		uint32_t entries_offset;
+		uint32_t names_offset;
+		uint32_t reserved;
+	};
+
+	struct entry
+	{
+		uint32_t name_offset; // from the start of the file
+		uint32_t width;
+		uint32_t height;
+		uint32_t levels;
+		uint64_t offset;
+		uint64_t size;
+	};
+
+private:
+	MappedFile m_file;
+
+private:
+	bool validate(const char *path);
+	const header &get_header() const;
+	const entry *get_entries() const;
+	const char *get_name(const entry &e) const;
+
+public:
+	// false without a message when there is no such file
+	bool open(const char *path);
+	void close();
+
+	// mips adds every level down to 1x1, box filtered
+	static bool write(const char *path, const std::vector<archive_source> &sources, bool mips);
+
+	// bytes of a whole level chain
+	static size_t chain_bytes(int width, int height, int levels);
+
+	bool is_open() const;
+	int get_count() const;
+	bool find(const char *name, archive_texture &texture) const;
+};
@@ -0,0 +1,37 @@
+#pragma once
+
+// internal
+#include "geometry.hpp"
+
+// what the renderer needs of a body for one frame, copied into World's render snapshot
+// by the tick so nothing is read from the body while it's drawn
+struct sprite_state
+{
+	vec2 position;
+	float radians;
+	vec2 scale;
+	int frame_x; // sprite sheet cell, 0 without a sheet
+	int frame_y;
+};
+
+// the simulated components of an entity (motion, physics), no GL so they build into
+// chameleon_core, Entity adds the mesh, effect and transform the renderer needs
+struct Body
+{
+protected:
+	// all data relevant to the motion of the salmon.
+	struct Motion {
+		vec2 position;
+		float radians;
+		float speed;
+	} motion;
+
+	// scale is used in the bounding box calculations,
+	// and so contextually belongs here (for now).
+	struct Physics {
+		vec2 scale;
+	} physics;
+
+public:
+	sprite_state get_sprite_state() const { return {motion.position, motion.radians, physics.scale, 0, 0}; }
+};
@@ -0,0 +1,80 @@
+// header
+#include "broadphase_cache.hpp"
+#include "spatial_grid.hpp"
+
+int BroadphaseCache::create(int guard_type, int guard_index, vec2 guard_position, vec2 guard_half_extent)
+{
+	int row = (int)type.size();
+	type.push_back(guard_type);
+	owner.push_back(guard_index);
+	position.push_back(guard_position);
+	half_extent.push_back(guard_half_extent);
+	alert.push_back(0);
+	visible.push_back(1);
+
+	std::vector<int> &rows = m_rows[guard_type];
+	if ((int)rows.size() <= guard_index)
+		rows.resize(guard_index + 1, -1);
+	rows[guard_index] = row;
+	m_revision++;
+	return row;
+}
+
+void BroadphaseCache::clear()
+{
+	type.clear();
+	owner.clear();
+	position.clear();
+	half_extent.clear();
+	alert.clear();
+	visible.clear();
+	for (auto &rows : m_rows)
+		rows.clear();
+	m_revision++;
+}
+
+int BroadphaseCache::size() const
+{
+	return (int)type.size();
+}
+
+unsigned int BroadphaseCache::get_revision() const
+{
+	return m_revision;
+}
+
+int BroadphaseCache::find(int guard_type, int guard_index) const
+{
+	const std::vector<int> &rows = m_rows[guard_type];
+	if (guard_index < 0 || guard_index >= (int)rows.size())
+		return -1;
+	return rows[guard_index];
+}
+
+void BroadphaseCache::submit(SpatialGrid &grid, int type_mask) const
+{
+	for (int i = 0; i < size(); i++)
+	{
+		if (type_mask & (1 << type[i]))
+			grid.insert(type[i], owner[i], 0, position[i], half_extent[i]);
+	}
+}
+
+void BroadphaseCache::cull(vec2 view_min, vec2 view_max)
+{
+	for (int i = 0; i < size(); i++)
+	{
+		visible[i] = position[i].x + half_extent[i].x >= view_min.x && position[i].x - half_extent[i].x <= view_max.x &&
+					 position[i].y + half_extent[i].y >= view_min.y && position[i].y - half_extent[i].y <= view_max.y;
+	}
+}
+
+void BroadphaseCache::collect_visible(int guard_type, std::vector<int> &owners) const
+{
+	owners.clear();
+	for (int i = 0; i < size(); i++)
+	{
+		if (type[i] == guard_type && visible[i])
+			owners.push_back(owner[i]);
+	}
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+// internal
+#include "geometry.hpp"
+
+// stlib
+#include <vector>
+
+class SpatialGrid;
+
+// copies of the guard boxes the broadphase, AI scheduler and culling read, in columns
+// with one row per guard. Not where guard state lives: the Spotter, Shooter and Wanderer
+// objects own it and update it themselves. Rows are filled at spawn, World refreshes
+// the wanderer rows once per tick after they moved. Alert is only kept up to date for
+// wanderers, the scheduler is its one reader.
+class BroadphaseCache
+{
+public:
+	// row -> guard, type is a SpatialGrid guard type and owner the index in World's vector
+	std::vector<int> type;
+	std::vector<int> owner;
+
+	// components
+	std::vector<vec2> position;
+	std::vector<vec2> half_extent;
+	std::vector<unsigned char> alert;
+	std::vector<unsigned char> visible;
+
+private:
+	// owner index -> row, per guard type
+	std::vector<int> m_rows[3];
+	unsigned int m_revision = 0;
+
+public:
+	int create(int guard_type, int guard_index, vec2 position, vec2 half_extent);
+	void clear();
+	int size() const;
+
+	// changes whenever rows are added or removed, not when they are refreshed
+	unsigned int get_revision() const;
+
+	// -1 when the guard was never registered
+	int find(int guard_type, int guard_index) const;
+
+	// broadphase system, inserts every row whose type is in type_mask
+	void submit(SpatialGrid &grid, int type_mask) const;
+
+	// culling system, flags rows whose box overlaps the view rect
+	void cull(vec2 view_min, vec2 view_max);
+
+	// render submission, owners of the visible rows of one type in registration order
+	void collect_visible(int guard_type, std::vector<int> &owners) const;
+};
@@ -0,0 +1,557 @@
+// header
+#include "builtin_levels.hpp"
+#include "constants.hpp"
+#include "level_grid.hpp"
+
+// stlib
+#include <vector>
+
+namespace
+{
+// 800 * 1200
+// 61 for the \n of all chars
+constexpr char level_tutorial[MAP_HEIGHT][MAP_WIDTH + 1] = {
+	"WWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWW",
+	"WWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWW",
+	"WWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWW",
+	"WWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWW",
+	"WWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWW",
+	"WWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWW",
+	"WWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWW",
+	"WWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWW",
+	"WWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWW",
+	"WWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWW",
+	"WWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWW",
+	"WWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWW",
+	"WWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWW",
+	"WWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWW",
+	"WWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWW",
+	"WWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWW",
+	"WSSSSSSSSSSSSWWWWWWWWWWWWSSSSSWSSSWSSSSSSWSSSSSSSSSSSSSSSSSW",
+	"WCCCCCRRRRRRRSSSSSSWWWWWWCCCCCWBBBWBBCGGGWCCYYYYYYYYYYYYCCCW",
+	"WCCCCCRRRRRRRRRRRRRSSSSSSCCCCCWBWBWBWCGGGSCCYYYYYYYYYYYYCCCW",
+	"WCCACCRRRRRRRRRRRRRRRRRRRCCCCCWBWBWBWCGGGCCCYYYYYYYYYYYYCCCZ",
+	"WCCCCCRRRRRRRRRRRRRWWWWWWCCCCCSBWBSBWCGGGWCCYYYYYYYYYYYYCCCW",
+	"WCCCCCRRRRRRRWWWWWWWWWWWWCCCCCBBWBBBWCGGGWCCYYYYYYYYYYYYCCCW",
+	"WWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWW",
+	"WWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWW",
+	"WWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWW",
+	"WWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWW",
+	"WWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWW",
+	"WWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWW",
+	"WWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWW",
+	"WWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWW",
+	"WWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWW",
+	"WWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWW",
+	"WWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWW",
+	"WWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWW",
+	"WWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWW",
+	"WWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWW",
+	"WWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWW",
+	"WWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWW",
+	"WWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWW",
+	"WWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWW"};
+
+constexpr char map_level_1[MAP_HEIGHT][MAP_WIDTH + 1] = {
+	"SSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSS",
+	"SSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSS",
+	"SSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSS",
+	"SSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSS",
+	"SSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSS",
+	"SS7WWWWWWW8SSS7WWWWWWW8SSS7WWWWWWW8SSSSSSSSSSSSSSSSSSSSSSSSS",
+	"SS7BBBRBBB8SSS7YYYRYYY8SSS7BBBRBBB8SSSSSSSSSSSSSSSSSSSSSSSSS",
+	"SS7BBBRBBB8SSS7YYYRYYY8SSS7BBBRBBB8SSSSSSSSSSSSSSSSSSSSSSSSS",
+	"SS7BBBRBBBWWWWWYYYRYYYWWWWWBBBRBBB8SSSSSSSSSSSSSSSSSSSSSSSSS",
+	"SS7RRRRRRRRRRRRRRRRRRRRRRRRRRRRRRR8SSSSSSSSSSSSSSSSSSSSSSSSS",
+	"SS7BBBRBBB35554YYYRYYY35554BBBRBBB8SSSSSSSSSSSSSSSSSSSSSSSSS",
+	"SS7BBBRBBB8SSS7YYYRYYY8SSS7BBBRBBB8SSSSSSSSSSSSSSSSSSSSSSSSS",
+	"SS7BBBRBBB8SSS7YYYRYYY8SSS7BBBRBBB8SSSSSSSSSSSSSSSSSSSSSSSSS",
+	"SSS554R355SSSSS54YRY35SSSSS554R355SSSSSSSSSSSSSSSSSSSSSSSSSS",
+	"SSSSS7R8SSSSSSSS7YRY8SSSSSSSS7R8SSSSSSSSSSSSSSSSSSSSSSSSSSSS",
+	"SSSSS7R8SSSSSSSS7YRY8SSSSSSSS7R8SSSSSSSSSSSSSSSSSSSSSSSSSSSS",
+	"SSSSS7R8SSSSSSSS7YRY8SSSSSSSS7R8SSSSSSSSSSSSSSSSSSSSSSSSSSSS",
+	"SS7WWWRWWW8SSS7WWYRYWW8SSS7WWWRWWW8SSSSSSSSSSSSSSSSSSSSSSSSS",
+	"SS7GGGRYYY8SSS7BBYRYYY8SSS7YYYRYYY8SSSSSSSSSSSSSSSSSSSSSSSSS",
+	"SS7GGGRYYYWWWWWBBYRYYYWWWWWYYYRYYY8SSSSSSSSSSSSSSSSSSSSSSSSS",
+	"SS7GGGRYYYBBBBBBBCCCBBBBBBBYYYRYYY8SSSSSSSSSSSSSSSSSSSSSSSSS",
+	"SS7RRRRRRRRRRRRRRCZCRRRRRRRRRRRRRR8SSSSSSSSSSSSSSSSSSSSSSSSS",
+	"SS7BBBRGGGBBBBBBBCCCBBBBBBBYYYRYYY8SSSSSSSSSSSSSSSSSSSSSSSSS",
+	"SS7BBBRGGG35554GGGRGBB35554YYYRYYY8SSSSSSSSSSSSSSSSSSSSSSSSS",
+	"SS7BBBRGGG8SSS7GGGRGBB8SSS7YYYRYYY8SSSSSSSSSSSSSSSSSSSSSSSSS",
+	"SSS554R355SSSSS54GRG35SSSSS554R355SSSSSSSSSSSSSSSSSSSSSSSSSS",
+	"SSSSS7R8SSSSSSSS7GRG8SSSSSSSS7R8SSSSSSSSSSSSSSSSSSSSSSSSSSSS",
+	"SSSSS7R8SSSSSSSS7GRG8SSSSSSSS7R8SSSSSSSSSSSSSSSSSSSSSSSSSSSS",
+	"SSSSS7R8SSSSSSSS7GRG8SSSSSSSS7R8SSSSSSSSSSSSSSSSSSSSSSSSSSSS",
+	"SS7WWWRWWW8SSS7WWGRGWW8SSS7WWWRWWW8SSSSSSSSSSSSSSSSSSSSSSSSS",
+	"SS7CCCRCCC8SSS7YYYRYYY8SSS7YYYRGGG8SSSSSSSSSSSSSSSSSSSSSSSSS",
+	"SS7CCCRCCC8SSS7YYYRYYY8SSS7YYYRGGG8SSSSSSSSSSSSSSSSSSSSSSSSS",
+	"SS7CCCRCCCWWWWWYYYRYYYWWWWWYYYRGGG8SSSSSSSSSSSSSSSSSSSSSSSSS",
+	"SS7RRRRRRRRRRRRRRRRRRRRRRRRRRRRRRR8SSSSSSSSSSSSSSSSSSSSSSSSS",
+	"SS7CCCRCCC35554YYYRYYY35554GGGRYYY8SSSSSSSSSSSSSSSSSSSSSSSSS",
+	"SS7CACRCCC8SSS7YYYRYYY8SSS7GGGRYYY8SSSSSSSSSSSSSSSSSSSSSSSSS",
+	"SS7CCCRCCC8SSS7YYYRYYY8SSS7GGGRYYY8SSSSSSSSSSSSSSSSSSSSSSSSS",
+	"SSS5555555SSSSS5555555SSSSS5555555SSSSSSSSSSSSSSSSSSSSSSSSSS",
+	"SSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSS",
+	"SSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSS"};
+
+constexpr char map_level_2[MAP_HEIGHT][MAP_WIDTH + 1] = {
+	"SSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSS",
+	"SSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSS",
+	"SSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSS",
+	"SSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSS",
+	"SSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSS",
+	"SSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSS",
+	"SSSSSSSSS7WWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWW8SSSSSSSSS",
+	"SSSSSSSSS7RRRRRRRRRRRRRRRRRRRRRRRRRRRRRRRRRRRRRRRR8SSSSSSSSS",
+	"SSSSSSSSS7RBBBBBBBBBBBBRRRBBBBBRBBBBBB35554YYYYYYR8SSSSSSSSS",
+	"SSSSSSSSS7RBBBBBBBBB354RRRBBBBBRBBBBBB8SSS7YYYZYYR8SSSSSSSSS",
+	"SSSSSSSSS7RBB34BBBBB8S7RRRBBBBBRB354BBWWWWWYY34YYR8SSSSSSSSS",
+	"SSSSSSSSS7RB3SS4BBBBWWWRRRBBBBBRB8S7RRRRRRRR3SS4YR8SSSSSSSSS",
+	"SSSSSSSSS7RBW87WRRRRRRRRRR354BBRB8S7RRRRRRRRW87WYR8SSSSSSSSS",
+	"SSSSSSSSS7RYYWWRRRRRRRRRRR8S7BBRB8S7GGGR34YYYWWYYR8SSSSSSSSS",
+	"SSSSSSSSS7RYYYYYYYYRRRYYYYWWWBBRB8S7GGGR87RRRRRRRR8SSSSSSSSS",
+	"SSSSSSSSS7R3554YYYYRRRYYYYGGGGGRBWWWGGGR87RRRRRRRR8SSSSSSSSS",
+	"SSSSSSSSS7R8SS7Y354RRR354GGGGGGRGGGGGGGRWWBBBBBBBR8SSSSSSSSS",
+	"SSSSSSSSS7RWWWWY8S7RRR8S7RRRRRRRRRRRRRRRRRR3554BBR8SSSSSSSSS",
+	"SSSSSSSSS7RYYYYY8S7RRR8S7RRRRRRR3555554RYYY8SS7BBR8SSSSSSSSS",
+	"SSSSSSSSS7RYYYYY8S7RRR8S7YYYYYYRWWWWWWWRYYYWWWWBBR8SSSSSSSSS",
+	"SSSSSSSSS7RRRRRR8S7RRR8S7YYY34YRRRRRRRRRRRRRRRRRRR8SSSSSSSSS",
+	"SSSSSSSSS7RRRRRR8S7RRR8S7YYY87YRRRRRRRRRRRRRR3554R8SSSSSSSSS",
+	"SSSSSSSSS7R354GG8S7RRR8S7YYY87YR355554GRYYYRB8SS7R8SSSSSSSSS",
+	"SSSSSSSSS7RWWWGGWWWRRRWWWYYY87YR8SSSS7GR34YRBWWWWR8SSSSSSSSS",
+	"SSSSSSSSS7RBBBBBBBBBBBBBBYYY87YRWWWWWWGR87YRBGGGBR8SSSSSSSSS",
+	"SSSSSSSSS7RBBBBBBBBBBBBBB355S7YRBBBBBBGRWWYRBGGGBR8SSSSSSSSS",
+	"SSSSSSSSS7RBB34BBBBBBBBBBWWWWWYRBBBBBBBRYYYRB34GBR8SSSSSSSSS",
+	"SSSSSSSSS7RB3SS4RRRRRRRRRRRRRRRRRRRRRRRRRRRR3SS4BR8SSSSSSSSS",
+	"SSSSSSSSS7RBW87WGGG354YYYYYYYYYRYY354YY3554RW87WBR8SSSSSSSSS",
+	"SSSSSSSSS7RYYWWGGGG8S7YYYY35554RYY8S7YY8SS7RBWWBBR8SSSSSSSSS",
+	"SSSSSSSSS7RYYGGGGGGWWWYYYY8SSS7RYYWWWYY8SS7RGGBBBR8SSSSSSSSS",
+	"SSSSSSSSS7RYYAYYYYYYYYYYYYWWWWWRYYYYYYYWWWWRGGBBBR8SSSSSSSSS",
+	"SSSSSSSSS7RRRRRRRRRRRRRRRRRRRRRRRRRRRRRRRRRRRRRRRR8SSSSSSSSS",
+	"SSSSSSSSSS5555555555555555555555555555555555555555SSSSSSSSSS",
+	"SSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSS",
+	"SSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSS",
+	"SSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSS",
+	"SSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSS",
+	"SSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSS",
+	"SSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSS"};
+
+// The Museum
+constexpr char map_level_3[MAP_HEIGHT][MAP_WIDTH + 1] = {
+	"SSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSS",
+	"7WWWWWW0WWWWWWWWW0WWW0WWWWWWWWWWWWWWWWWWWWWWWWWWWW0WWWWWWWW8",
+	"7BBBBBB0YYYYYYYYY0RRR0BBBBBBBBBBBBBBBBBBBBBBBBBBBB0CCCCCCCC8",
+	"7BBBBBBWYYYYYYYYYWRRRWBBBBBBBBBBBBBBBBBBBBBBBBBBBB0CCCCCCCC8",
+	"7BBBBBBBYYYYYYYYYRRRRRRR3555555554B3555554BB3554BBWUCCCCZCC8",
+	"7BBBBBBBYYYYYYYYYRRRRRRRWWWWWWW0WWBWW0WWWWBBWWW0BBB0CCCCCCC8",
+	"7BBBBBBUYYYYYYYYYURRRRRRRRRRRRR0GGGGG0CCCCCCCCCWBBBWUCCCCCC8",
+	"S54BB35S5555554YY0RRR35555554RR0GGGGG0CCCCCCCCCCCCCCWCCCCCC8",
+	"7WWBBWWWWWWWWWWYY0RRR0WWWWWWWRR0GGGGG0CCCCCCCCCCCCCCCCCCCCC8",
+	"7RRRRRRRYYYYYYBBB0RRR0GGGGGGGGG0GGGGG0CCCCCCCCCCCCCCCCUCCCC8",
+	"7RRRRRRUYYYYYYUBB0RRR0GG35555557GGGGG0CCCCCCCCCCCCCCCCW34CC8",
+	"7RRRRRR0YYYYYY0BB0RRRWGGWWWWWWWWGGGGGWCCCCCCCCCCCCCCCCCWW35S",
+	"7RR3555S555555S557RRRBBBBBBBBBBBBBBBBBCCCCCCCCCCCCCCCCCCCWW8",
+	"7RRWWWWWWWWWWWWWW0RRRUBB35555555554BBUCCCCCCCCCCCCCCCCCCCCC8",
+	"7GGGGGGGGGGGGGGGG0RRR0BBWWW87WWWWWWBB0CCCCCCCCCCCCCCCCCCCCC8",
+	"S5555555554GGUYYY0RRR0RRRRRW0YYYYYYYYWUCCCCCCCCCCCCCCCCCCCC8",
+	"7WWWWWWWWWWGG0YYY0RR3S554RRRWUYYYYYYYY84GGG355555555554RRR3S",
+	"7BBBBBBBBBBBB0YYYWRRWWWWWURRRWUYYYYYYY0WGGUWWWWWWWWWW0WRRRW8",
+	"7BBBBBBBBBBBB0YYYYYYBBBBBWURRRWUYYYYYUWGGUWRRGGGGGGGG0RRRRR8",
+	"S55554BB355557YYYYYYBBBBBBWURRRWYYYYUWGGUWRRUGGGGGGGG0RRRRR8",
+	"7WWWWWBBWWWWW0YYY35555554BBWURRRYYYUWGG37RR37GG3554GG854R35S",
+	"7CCCCCCCCCCCC0YYY0WWWWWWWUBBWURRYYUWGGUWWRRWWGGWWWWGGWWWRWW8",
+	"7CCCCCCCCCCCC0YYY0YYYYYYYWUBBW3554WGGUWRRRRRRGGGGGGGGBBBBBB8",
+	"7CCCCCCCCCCCC0YYY0YYYYYYYYWUBBWWWWGGUWRRR3554GG3554GG355555S",
+	"7CCCCCCCCCCCUWYYYWUYYYYYYYYWUBBBGGGUWRRRUWWWWGGWWWWGGWWWWWW8",
+	"7CCCCCCCCCCUWCCCCCWUYYYYYYYY0BBBGGG0RRRUWYYYYYYYYYYYYYYYYYY8",
+	"7CCCCCCCCCUWCCCCCCCWUYYYYYYYW34BG34WRRUWYYYYYYYYYYYYYYYYYYY8",
+	"7CCCCCCCCC0CCCCCCCCCWYYYYYYYYWWBGWWRRR0YYYYYYYYYYYYYYYYYYYY8",
+	"7CCCCCCCCUWCCCCCCCCCCUYYYYYYYYYYRRRRRUWYYYYYYYYYYYYYYYYYYYY8",
+	"7CCCCCCCC0CCCCCCCCCCC85554YY3555555557YY3554BB35554GG354RR3S",
+	"7CCCCCCCUWCC3555554CCW0WWWYYWWW0WWWWW0YY0WWWBBWWW0WGGW0WRRW8",
+	"7CCCCCCC0CCCWWWWWWWCCC0BBBBBBBB0RRRRR0YY0BBBBBBBB0GGGG0RRRR8",
+	"7CCCCCCC0CCCCCCCCCCCCCWBBBBBBBBWRRRRRWYYWBBBBBBBBWGGGGWRRRR8",
+	"7CCCCCCC0CCCCCCCCCCCCCBBBBBBBBBBRRRRRRYYBBBBBBBBBBGGGGGRRRR8",
+	"7CCCCCCC0CCC3555554CCCUBBBBBBBBURRRRRUYYUBBBBBBBBUGGGGURRRR8",
+	"7CCCCCCC0CCCWWWWWWWCCC8554BB3557RR3557YY8554BB355S4GG3S4RR3S",
+	"7CCCCCCC0CCCCCCCCCCCCCWWWWBBWWWWRRWWWWYYWWWWBBWWWWWGGWWWRRW8",
+	"7CCCCCCUWCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCC8",
+	"7CCACC37CCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCC8",
+	"S55555SS555555555555555555555555555555555555555555555555555S"};
+
+/////////////////////////
+// Level: Ruins Textures
+/////////////////////////
+
+// bottom left corner - 1
+// bottom right corner - 2
+// top left corner - 3
+// top right corner - 4
+// top wall - 5
+// bottom wall - 6
+// left wall - 7
+// right wall - 8
+// end cap - E
+// shadow - S
+// top u - U
+// two walls - 0
+// walls - W
+// red - R
+// green - G
+// blue - B
+// yellow - Y
+// corridor - C
+constexpr char map_level_4[MAP_HEIGHT][MAP_WIDTH + 1] = {
+	"SSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSS",
+	"7WWWWWWWWWW0WWWWWWWWWWW0WWWWWWWWWWWWW0WWWWWWWWW87WWWWWWWWWW8",
+	"7YYYYYYYYYY0YYYYYYYYYYY0RRYYYYYYYYYYY0BBBBZBBBB87BBBBBBBBBB8",
+	"7GGG3554GGGEYYYYYYYYYYY0RR35555554YYY8555554BBBW84BBBBBBBBB8",
+	"7GGGWWWWGGGYYYYYYYYYYYY0R37WWWWWWWYYY0WWWWW84BBBW85555554BB8",
+	"7GGGRRRRGGGUYYYYYYYYYYY0R0WYYYYYYYYYY0GGGGGW0BBBGWWWWWWW0BB8",
+	"S5554RR35557YYYYYYYYYYY0R0RRRRRRRRRYY0GGGGGG84BBGGGGGGGBEUB8",
+	"7WWWWRRWWWW0B35555555557R0RRRRRRRRRYY0GGGGGGW0BBUGGG354BB0B8",
+	"7CCCCRRCCCC0BWWWWWWWWWW0R0RRRRRRRRRRR0GYGUGGG0BB854GWWWBB0B8",
+	"S5554RR35557BBBBBBBBBBB0R0RRR35554RRR0GY37GGG0BBWW0GGBBBUWB8",
+	"7WWWWRRWWWW85555555554B0R84RUWWWWWURR0GY0WGRG0BBRB0RGB357BB8",
+	"7BBBBRRYYYY0WWWWWWWWWWB0RW0REBBBBB84R0GY0GGRG0GGRB0RGBWWWBB8",
+	"S5554RR35557YYYYYYYYYYY0RR0RBBBBBBW0R0YY0GGRG0GGRBWUGGBBBBB8",
+	"7WWWWRRWWWW0G35555555557RR0BBBBBBBBER0YY84GRG84GRRB0RRGG34B8",
+	"7YYYYRRYYYY0GWWWWWWWWWW0RR0BBBBBUBBBR0YYW0GRRW0GGRB0RRRRW0B8",
+	"S5554RR35557RRRRRRRRRRR0RR0BBB34WUBBR0YYY84RRR0GGRB0RRRRR0B8",
+	"7WWWWRRWWWW85555555554R0RREBBBWWY84BR0YYYW0RRR84GRBW34RR37B8",
+	"7GGGGRRYYYY0WWWWWWWWWWR0GGGGGGGGYW84REYYYY84RRW0GGRBW8557WB8",
+	"S5554RR35557YYYYYYYYYYY0GG3554GGYYW0RRYYYYW0RRB84GGBBWW0WGG8",
+	"7WWWWRRWWWW0Y35555555557GG0WW84GGYY0RRRYUBB84RBW84GBBBBEGGG8",
+	"7YYYYRRBBBB0YWWWWWWWWWW0GUWBBW0GGYYERRRUWGBW0BBRW84BGGGGGGG8",
+	"S5554RR35557BBBBBBBBBBB0G0BBBB84GYYRRRR0GGBG84BRRW0BG34GGGG8",
+	"7WWWWRRWWWW85555555554B0GEBBBBWWGYYRRRR0GGGBW0BRRR84GW84GGG8",
+	"7GGGGRRYYYY0WWWWWWWWWWB0BBBBBBBGGYYRRRR0GGGBG0BRRRW0GRW84GY8",
+	"S5554RR35557YYYYYYYYYYY0BBBBBBBGGYYRRUR0GGGB37BRRRR0GRYW0YY8",
+	"7WWWWRRWWWW0Y35555555557RR354BBGGYYRR0R0GGGB0WBRGGG0GRYY84Y8",
+	"7BBBBRRBBBB0YWWWWWWWWWW0R37WWBBGGYYYY0R0GGBB0BBRRRG84RYYW0Y8",
+	"S5554RR35557RRRRRRRRRRR0R87GGBB354YYY0R0GBBUWBB354GW0RYYY0Y8",
+	"7WWWWRRWWWW85555555554R0R87GGB37WWYYY0R0BBG0BB37WWGG0RYYY0Y8",
+	"7BBBBRRYYYY0WWWWWWWWWWR0RW84GB0WYYYUB0R0BGG0BBW0GGGG0RYY37Y8",
+	"S5554RR35557YYYYYYYYYYY0RRW0GB0YYY37B0G0BGG0BBB0GGGG0RY37WY8",
+	"7WWWWRRWWWW0Y35555555557RRR0GB0YY37WB0G0BGG0BBBEGGGG0R37WYY8",
+	"7GGBBRRBBBB0YWWWWWWWWWW0RR37G37YY0WBB0G0BGG84BBBGGGG0R0WYYY8",
+	"S5554RR35557BBBBBBBBBBB0R37WG0WYY0BBB0GWUBBWW354GGGG0R0YYYY8",
+	"7WWWWRRWWWW85555555554B0R87GG0YYY84BB0GG84BBBWWW35557R84YYY8",
+	"7YYYYRRGGYY0WWWWWWWWWWBER87GG0YYY87BB0GGW0BBBYYYWWWWWRW0YYY8",
+	"S5554RR35557YYYYYYYYYYYYRW0GGEYY3S7BB0GGG854BBYYYYYRRRR854Y8",
+	"7WWWWRRWWWW0YYYYYYYYYYYYRREGGGYYWWWBB0GGGWWWGRRRRRYYYYRWWWY8",
+	"7ACYYRRBBGG0YYYYYYYYYYYYGGGGGGBBBBBBB0GGGGGGGRRRRRRRRRYYYYY8",
+	"S5555555555S5555555555555555555555555S555555555555555555555S"};
+
+// The Maze
+constexpr char map_level_5[MAP_HEIGHT][MAP_WIDTH + 1] = {
+	"SSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSSS",
+	"7WWWWWWWWWWWW0WWWWW0WWWWWWWWW0WWWWWWWWWWWWWWWWWWWWWWWWWWWWW8",
+	"7BBBBBBBBBBBB0CCCCC0BBGGGGGGG0GGGGGGGGGGGGGGBBBBBBBBBBBBBYY8",
+	"7BBBBBBBBBBBB0CCCCC0BBGGGGGGG0GGGGGGGGGGGGGGBBBBBBBBBBBBBYY8",
+	"7BB35555555557CCCCC0BB35555557GG3555555555555555555555554YY8",
+	"7BBWWWWWWWWWWWCCCCC0BB0WWWWWWWGGWWWWWWW0WWWWWWWWWWWWWWWWWYY8",
+	"7RRRRRRRRRRRRCCCCCC0BB0CCCCCCCCCCCCCCCC0RRRRRRRRRRRRRRRRRRR8",
+	"7RRRRRRRRRRRRCCCCCC0BB0CCCCCCCCCCCCCCCC0RRRRRRRRRRRRRRRRRRR8",
+	"7RR3555555554CCCCCCWBB0CCZCCCCCCCCCCCCC0RR355555555555554YY8",
+	"7RRWWWWWWWWW0CCCCCCBBB0CCCCCCCCCCCCCCCC0RR0WWWWWWWWWWWWW0YY8",
+	"7GGGGGGGGGGG0CCCCCCBBB0CCCCCCCCCCCCCCCC0RR0CCCCCCCCCCCCC0YY8",
+	"7GGGGGGGGGGG8555555555S55555555555555550RR0CCCCCCCCCCCCC0YY8",
+	"S555555554GG0WWWWWWWWWWWWWWWWWWWWWWWWWW0RRWUCCCCCCCCCCCC0YY8",
+	"7WWWWWWWWWGG0BBBBBBBBBBBBBBBBBBBBBBBBBB0RRRW3555554CC355S55S",
+	"7BBBBBBBBBGG0BBBBBBBBBBBBBBBBBBBBBBBBBB0RRRRWWWWWWWCCWWWWWW8",
+	"7BBBBBBBBBGG0RR355555555555555555555555S54BBBBBBBBBBBBBBBYY8",
+	"S555554BBUGG0RR0WWWWWWWWWWWWWWWW0WW0WW0WW0BBBBBBBBBBBBBBBYY8",
+	"7WWWWWWBB0GGWRR0YYYYYYYYYYYYYYYY0GG0BB0RR8555555555555554YY8",
+	"7CCCCCCCC0RRRRR0YYYYYYYYYYYYYYYY0GG0BB0RR0WWWWWWWWWWWW0WWYY8",
+	"7CCCCCCCC0RRRRR0YY355555554YY3557GG0BB0RR0YYYYYYYYYYYY0CCCC8",
+	"7CCCCCCCC0RR3557YY0WWWWWWWWYYWWWWGG0BB0RRWYYYYYYYYYYYY0CCCC8",
+	"7CCCCCCCC0RR0WW0YY0GGGGGGGGGGGGGGGG0BB0RRRRR35555554YY0CCCC8",
+	"7CCCCCCCC0RR0BB0YY0GGGGGGGGGGGGGGGG0BB0RRRRR0WWWWWWWYY0CCCC8",
+	"7CCCCCCCC0RR0BB0YY0GG355555555555557BB0RR3557BBBBBBBYY0CCCC8",
+	"7RR3555557BBWBBWYYWGGWW0WWWWWWWWWWWWBB0RR0WW0BBBBBBBYY0CCCC8",
+	"7RRWWWWWW0BBBBBCCCCCCCC0RRRRRRRRRRRRBB0RR0RR85555555557CCCC8",
+	"7RRRRRRRR0BBBBBCCCCCCCC0RRRRRRRRRRRRBB0RR0RRWWWWWW0WWWWCCCC8",
+	"7RRRRRRRR855554CCCCCCCC8555555555554BB0RR0RRRRRRRR0GGYYCCCC8",
+	"S555554RR0WWWW0CCCCCCCC0WWWWWWWWWWWWBBWRRWRRRRRRRR0GGYYCCCC8",
+	"7WWWWW0RR0GGGG0CCCCCCCC0GGGGGGGGGGGGGGGGGGRRRRRRRR0GG355555S",
+	"7YYYYY0RR0GGGG8555554BB0GGGGGGGGGGGGGGGGGGRRRRRRRR0GGWWWWWW8",
+	"7YYYYY0RR854RR0WWWWW0BB0RR3555555555554BB3555554RR0GGGGGGGG8",
+	"7CCURRWRRWWWRR0GGGGG0BBWRR0WWWWWWWWWWW0BB0WWWWW0RR0GGGGGGGG8",
+	"7CC0RRRRRRRRRR0GGGGG0BBBRR0BBBBBBBBBBB0BB0YYYYY0RR8555554GG8",
+	"7CC0RRRRRRRRRR0GGUBB0BBBRR0BBBBBBBBBBB0BB0YYYYY0RR0WWWWWWBB8",
+	"7CC0GG355555557GG0BB8554RR0BB3555555557BB0YYUBB8557BBBBBBBB8",
+	"7CC0GGWWWWWWWWWGG0BBWWW0RR0BBWWWWWWWWWWBBWYY0BBWWWWBBBBBBBB8",
+	"7CC0GGGGGGGGGGGGG0BBBBB0RR0GGGGGGGGGGGGGGGYY0BBBBBBBBBBBBBB8",
+	"7AC0GGGGGGGGGGGGG0BBBBB0RR0GGGGGGGGGGGGGGGYY0BBBBBBBBBBBBBB8",
+	"S55S5555555555555S55555S55S55555555555555555S55555555555555S"
+};
+
+////////////////////
+// COMPILE TIME CHECKS
+////////////////////
+
+// derived from a built-in level by the compiler, a broken edit fails the build
+struct level_facts
+{
+	bool full_rows; // every row has MAP_WIDTH tiles
+	int spawns;
+	int trophies;
+	int spawn; // tile index, -1 without one
+	int trophy;
+	bool trophy_reachable; // 4-connected over non-wall tiles, like the LevelIndex flood fill
+};
+
+constexpr level_facts analyse(const char (&tiles)[MAP_HEIGHT][MAP_WIDTH + 1])
+{
+	level_facts facts = {true, 0, 0, -1, -1, false};
+	for (int y = 0; y < MAP_HEIGHT; y++)
+	{
+		for (int x = 0; x < MAP_WIDTH; x++)
+		{
+			char tile = tiles[y][x];
+			if (tile == '\0')
+				facts.full_rows = false;
+			else if (tile == 'A' && facts.spawns++ == 0)
+				facts.spawn = y * MAP_WIDTH + x;
+			else if (tile == 'Z' && facts.trophies++ == 0)
+				facts.trophy = y * MAP_WIDTH + x;
+		}
+	}
+	if (facts.spawn < 0 || facts.trophy < 0)
+		return facts;
+
+	// flood fill from the spawn, queue doubles as the visit order
+	bool seen[MAP_WIDTH * MAP_HEIGHT] = {};
+	int queue[MAP_WIDTH * MAP_HEIGHT] = {};
+	int tail = 0;
+	queue[tail++] = facts.spawn;
+	seen[facts.spawn] = true;
+	for (int head = 0; head < tail; head++)
+	{
+		int x = queue[head] % MAP_WIDTH;
+		int y = queue[head] / MAP_WIDTH;
+		const int step_x[4] = {1, -1, 0, 0};
+		const int step_y[4] = {0, 0, 1, -1};
+		for (int d = 0; d < 4; d++)
+		{
+			int nx = x + step_x[d];
+			int ny = y + step_y[d];
+			if (nx < 0 || ny < 0 || nx >= MAP_WIDTH || ny >= MAP_HEIGHT)
+				continue;
+			int n = ny * MAP_WIDTH + nx;
+			if (seen[n] || LevelGrid::classify(tiles[ny][nx]) == LevelGrid::TILE_WALL)
+				continue;
+			seen[n] = true;
+			queue[tail++] = n;
+		}
+	}
+	facts.trophy_reachable = seen[facts.trophy];
+	return facts;
+}
+
+constexpr bool is_playable(const level_facts &facts)
+{
+	return facts.full_rows && facts.spawns == 1 && facts.trophies == 1 && facts.trophy_reachable;
+}
+
+// spelled out per level so the failing one is named
+constexpr level_facts TUTORIAL_FACTS = analyse(level_tutorial);
+constexpr level_facts LEVEL_1_FACTS = analyse(map_level_1);
+constexpr level_facts LEVEL_2_FACTS = analyse(map_level_2);
+constexpr level_facts LEVEL_3_FACTS = analyse(map_level_3);
+constexpr level_facts LEVEL_4_FACTS = analyse(map_level_4);
+constexpr level_facts LEVEL_5_FACTS = analyse(map_level_5);
+static_assert(is_playable(TUTORIAL_FACTS), "tutorial needs full rows, one spawn and one trophy reachable from it");
+static_assert(is_playable(LEVEL_1_FACTS), "level 1 needs full rows, one spawn and one trophy reachable from it");
+static_assert(is_playable(LEVEL_2_FACTS), "level 2 needs full rows, one spawn and one trophy reachable from it");
+static_assert(is_playable(LEVEL_3_FACTS), "level 3 needs full rows, one spawn and one trophy reachable from it");
+static_assert(is_playable(LEVEL_4_FACTS), "level 4 needs full rows, one spawn and one trophy reachable from it");
+static_assert(is_playable(LEVEL_5_FACTS), "level 5 needs full rows, one spawn and one trophy reachable from it");
+
+////////////////////
+// GUARDS
+////////////////////
+
+// spotter positions in pixels, levels 4 and 5
+const std::vector<vec2> spotter_loc = {
+	{100, 100},
+	{SCREEN_WIDTH - 100, 100},
+	{100, SCREEN_HEIGHT - 100},
+	{SCREEN_WIDTH - 100, SCREEN_HEIGHT - 100},
+	{800, 500}};
+
+const std::vector<vec2> spotter_loc_level_2 = {
+	{(15 * 20) + 10, (13 * 20) + 10},
+	{(47 * 20) + 10, (15 * 20) + 10},
+	{(29 * 20) + 10, (17 * 20) + 10},
+	{(18 * 20) + 10, (26 * 20) + 10},
+	{(38 * 20) + 10, (26 * 20) + 10}};
+
+// shooter positions in pixels, level 5
+const std::vector<vec2> shooter_loc = {
+	{100 + 100, 100 + 50},
+	{SCREEN_WIDTH - 50, 100 + 50},
+	{150, SCREEN_HEIGHT - 150},
+	{SCREEN_WIDTH - 50, SCREEN_HEIGHT - 50},
+	{850, 550}};
+
+// wanderer checkpoint level 1
+const std::vector<std::vector<vec2>> wanderer_paths_level_1 =
+{
+{{3,6}, {5,6}, {5,12}, {3,12}},
+{{7,6}, {9,6}, {9,12}, {7,12}},
+{{6,6}, {6,36}},
+{{18,6}, {18,36}},
+{{30,6}, {30,36}},
+{{3,9}, {33,9}},
+{{3,21}, {33,21}},
+{{33,33}, {3,33}},
+{{15,6}, {17,6}, {17,12}, {15,12}},
+{{19,6}, {21,6}, {21,12}, {19,12}},
+{{27,6}, {29,6}, {29,12}, {27,12}},
+{{31,6}, {33,6}, {33,12}, {31,12}},
+{{3,18}, {5,18}, {5,24}, {3,24}},
+{{7,18}, {9,18}, {9,24}, {7,24}},
+{{15,18}, {17,18}, {17,24}, {15,24}},
+{{19,18}, {21,18}, {21,24}, {19,24}},
+{{27,18}, {29,18}, {29,24}, {27,24}},
+{{31,18}, {33,18}, {33,24}, {31,24}},
+{{15,30}, {17,30}, {17,36}, {15,36}},
+{{19,30}, {21,30}, {21,36}, {19,36}},
+{{27,30}, {29,30}, {29,36}, {27,36}},
+{{31,30}, {33,30}, {33,36}, {31,36}},
+};
+
+// wanderer checkpoint level 2
+const std::vector<std::vector<vec2>> wanderer_paths_level_2 =
+{
+{{10,7}, {49,7}, {49,32}, {10,32}},
+{{49,7}, {49,32}, {10,32}, {10,7}},
+{{49,32}, {10,32}, {10,7}, {49,7}},
+{{10,25}, {10,7}, {49,7}, {49,32}, {10,32}},
+{{19,7}, {19,27}},
+{{25,7}, {25,24}},
+{{31,7}, {31,32}},
+{{43,7}, {43,16}},
+{{43,20}, {43,32}},
+{{16,12}, {25,12}, {25,15}, {16,15}},
+{{16,24}, {24,24}, {24,27}, {16,27}},
+{{31,25}, {38,25}, {38,32}, {31,32}},
+{{42,14}, {49,14}, {49,20}, {42,20}},
+{{43,24}, {49,24}, {49,32}, {43,32}}
+};
+
+// wanderer checkpoint
+const std::vector<std::vector<vec2>> wanderer_paths =
+{ {{6,6}, {6,2}, {1,2}, {1,6}},
+{{8,6}, {8,2}, {16,2}, {16,6}},
+{{6,11}, {1,11}, {1,9}, {6,9}},
+{{8,11}, {8,9}, {13,9}, {13,11}},
+{{1,14}, {16,14}},
+{{1,17}, {12,18}},
+{{20,18}, {31,25}, {41,16}, {32,25}},
+{{18,22}, {31,28}, {34,28}, {42,20}, {34,28}, {30,28}},
+{{19,38}, {19,27}, {11,27}, {11,38}},
+{{22,38}, {58,37}},
+{{45,26}, {45,18}, {52,18}, {52,26}},
+{{19,2}, {19,15}},
+{{23,2}, {48,3}},
+{{39,15}, {39,7}, {51,7}, {51,15}},
+{{35,12}, {23,12}, {23,15}, {29,20}, {33,20}, {36,15}} };
+
+const std::vector<std::vector<vec2>> wanderer_paths_2 =
+{
+	{{1,8}, {10,8}},
+	{{1,11}, {10,11}},
+	{{1,14}, {10,14}},
+	{{1,17}, {10,17}},
+	{{1,20}, {10,20}},
+	{{1,23}, {10,23}},
+	{{1,26}, {10,26}},
+	{{1,29}, {10,29}},
+	{{1,32}, {10,32}},
+	{{1,35}, {10,35}},
+	{{12,9}, {22,9}},
+	{{12,12}, {22,12}},
+	{{12,15}, {22,15}},
+	{{12,18}, {22,18}},
+	{{12,21}, {22,21}},
+	{{12,24}, {22,24}},
+	{{12,27}, {22,27}},
+	{{12,30}, {22,30}},
+	{{12,33}, {22,33}},
+	{{23,36}, {23,38}, {16,38}, {16,36}},
+	{{24,2}, {24,16}},
+	{{34,8}, {26,8}, {26,6}, {34,6}},
+	{{24,17}, {32,17}, {32,23}, {24,23}},
+	{{41,27}, {41,32}},
+	{{43, 8}, {43, 14}},
+	{{45,36}, {53,36}, {53,38}, {45,38}},
+	{{58,36}, {58,10}},
+	{{38,2}, {46,2}, {46,11}, {49,11}, {49,16}, {49,11}, {46,11}, {46,2}}
+};
+
+const std::vector<std::vector<vec2>> wanderer_paths_3 =
+{ { {1, 6}, { 12,7 }},
+{{1,10}, {10,11}, {11,17}, {10,11}},
+{{1,18}, {1,23}, {8,23}, {8,18}},
+{{14,2}, {14,10}, {18,10}, {18,2}},
+{{20,10}, {21,3}},
+{{30,5}, {42,2}},
+{{44,2}, {56,3}},
+{{40,14}, {41,7}, {58,6}, {41,7}},
+{{55,28}, {55,19}, {58,19}, {58,28}},
+{{45,35}, {58,38}, {58,35}, {52,35}},
+{{27,38}, {41,37}},
+{{24,30}, {41,29}},
+{{24,25}, {35,26}},
+{{19,22}, {33,21}, {34,17}, {33,21}},
+{{15,25}, {15,29}, {22,29}, {22,25}},
+{{4,35}, {14,37}, {16,33}, {19,32}, {16,33}, {14,37}} };
+} // namespace
+
+bool builtin_level(int level, level_source &out)
+{
+	const char(*tiles)[MAP_WIDTH + 1] = nullptr;
+	out = level_source();
+	switch (level)
+	{
+	case LEVEL_TUTORIAL:
+		tiles = level_tutorial;
+		break;
+	case LEVEL_1:
+		tiles = map_level_1;
+		out.patrols = wanderer_paths_level_1;
+		break;
+	case LEVEL_2:
+		tiles = map_level_2;
+		out.spotters = spotter_loc_level_2;
+		out.patrols = wanderer_paths_level_2;
+		break;
+	case LEVEL_3:
+		tiles = map_level_3;
+		out.patrols = wanderer_paths;
+		break;
+	case LEVEL_4:
+		tiles = map_level_4;
+		out.spotters = spotter_loc;
+		out.patrols = wanderer_paths_2;
+		break;
+	case LEVEL_5:
+		tiles = map_level_5;
+		out.spotters = spotter_loc;
+		out.shooters = shooter_loc;
+		out.patrols = wanderer_paths_3;
+		break;
+	default:
+		return false;
+	}
+
+	out.level = level;
+	out.width = MAP_WIDTH;
+	out.height = MAP_HEIGHT;
+	for (int y = 0; y < MAP_HEIGHT; y++)
+		out.tiles.insert(out.tiles.end(), tiles[y], tiles[y] + MAP_WIDTH);
+	return true;
+}
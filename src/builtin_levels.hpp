@@ -0,0 +1,9 @@
+#pragma once
+
+// internal
+#include "level_file.hpp"
+
+// the levels shipped in the source, what chameleon_level_convert exports and what
+// LevelGrid falls back to when a level has no file
+// false for an unknown level
+bool builtin_level(int level, level_source &out);
@@ -7,7 +7,6 @@
 #include <iostream>
 
 constexpr size_t NUM_SEGMENTS = 12;
-constexpr float LIFE = 5000.f;
 
 using namespace std;
 
@@ -63,32 +62,12 @@ void Bullets::destroy()
 	effect.release();
 }
 
-void Bullets::update(float ms)
+void Bullets::draw(const mat3 &projection)
 {
-	vec2 g = {0, 9.8f};
-	int count = 1;
-
-	for (auto &b : m_bullets)
-	{
-		// s = ut + 1/2at^2
-		if (b.life <= 0)
-		{
-			if (m_bullets.size() == count)
-				m_bullets.pop_back();
-			else
-				m_bullets.erase(m_bullets.begin() + count);
-		}
-		else
-		{
-			b.life -= ms;
-			b.position.x += b.velocity.x * (ms / 100) + 0.5f * g.x * pow(ms / 100, 2);
-			b.position.y += b.velocity.y * (ms / 100) + 0.5f * g.y * pow(ms / 100, 2);
-			count++;
-		}
-	}
+	draw(projection, m_bullets);
 }
 
-void Bullets::draw(const mat3 &projection)
+void Bullets::draw(const mat3 &projection, const std::vector<Bullet> &bullets)
 {
 	// set shaders
 	glUseProgram(effect.program);
@@ -121,7 +100,7 @@ void Bullets::draw(const mat3 &projection)
 
 	// load up bullet into buffer
 	glBindBuffer(GL_ARRAY_BUFFER, m_instance_vbo);
-	glBufferData(GL_ARRAY_BUFFER, m_bullets.size() * sizeof(Bullet), m_bullets.data(), GL_DYNAMIC_DRAW);
+	glBufferData(GL_ARRAY_BUFFER, bullets.size() * sizeof(Bullet), bullets.data(), GL_DYNAMIC_DRAW);
 
 	// bullet translations
 	// bind to attribute 1 (in_translate) as in vertex shader
@@ -136,20 +115,9 @@ void Bullets::draw(const mat3 &projection)
 	glVertexAttribDivisor(2, 1);
 
 	// draw
-	glDrawArraysInstanced(GL_TRIANGLES, 0, NUM_SEGMENTS * 3, m_bullets.size());
+	glDrawArraysInstanced(GL_TRIANGLES, 0, NUM_SEGMENTS * 3, bullets.size());
 
 	// reset divisor
 	glVertexAttribDivisor(1, 0);
 	glVertexAttribDivisor(2, 0);
 }
-
-void Bullets::spawn_bullet(vec2 pos, float rad)
-{
-	Bullet b;
-	b.life = LIFE;
-	b.position = pos;
-	b.radius = 2;
-	b.velocity = {20 * cos(rad), 20 * sin(rad)};
-
-	m_bullets.emplace_back(b);
-}
\ No newline at end of file
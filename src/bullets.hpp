@@ -4,33 +4,20 @@
 
 // internal
 #include "common.hpp"
+#include "bullets_sim.hpp"
 
 using namespace std;
 
-class Bullets : public Entity
+// instanced circles for the bullets BulletsSim moves
+class Bullets : public BulletsSim, public Renderable
 {
 private:
 	GLuint m_instance_vbo;
-	//std::vector<Bullet> m_bullets; // vector of pebbles
 
 public:
-	struct Bullet
-	{
-		float life;
-		vec2 position;
-		float radius;
-		vec2 velocity;
-	};
-
 	bool init();
 	void destroy();
-	void update(float ms);
 	void draw(const mat3 &projection) override;
-
-	// spawn bullet
-	void spawn_bullet(vec2 position, float radians);
-
-	float cooldown;
-
-	std::vector<Bullet> m_bullets;
+	// GL thread, bullets copied into the render snapshot
+	void draw(const mat3 &projection, const std::vector<Bullet> &bullets);
 };
\ No newline at end of file
@@ -0,0 +1,46 @@
+// header
+#include "bullets_sim.hpp"
+
+// stlib
+#include <cmath>
+
+namespace
+{
+const float LIFE = 5000.f;
+} // namespace
+
+void BulletsSim::update(float ms)
+{
+	vec2 g = {0, 9.8f};
+	int count = 1;
+
+	for (auto &b : m_bullets)
+	{
+		// s = ut + 1/2at^2
+		if (b.life <= 0)
+		{
+			if (m_bullets.size() == count)
+				m_bullets.pop_back();
+			else
+				m_bullets.erase(m_bullets.begin() + count);
+		}
+		else
+		{
+			b.life -= ms;
+			b.position.x += b.velocity.x * (ms / 100) + 0.5f * g.x * std::pow(ms / 100, 2);
+			b.position.y += b.velocity.y * (ms / 100) + 0.5f * g.y * std::pow(ms / 100, 2);
+			count++;
+		}
+	}
+}
+
+void BulletsSim::spawn_bullet(vec2 pos, float rad)
+{
+	Bullet b;
+	b.life = LIFE;
+	b.position = pos;
+	b.radius = 2;
+	b.velocity = {20 * std::cos(rad), 20 * std::sin(rad)};
+
+	m_bullets.emplace_back(b);
+}
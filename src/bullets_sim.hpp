@@ -0,0 +1,30 @@
+#pragma once
+
+// internal
+#include "geometry.hpp"
+
+// stlib
+#include <vector>
+
+// a shooter's bullets in flight, no GL so they build into chameleon_core, Bullets draws them
+class BulletsSim
+{
+public:
+	// laid out for the instance buffer Bullets uploads as is
+	struct Bullet
+	{
+		float life;
+		vec2 position;
+		float radius;
+		vec2 velocity;
+	};
+
+	void update(float ms);
+
+	// spawn bullet
+	void spawn_bullet(vec2 position, float radians);
+
+	float cooldown;
+
+	std::vector<Bullet> m_bullets;
+};
@@ -2,9 +2,11 @@
 
 // internal
 #include "common.hpp"
+#include "char_sim.hpp"
 #include "map.hpp"
 #include "shooter.hpp"
 #include "spotter.hpp"
+#include "texture_manager.hpp"
 #include "wanderer.hpp"
 #include "bullets.hpp"
 
@@ -21,50 +23,19 @@ class Wanderer;
 class Bullets;
 class Map;
 
-class Char : public Entity
+// draws CharSim and plays its sound cues
+class Char : public CharSim, public Renderable
 {
 	// shared texture
-	static Texture char_texture;
+	TextureHandle char_texture;
 
 private:
-	// config
-	const float config_scale = 0.35f;
-
-	bool m_is_alive;
-	
-	// key press
-	bool m_moving_right;
-	bool m_moving_left;
-	bool m_moving_up;
-	bool m_moving_down;
-
-	// color
-	int m_color;
-
-	// TODO -- wall collision
-	bool m_wall_up;
-	bool m_wall_down;
-	bool m_wall_left;
-	bool m_wall_right;
-
-	// dash
-	bool m_dash;
-	int m_direction_change;
-
 	// animation
-	int sprite_switch = 1;
-	float sprite_countdown = 50.f;
 	const float spriteWidth = 34;
 	const float spriteHeight = 67;
-	int frameIndex_x = 1;
-	int frameIndex_y = 1;
-	void reinitialize();
-
-	// Stealthing Animations
-	bool stealth_animating = false;
-	float stealth_anim_time = 0;
-	bool stealthed = false;
-	Map* m_map;
+	int m_mesh_frame_x; // frame the mesh was built for, -1 until the first draw
+	int m_mesh_frame_y;
+	void reinitialize(int frame_x, int frame_y);
 
 	// sound
 	Mix_Chunk *m_sfx_bump;
@@ -76,51 +47,20 @@ private:
 public:
 	bool init(vec2 pos, Map &map);
 	void destroy();
-	void update(float ms);
 	void draw(const mat3 &projection) override;
+	// GL thread, from the render snapshot
+	void draw(const mat3 &projection, const draw_state &state);
 
 	// alive
-	bool is_alive() const;
-	void kill();
+	void kill() override;
 
-	// collision
-	bool collision(vec2 pos, vec2 box);
-	bool is_colliding(Bullets &b);
+	// collision, shooters aren't in chameleon_core
+	using CharSim::is_colliding;
 	bool is_colliding(const Shooter &s);
-	bool is_colliding(const Spotter &s);
-	bool is_colliding(const Wanderer &w);
-	bool is_in_range(Wanderer &w, Map& map);
-	bool is_in_alert_mode_range(Wanderer &w);
-	vec2 get_bounding_box() const;
-
-	// wall collision
-	void set_wall_collision(char dir, bool val);
-	bool is_wall_collision();
-
-	// movement
-	void set_direction(char dir, bool val);
-	void set_position(vec2 pos);
-	void change_position(vec2 off);
-	vec2 get_position() const;
-	float get_speed() const;
-	vec2 get_velocity();
-	bool is_moving() const;
-
-	// dash
-	void change_direction(int c);
-	int get_direction() const;
 
 	// color change
-	void set_color(int color);
-	int get_color() const;
+	void set_color(int color) override;
 
 	// dash
-	void set_dash(bool val);
-	bool is_dashing();
-
-	void set_rotation(float rad);
-
-	//stealth helpers
-	void reset_stealth();
-	bool is_stealthed();
+	void set_dash(bool val) override;
 };
\ No newline at end of file
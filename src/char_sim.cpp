@@ -0,0 +1,513 @@
+// header
+#include "char_sim.hpp"
+#include "level_grid.hpp"
+#include "spotter_sim.hpp"
+#include "wanderer_sim.hpp"
+
+// stlib
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+namespace
+{
+const int STEALTH_ANIM_DURATION = 1000;
+} // namespace
+
+void CharSim::init(vec2 spos, const LevelGrid &level)
+{
+	m_level = &level;
+
+	motion.position = spos;
+	motion.radians = 0.f;
+	motion.speed = 65.f;
+
+	physics.scale = {-config_scale, config_scale};
+
+	// initial values
+	m_is_alive = true;
+	m_color = 0;
+	m_direction_change = 0;
+
+	m_moving_right = false;
+	m_moving_left = false;
+	m_moving_up = false;
+	m_moving_down = false;
+
+	m_wall_up = false;
+	m_wall_down = false;
+	m_wall_left = false;
+	m_wall_right = false;
+
+	m_dash = false;
+}
+
+// update
+void CharSim::update(float ms)
+{
+	float step = motion.speed * (ms / 1000);
+
+	if (m_is_alive)
+	{
+		// speed up on dash
+		if (m_dash)
+			step *= 3;
+
+		// go in random direction on dash
+		if (m_dash && !m_moving_up && !m_moving_down && !m_moving_left && !m_moving_right)
+		{
+			int r = rand() % 4;
+			// chose direction
+			if (r == 0)
+			{
+				m_moving_up = true;
+				m_direction_change = 0;
+			}
+			else if (r == 1)
+			{
+				m_moving_down = true;
+				m_direction_change = 1;
+			}
+			else if (r == 2)
+			{
+				m_moving_left = true;
+				m_direction_change = 2;
+			}
+			else if (r == 3)
+			{
+				m_moving_right = true;
+				m_direction_change = 3;
+			}
+		}
+
+		// opposite direction if blue
+		// TODO
+		if (m_color == 3)
+		{
+			if (m_moving_up && !m_wall_down)
+				change_position({0.f, step});
+			if (m_moving_down && !m_wall_up)
+				change_position({0.f, -step});
+			if (m_moving_left && !m_wall_right)
+				change_position({step, 0.f});
+			if (m_moving_right && !m_wall_left)
+				change_position({-step, 0.f});
+		}
+		else
+		{
+			if (m_moving_up && !m_wall_up)
+				change_position({0.f, -step});
+			if (m_moving_down && !m_wall_down)
+				change_position({0.f, step});
+			if (m_moving_left && !m_wall_left)
+				change_position({-step, 0.f});
+			if (m_moving_right && !m_wall_right)
+				change_position({step, 0.f});
+		}
+
+		if (m_moving_right)
+		{
+			if (physics.scale.x < 0) {
+				physics.scale.x = -physics.scale.x;
+			}
+		}
+		if (m_moving_left)
+		{
+			if (physics.scale.x > 0) {
+				physics.scale.x = -physics.scale.x;
+			}
+		}
+
+		// sprite change
+		if (m_moving_down || m_moving_up || m_moving_right || m_moving_left)
+		{
+			if (frameIndex_x < 7)
+			{
+				frameIndex_x++;
+			}
+			else
+			{
+				frameIndex_x = 2;
+			}
+		}
+		else
+		{
+			frameIndex_x = 1;
+			frameIndex_y = 1;
+		}
+	}
+
+	if (!is_moving() && !stealth_animating && !stealthed)
+	{
+		if (m_level->get_tile_type(get_position()) == get_color() + 1)
+		{
+			stealth_animating = true;
+		}
+	}
+	else if (is_moving() && (stealthed || stealth_animating))
+	{
+		reset_stealth();
+	}
+
+	if (stealth_animating)
+	{
+		if (stealth_anim_time >= STEALTH_ANIM_DURATION)
+		{
+			stealthed = true;
+			stealth_animating = false;
+			stealth_anim_time = 0;
+		}
+		else
+		{
+			stealth_anim_time += ms;
+		}
+	}
+}
+
+CharSim::draw_state CharSim::get_draw_state() const
+{
+	return {{motion.position, motion.radians, physics.scale, frameIndex_x, frameIndex_y}, m_color, m_is_alive, stealthed, stealth_animating, stealth_anim_time};
+}
+
+////////////////////
+// ALIVE
+////////////////////
+
+bool CharSim::is_alive() const
+{
+	return m_is_alive;
+}
+
+void CharSim::kill()
+{
+	m_is_alive = false;
+}
+
+////////////////////
+// COLLISION
+////////////////////
+
+// aabb-aabb collision
+bool CharSim::collision(vec2 pos, vec2 box)
+{
+	vec2 char_pos = motion.position;
+	vec2 char_box = get_bounding_box();
+	bool collision_x_right = (char_pos.x + char_box.x) >= (pos.x - box.x) && (char_pos.x + char_box.x) <= (pos.x + box.x);
+	bool collision_x_left = (char_pos.x - char_box.x) >= (pos.x - box.x) && (char_pos.x - char_box.x) <= (pos.x + box.x);
+	bool collision_y_top = (char_pos.y + char_box.y) >= (pos.y - box.y) && (char_pos.y + char_box.y) <= (pos.y + box.y);
+	bool collision_y_down = (char_pos.y - char_box.y) >= (pos.y - box.y) && (char_pos.y - char_box.y) <= (pos.y + box.y);
+
+	if ((char_pos.x + char_box.x) >= (pos.x + box.x) && (char_pos.x - char_box.x) <= (pos.x - box.x))
+		return collision_y_top || collision_y_down;
+
+	if ((char_pos.y + char_box.y) >= (pos.y + box.y) && (char_pos.y - char_box.y) <= (pos.y - box.y))
+		return collision_x_right || collision_x_left;
+
+	return (collision_x_right || collision_x_left) && (collision_y_top || collision_y_down);
+}
+
+// TODO
+bool CharSim::is_colliding(BulletsSim &b)
+{
+	for (auto &bullet : b.m_bullets)
+	{
+		if (is_colliding(bullet))
+			return true;
+	}
+	return false;
+}
+
+// bullet collision, consumes the bullet
+bool CharSim::is_colliding(BulletsSim::Bullet &bullet)
+{
+	vec2 char_pos = motion.position;
+	vec2 char_box = get_bounding_box();
+	vec2 pos = bullet.position;
+
+	if (char_pos.y - char_box.y < pos.y &&
+		char_pos.y + char_box.y > pos.y &&
+		char_pos.x - char_box.x < pos.x &&
+		char_pos.x + char_box.x > pos.x)
+	{
+		bullet.life = 0.f;
+		return true;
+	}
+	return false;
+}
+
+bool CharSim::is_colliding(const SpotterSim &s)
+{
+	vec2 pos = s.get_position();
+	vec2 box = s.get_bounding_box();
+	return collision(pos, box);
+}
+
+bool CharSim::is_colliding(const WandererSim &w)
+{
+	vec2 pos = w.get_position();
+	vec2 box = w.get_bounding_box();
+	return collision(pos, box);
+}
+
+vec2 CharSim::get_bounding_box() const
+{
+	return { std::fabs(physics.scale.x) * m_sheet_size.x * 0.5f * 0.10625f, std::fabs(physics.scale.y) * m_sheet_size.y * 0.5f * 0.07046875f };
+}
+
+void CharSim::set_wall_collision(char direction, bool value)
+{
+	if (direction == 'R')
+		m_wall_right = value;
+	else if (direction == 'L')
+		m_wall_left = value;
+	else if (direction == 'U')
+		m_wall_up = value;
+	else if (direction == 'D')
+		m_wall_down = value;
+}
+
+bool CharSim::is_wall_collision()
+{
+	return m_wall_down || m_wall_left || m_wall_right || m_wall_up;
+}
+
+void CharSim::check_wall(const float ms)
+{
+	if (!is_moving())
+	{
+		set_wall_collision('U', false);
+		set_wall_collision('D', false);
+		set_wall_collision('L', false);
+		set_wall_collision('R', false);
+		return;
+	}
+
+	// ch info
+	vec2 box = get_bounding_box();
+	vec2 dir = get_velocity();
+
+	// as far as update will move it, dashes go three times as fast
+	float step = get_speed() * (ms / 1000);
+	if (is_dashing())
+		step *= 3;
+
+	// blue color
+	if (get_color() == 3)
+	{
+		dir.x = -dir.x;
+		dir.y = -dir.y;
+	}
+
+	// the box is swept against the wall rectangles so no step skips over a wall,
+	// on a hit it stops just short of it and update doesn't move that way
+	const WallGeometry &walls = m_level->get_walls();
+	const float skin = 0.001f;
+	wall_hit hit;
+
+	// where the vertical move ends, the horizontal sweep starts there so diagonal
+	// moves can't clip a corner
+	vec2 pos = get_position();
+
+	// up, down
+	if (dir.y != 0)
+	{
+		char side = dir.y < 0 ? 'U' : 'D';
+		if (walls.sweep(pos, box, {0.f, dir.y * step}, hit))
+		{
+			change_position({0.f, dir.y * (step * hit.t - skin)});
+			set_wall_collision(side, true);
+			pos = get_position();
+		}
+		else
+		{
+			set_wall_collision(side, false);
+			pos.y += dir.y * step;
+		}
+	}
+	// left, right
+	if (dir.x != 0)
+	{
+		char side = dir.x < 0 ? 'L' : 'R';
+		if (walls.sweep(pos, box, {dir.x * step, 0.f}, hit))
+		{
+			change_position({dir.x * (step * hit.t - skin), 0.f});
+			set_wall_collision(side, true);
+		}
+		else
+		{
+			set_wall_collision(side, false);
+		}
+	}
+}
+
+bool CharSim::is_in_range(const WandererSim &w) const
+{
+	float dx = motion.position.x - w.get_position().x;
+	float dy = motion.position.y - w.get_position().y;
+	float d_sq = dx * dx + dy * dy;
+	float r = get_range(w, 5.f);
+
+	bool is_wall = false;
+	if (d_sq < r*r)
+		is_wall = m_level->is_segment_blocked(motion.position, w.get_position());
+
+	if ((d_sq < r * r) && !(is_wall))
+		return true;
+	return false;
+}
+
+bool CharSim::is_in_alert_mode_range(const WandererSim &w) const
+{
+	float dx = motion.position.x - w.get_position().x;
+	float dy = motion.position.y - w.get_position().y;
+	float d_sq = dx * dx + dy * dy;
+	float r = get_range(w, 12.f);
+
+	if (d_sq < r * r)
+		return true;
+	return false;
+}
+
+// detection radius between the char and a wanderer, also used as the broadphase query radius
+float CharSim::get_range(const WandererSim &w, float factor) const
+{
+	return get_range(w.get_bounding_box(), factor);
+}
+
+float CharSim::get_range(vec2 box, float factor) const
+{
+	float other_r = std::max(box.x, box.y);
+	float my_r = std::max(physics.scale.x, physics.scale.y);
+	return std::max(other_r, my_r) * factor;
+}
+
+////////////////////
+// MOVEMENT
+////////////////////
+
+void CharSim::set_direction(char direction, bool value)
+{
+	// prevent direction change upon dash consequence
+	if (m_dash)
+	{
+		if (value)
+			return;
+	}
+
+	else if (direction == 'U')
+		m_moving_up = value;
+	else if (direction == 'D')
+		m_moving_down = value;
+	else if (direction == 'R')
+		m_moving_right = value;
+	else if (direction == 'L')
+		m_moving_left = value;
+}
+
+void CharSim::set_position(vec2 pos)
+{
+	motion.position = pos;
+}
+
+void CharSim::change_position(vec2 offset)
+{
+	motion.position.x += offset.x;
+	motion.position.y += offset.y;
+}
+
+vec2 CharSim::get_position() const
+{
+	return motion.position;
+}
+
+float CharSim::get_speed() const
+{
+	return motion.speed;
+}
+
+vec2 CharSim::get_velocity()
+{
+	vec2 res = {0.f, 0.f};
+	m_moving_up ? res.y = -1.f : res.y;
+	m_moving_down ? res.y = 1.f : res.y;
+	m_moving_left ? res.x = -1.f : res.x;
+	m_moving_right ? res.x = 1.f : res.x;
+
+	return res;
+}
+
+bool CharSim::is_moving() const
+{
+	return m_moving_up || m_moving_down || m_moving_left || m_moving_right;
+}
+
+// up: 0, down: 1, left: 2, right: 3
+void CharSim::change_direction(int dir)
+{
+	m_direction_change = dir;
+}
+
+int CharSim::get_direction() const
+{
+	return m_direction_change;
+}
+
+////////////////////
+// COLOR CHANGE
+////////////////////
+
+// 1: red, 2: green; 3: blue; 4: yellow;
+void CharSim::set_color(int color)
+{
+	if (m_color != color)
+	{
+		m_color = color;
+		if (stealthed || stealth_animating)
+		{
+			reset_stealth();
+		}
+	}
+}
+
+int CharSim::get_color() const
+{
+	return m_color;
+}
+
+////////////////////
+// CONSEQUENCE
+////////////////////
+
+void CharSim::set_dash(bool value)
+{
+	m_dash = value;
+
+	if (!value)
+		m_dash = m_moving_up = m_moving_down = m_moving_left = m_moving_right = value;
+}
+
+bool CharSim::is_dashing()
+{
+	return m_dash;
+}
+
+////////////////////
+// MISC
+////////////////////
+
+void CharSim::set_rotation(float radians)
+{
+	motion.radians = radians;
+}
+
+void CharSim::reset_stealth()
+{
+	stealthed = false;
+	stealth_animating = false;
+	stealth_anim_time = 0;
+}
+
+bool CharSim::is_stealthed() const
+{
+	return stealthed || stealth_animating;
+}
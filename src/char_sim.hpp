@@ -0,0 +1,120 @@
+#pragma once
+
+// internal
+#include "body.hpp"
+#include "bullets_sim.hpp"
+
+class LevelGrid;
+class SpotterSim;
+class WandererSim;
+
+// the char's movement, wall and guard collision and stealth, no GL or audio so it builds
+// into chameleon_core and runs headless, Char draws it and plays its sound cues
+class CharSim : public Body
+{
+protected:
+	// config
+	const float config_scale = 0.35f;
+
+	// sheet the bounding box factors were fitted to, Char sets the loaded texture's size
+	vec2 m_sheet_size = {350.f, 640.f};
+
+	bool m_is_alive;
+
+	// key press
+	bool m_moving_right;
+	bool m_moving_left;
+	bool m_moving_up;
+	bool m_moving_down;
+
+	// color
+	int m_color;
+
+	// set by check_wall, update doesn't move towards a side that is blocked
+	bool m_wall_up;
+	bool m_wall_down;
+	bool m_wall_left;
+	bool m_wall_right;
+
+	// dash
+	bool m_dash;
+	int m_direction_change;
+
+	// animation
+	int frameIndex_x = 1;
+	int frameIndex_y = 1;
+
+	// Stealthing Animations
+	bool stealth_animating = false;
+	float stealth_anim_time = 0;
+	bool stealthed = false;
+	const LevelGrid *m_level;
+
+public:
+	// what Char draws, copied into the render snapshot
+	struct draw_state
+	{
+		sprite_state sprite;
+		int color;
+		bool alive;
+		bool stealthed;
+		bool stealth_animating;
+		float stealth_anim_time;
+	};
+
+	virtual ~CharSim() = default;
+
+	void init(vec2 pos, const LevelGrid &level);
+	void update(float ms);
+	draw_state get_draw_state() const;
+
+	// alive
+	bool is_alive() const;
+	virtual void kill();
+
+	// collision
+	bool collision(vec2 pos, vec2 box);
+	bool is_colliding(BulletsSim &b);
+	bool is_colliding(BulletsSim::Bullet &b);
+	bool is_colliding(const SpotterSim &s);
+	bool is_colliding(const WandererSim &w);
+	bool is_in_range(const WandererSim &w) const;
+	bool is_in_alert_mode_range(const WandererSim &w) const;
+	float get_range(const WandererSim &w, float factor) const;
+	float get_range(vec2 box, float factor) const;
+	vec2 get_bounding_box() const;
+
+	// wall collision
+	void set_wall_collision(char dir, bool val);
+	bool is_wall_collision();
+
+	// sweeps this tick's step against the level's walls and stops short of a hit
+	void check_wall(float ms);
+
+	// movement
+	void set_direction(char dir, bool val);
+	void set_position(vec2 pos);
+	void change_position(vec2 off);
+	vec2 get_position() const;
+	float get_speed() const;
+	vec2 get_velocity();
+	bool is_moving() const;
+
+	// dash
+	void change_direction(int c);
+	int get_direction() const;
+
+	// color change
+	virtual void set_color(int color);
+	int get_color() const;
+
+	// dash
+	virtual void set_dash(bool val);
+	bool is_dashing();
+
+	void set_rotation(float rad);
+
+	//stealth helpers
+	void reset_stealth();
+	bool is_stealthed() const;
+};
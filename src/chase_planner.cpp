@@ -0,0 +1,305 @@
+// header
+#include "chase_planner.hpp"
+#include "level_grid.hpp"
+
+// stlib
+#include <algorithm>
+#include <cstdlib>
+
+namespace
+{
+const int INF = 1 << 29;
+} // namespace
+
+ChasePlanner::ChasePlanner() : m_grid(nullptr),
+							   m_revision(0),
+							   m_width(0),
+							   m_height(0),
+							   m_start(-1),
+							   m_last_start(-1),
+							   m_goal(-1),
+							   m_km(0)
+{
+}
+
+void ChasePlanner::init(const LevelGrid &grid)
+{
+	m_grid = &grid;
+	m_revision = 0;
+	m_start = -1;
+	m_goal = -1;
+}
+
+bool ChasePlanner::plan(vec2 start_tile, vec2 goal_tile, int max_expansions)
+{
+	if (m_grid == nullptr)
+		return false;
+
+	// walls changed (new level or a tile edit): node ids follow the level size, the search restarts
+	if (m_revision != m_grid->get_revision())
+	{
+		m_revision = m_grid->get_revision();
+		m_width = m_grid->get_width();
+		m_height = m_grid->get_height();
+		m_start = -1;
+		m_goal = -1;
+	}
+
+	int start = to_node(start_tile);
+	int goal = to_node(goal_tile);
+	if (start < 0 || goal < 0)
+		return false;
+
+	// anything but a wall change can be repaired
+	if (m_start < 0 || m_goal < 0)
+	{
+		reset(start, goal);
+	}
+	else
+	{
+		// chaser moved: keys stay valid up to km
+		if (start != m_start)
+		{
+			m_km += heuristic(m_last_start, start);
+			m_last_start = start;
+			m_start = start;
+		}
+
+		// goal moved: the old goal loses its rhs of 0, the new goal gains it
+		if (goal != m_goal)
+		{
+			int old_goal = m_goal;
+			m_goal = goal;
+			m_rhs[m_goal] = 0;
+			push(m_goal);
+			update_vertex(old_goal);
+			m_stats.goal_moves++;
+		}
+	}
+
+	// a search cut short can still hold g values for the previous goal
+	return compute_shortest_path(max_expansions) && m_g[m_start] < INF;
+}
+
+std::vector<vec2> ChasePlanner::get_path(int max_length) const
+{
+	std::vector<vec2> path;
+	if (m_start < 0 || m_goal < 0)
+		return path;
+
+	int current = m_start;
+	path.push_back(to_tile(current));
+
+	int nbs[8];
+	while (current != m_goal && (int)path.size() < max_length)
+	{
+		if (m_g[current] >= INF)
+			break;
+
+		int best = -1;
+		int best_cost = INF;
+		int count = neighbours(current, nbs);
+		for (int i = 0; i < count; i++)
+		{
+			int cost = 1 + m_g[nbs[i]];
+			if (m_g[nbs[i]] < INF && cost < best_cost)
+			{
+				best_cost = cost;
+				best = nbs[i];
+			}
+		}
+
+		if (best < 0)
+			break;
+
+		current = best;
+		path.push_back(to_tile(current));
+	}
+
+	return path;
+}
+
+chase_stats &ChasePlanner::get_stats()
+{
+	return m_stats;
+}
+
+const chase_stats &ChasePlanner::get_stats() const
+{
+	return m_stats;
+}
+
+void ChasePlanner::reset(int start, int goal)
+{
+	int size = m_width * m_height;
+	m_g.assign(size, INF);
+	m_rhs.assign(size, INF);
+	m_open_k1.assign(size, 0);
+	m_open_k2.assign(size, 0);
+	m_in_open.assign(size, 0);
+	m_open = std::priority_queue<open_entry, std::vector<open_entry>, open_entry_greater>();
+
+	m_start = start;
+	m_last_start = start;
+	m_goal = goal;
+	m_km = 0;
+
+	m_rhs[m_goal] = 0;
+	push(m_goal);
+
+	m_stats.resets++;
+}
+
+void ChasePlanner::calculate_key(int node, int &k1, int &k2) const
+{
+	int m = std::min(m_g[node], m_rhs[node]);
+	k1 = m + heuristic(m_start, node) + m_km;
+	k2 = m;
+}
+
+bool ChasePlanner::key_less(int a1, int a2, int b1, int b2) const
+{
+	return a1 < b1 || (a1 == b1 && a2 < b2);
+}
+
+// lazy insertion, stale entries are dropped when popped
+void ChasePlanner::push(int node)
+{
+	int k1, k2;
+	calculate_key(node, k1, k2);
+	m_open_k1[node] = k1;
+	m_open_k2[node] = k2;
+	m_in_open[node] = 1;
+	m_open.push({k1, k2, node});
+}
+
+void ChasePlanner::update_vertex(int node)
+{
+	if (node != m_goal)
+	{
+		int nbs[8];
+		int count = neighbours(node, nbs);
+		int best = INF;
+		for (int i = 0; i < count; i++)
+			best = std::min(best, 1 + m_g[nbs[i]]);
+		m_rhs[node] = std::min(best, INF);
+		m_stats.vertex_updates++;
+	}
+
+	m_in_open[node] = 0;
+	if (m_g[node] != m_rhs[node])
+		push(node);
+}
+
+bool ChasePlanner::compute_shortest_path(int max_expansions)
+{
+	m_stats.searches++;
+
+	int nbs[8];
+	int expansions = 0;
+	while (!m_open.empty())
+	{
+		open_entry top = m_open.top();
+		if (!m_in_open[top.node] || m_open_k1[top.node] != top.k1 || m_open_k2[top.node] != top.k2)
+		{
+			m_open.pop();
+			continue;
+		}
+
+		int start_k1, start_k2;
+		calculate_key(m_start, start_k1, start_k2);
+		if (!key_less(top.k1, top.k2, start_k1, start_k2) && m_rhs[m_start] == m_g[m_start])
+			return true;
+
+		if (expansions >= max_expansions)
+			return false;
+
+		m_open.pop();
+		m_in_open[top.node] = 0;
+		expansions++;
+		m_stats.expanded++;
+
+		int u = top.node;
+		int k1, k2;
+		calculate_key(u, k1, k2);
+		if (key_less(top.k1, top.k2, k1, k2))
+		{
+			push(u);
+		}
+		else if (m_g[u] > m_rhs[u])
+		{
+			m_g[u] = m_rhs[u];
+			int count = neighbours(u, nbs);
+			for (int i = 0; i < count; i++)
+				update_vertex(nbs[i]);
+		}
+		else
+		{
+			m_g[u] = INF;
+			update_vertex(u);
+			int count = neighbours(u, nbs);
+			for (int i = 0; i < count; i++)
+				update_vertex(nbs[i]);
+		}
+	}
+
+	return m_rhs[m_start] == m_g[m_start];
+}
+
+// every step costs 1 (same as calculate_immediate_path), so chebyshev is consistent
+int ChasePlanner::heuristic(int a, int b) const
+{
+	int dx = std::abs(a % m_width - b % m_width);
+	int dy = std::abs(a / m_width - b / m_width);
+	return std::max(dx, dy);
+}
+
+// 8-connected, diagonals only when both orthogonal tiles are free (Wanderer::tile_is_accessible)
+int ChasePlanner::neighbours(int node, int out[8]) const
+{
+	int x = node % m_width;
+	int y = node / m_width;
+	int count = 0;
+
+	if (!is_walkable(x, y))
+		return 0;
+
+	for (int dx = -1; dx <= 1; dx++)
+	{
+		for (int dy = -1; dy <= 1; dy++)
+		{
+			if (dx == 0 && dy == 0)
+				continue;
+
+			if (!is_walkable(x + dx, y + dy))
+				continue;
+
+			if (dx != 0 && dy != 0 && (!is_walkable(x + dx, y) || !is_walkable(x, y + dy)))
+				continue;
+
+			out[count++] = (y + dy) * m_width + (x + dx);
+		}
+	}
+	return count;
+}
+
+bool ChasePlanner::is_walkable(int x, int y) const
+{
+	if (x < 0 || y < 0 || x >= m_width || y >= m_height)
+		return false;
+	return !m_grid->is_wall_tile(x, y);
+}
+
+int ChasePlanner::to_node(vec2 tile) const
+{
+	int x = (int)tile.x;
+	int y = (int)tile.y;
+	if (x < 0 || y < 0 || x >= m_width || y >= m_height)
+		return -1;
+	return y * m_width + x;
+}
+
+vec2 ChasePlanner::to_tile(int node) const
+{
+	return {(float)(node % m_width), (float)(node / m_width)};
+}
@@ -0,0 +1,92 @@
+#pragma once
+
+// internal
+#include "constants.hpp"
+#include "geometry.hpp"
+
+// stlib
+#include <vector>
+#include <queue>
+
+class LevelGrid;
+
+// counters used to compare incremental repairs against full replans
+struct chase_stats
+{
+	int searches = 0;             // compute_shortest_path calls
+	int expanded = 0;             // nodes popped from the open list
+	int vertex_updates = 0;       // rhs recomputations
+	int goal_moves = 0;           // times the chased tile changed
+	int resets = 0;               // full reinitializations (level change, first chase)
+	int full_replans = 0;         // chase fallbacks to WandererSim::calculate_immediate_path
+	int full_replan_expanded = 0; // nodes expanded by those fallbacks
+};
+
+// incremental chase planner (D* Lite with a moving goal)
+// g/rhs values are distances to the goal tile, the queue is keyed on the
+// heuristic from the chaser tile, so moving the chaser only bumps km and
+// moving the goal only invalidates the rhs of the old and new goal tiles.
+class ChasePlanner
+{
+private:
+	struct open_entry
+	{
+		int k1;
+		int k2;
+		int node;
+	};
+
+	struct open_entry_greater
+	{
+		bool operator()(const open_entry &l, const open_entry &r) const
+		{
+			return l.k1 > r.k1 || (l.k1 == r.k1 && l.k2 > r.k2);
+		}
+	};
+
+	const LevelGrid *m_grid;
+	unsigned int m_revision; // LevelGrid revision the search was built on
+	int m_width;
+	int m_height;
+
+	int m_start;
+	int m_last_start;
+	int m_goal;
+	int m_km;
+
+	std::vector<int> m_g;
+	std::vector<int> m_rhs;
+	std::vector<int> m_open_k1;
+	std::vector<int> m_open_k2;
+	std::vector<char> m_in_open;
+	std::priority_queue<open_entry, std::vector<open_entry>, open_entry_greater> m_open;
+
+	chase_stats m_stats;
+
+private:
+	void reset(int start, int goal);
+	void calculate_key(int node, int &k1, int &k2) const;
+	bool key_less(int a1, int a2, int b1, int b2) const;
+	void push(int node);
+	void update_vertex(int node);
+	bool compute_shortest_path(int max_expansions);
+	int heuristic(int a, int b) const;
+	int neighbours(int node, int out[8]) const;
+	bool is_walkable(int x, int y) const;
+	int to_node(vec2 tile) const;
+	vec2 to_tile(int node) const;
+
+public:
+	ChasePlanner();
+
+	void init(const LevelGrid &grid);
+
+	// moves the chaser and/or goal and repairs the search, returns false if no path exists
+	bool plan(vec2 start_tile, vec2 goal_tile, int max_expansions);
+
+	// walks the repaired g-values from the chaser tile, first element is the chaser tile
+	std::vector<vec2> get_path(int max_length) const;
+
+	chase_stats &get_stats();
+	const chase_stats &get_stats() const;
+};
@@ -1,9 +1,13 @@
 #include "common.hpp"
+#include "asset_archive.hpp"
+#include "texture_loader.hpp"
 
 #define STB_IMAGE_IMPLEMENTATION
 #include "../ext/stb_image/stb_image.h"
 
 // stlib
+#include <algorithm>
+#include <cstring>
 #include <vector>
 #include <iostream>
 #include <sstream>
@@ -49,56 +53,22 @@ bool gl_has_errors()
 	return true;
 }
 
-float dot(vec2 l, vec2 r)
-{
-	return l.x * r.x + l.y * r.y;
-}
+TextureLoader* Texture::loader = nullptr;
+const AssetArchive* Texture::archive = nullptr;
 
-float dot(vec3 l, vec3 r)
+namespace
 {
-	return l.x * r.x + l.y * r.y + l.z * r.z;
-}
-
-vec2 add(vec2 a, vec2 b) { return { a.x+b.x, a.y+b.y }; }
-vec2 sub(vec2 a, vec2 b) { return { a.x-b.x, a.y-b.y }; }
-vec2 mul(vec2 a, float b) { return { a.x*b, a.y*b }; }
-vec3 mul(mat3 m, vec3 v) { return {
-  dot(vec3{m.c0.x, m.c1.x, m.c2.x}, v),
-  dot(vec3{m.c0.y, m.c1.y, m.c2.y}, v),
-  dot(vec3{m.c0.z, m.c1.z, m.c2.z}, v)
-}; }
-float sq_len(vec2 a) { return dot(a, a); }
-float len(vec2 a) { return std::sqrt(sq_len(a)); }
-vec2 to_vec2(vec3 v) { return { v.x, v.y }; }
-
-mat3 mul(const mat3 & l, const mat3 & r)
+// archive names are relative to data/textures
+bool find_packed(const char* path, archive_texture& packed)
 {
-	mat3 l_t = { { l.c0.x, l.c1.x, l.c2.x},
-	{ l.c0.y, l.c1.y, l.c2.y } ,
-	{ l.c0.z, l.c1.z, l.c2.z } };
-
-	mat3 ret;
-	ret.c0.x = dot(l_t.c0, r.c0);
-	ret.c0.y = dot(l_t.c1, r.c0);
-	ret.c0.z = dot(l_t.c2, r.c0);
-
-	ret.c1.x = dot(l_t.c0, r.c1);
-	ret.c1.y = dot(l_t.c1, r.c1);
-	ret.c1.z = dot(l_t.c2, r.c1);
-
-	ret.c2.x = dot(l_t.c0, r.c2);
-	ret.c2.y = dot(l_t.c1, r.c2);
-	ret.c2.z = dot(l_t.c2, r.c2);
-	return ret;
+	static const char root[] = textures_path("");
+	if (Texture::archive == nullptr || strncmp(path, root, sizeof(root) - 1) != 0)
+		return false;
+	return Texture::archive->find(path + sizeof(root) - 1, packed);
 }
-
-vec2 normalize(vec2 v)
-{
-	float m = sqrtf(dot(v, v));
-	return { v.x / m, v.y / m };
 }
 
-Texture::Texture()
+Texture::Texture() : id(0), depth_render_buffer_id(0), width(0), height(0), pending(false)
 {
 	//
 }
@@ -113,6 +83,29 @@ bool Texture::load_from_file(const char* path)
 {
 	if (path == nullptr) 
 		return false;
+
+	archive_texture packed;
+	if (find_packed(path, packed))
+	{
+		// already decoded, uploaded straight from the mapping
+		width = packed.width;
+		height = packed.height;
+		gl_flush_errors();
+		glGenTextures(1, &id);
+		glBindTexture(GL_TEXTURE_2D, id);
+		const unsigned char* pixels = packed.pixels;
+		for (int level = 0; level < packed.levels; level++)
+		{
+			int w = std::max(1, width >> level);
+			int h = std::max(1, height >> level);
+			glTexImage2D(GL_TEXTURE_2D, level, GL_RGBA, w, h, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+			pixels += (size_t)w * h * 4;
+		}
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, packed.levels - 1);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, packed.levels > 1 ? GL_NEAREST_MIPMAP_NEAREST : GL_NEAREST);
+		return !gl_has_errors();
+	}
 	
 	stbi_uc* data = stbi_load(path, &width, &height, NULL, 4);
 	if (data == NULL)
@@ -160,11 +153,33 @@ bool Texture::create_from_screen(GLFWwindow const * const window) {
 	return !gl_has_errors();
 }
 
+bool Texture::load_async(const char* path)
+{
+	if (loader == nullptr)
+		return load_from_file(path);
+
+	// nothing to decode for packed textures, the loader copies them from the mapping
+	archive_texture packed;
+	if (path != nullptr && find_packed(path, packed))
+		return loader->request(*this, packed);
+	return loader->request(*this, path);
+}
+
 bool Texture::is_valid()const
 {
 	return id != 0;
 }
 
+bool Texture::is_pending()const
+{
+	return pending;
+}
+
+bool Texture::is_ready()const
+{
+	return id != 0 && !pending;
+}
+
 namespace
 {
 	bool gl_compile_shader(GLuint shader)
@@ -188,7 +203,7 @@ namespace
 	}
 }
 
-bool Entity::Effect::load_from_file(const char* vs_path, const char* fs_path) 
+bool Renderable::Effect::load_from_file(const char* vs_path, const char* fs_path) 
 {
 	gl_flush_errors();
 
@@ -260,39 +275,9 @@ bool Entity::Effect::load_from_file(const char* vs_path, const char* fs_path)
 	return true;
 }
 
-void Entity::Effect::release()
+void Renderable::Effect::release()
 {
 	glDeleteProgram(program);
 	glDeleteShader(vertex);
 	glDeleteShader(fragment);
 }
-
-void Entity::Transform::begin()
-{
-	out = { { 1.f, 0.f, 0.f }, { 0.f, 1.f, 0.f}, { 0.f, 0.f, 1.f} };
-}
-
-void Entity::Transform::scale(vec2 scale)
-{
-	mat3 S = { { scale.x, 0.f, 0.f },{ 0.f, scale.y, 0.f },{ 0.f, 0.f, 1.f } };
-	out = mul(out, S);
-}
-
-void Entity::Transform::rotate(float radians)
-{
-	float c = cosf(radians);
-	float s = sinf(radians);
-	mat3 R = { { c, s, 0.f },{ -s, c, 0.f },{ 0.f, 0.f, 1.f } };
-	out = mul(out, R);
-}
-
-void Entity::Transform::translate(vec2 offset)
-{
-	mat3 T = { { 1.f, 0.f, 0.f },{ 0.f, 1.f, 0.f },{ offset.x, offset.y, 1.f } };
-	out = mul(out, T);
-}
-
-void Entity::Transform::end()
-{
-	//
-}
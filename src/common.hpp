@@ -19,24 +19,8 @@
 #define audio_path(name) data_path  "/audio/" name
 #define mesh_path(name) data_path  "/meshes/" name
 
-// not much math is needed and there are already way too many libraries linked (:
-// If you want to do some overloads..
-struct vec2 { float x, y; };
-struct vec3 { float x, y, z; };
-struct mat3 { vec3 c0, c1, c2; };
-
-// utility functions
-float dot(vec2 l, vec2 r);
-float dot(vec3 l, vec3 r);
-mat3 mul(const mat3& l, const mat3& r);
-vec2 mul(vec2 a, float b);
-vec3 mul(mat3 m, vec3 v);
-vec2 normalize(vec2 v);
-vec2 add(vec2 a, vec2 b);
-vec2 sub(vec2 a, vec2 b);
-vec2 to_vec2(vec3 v);
-float sq_len(vec2 a);
-float len(vec2 a);
+// vec2, vec3, mat3 and the motion/physics components (no GL, shared with the simulation core)
+#include "body.hpp"
 
 // OpenGL utilities
 // cleans error buffer
@@ -57,6 +41,9 @@ struct TexturedVertex
 	vec2 texcoord;
 };
 
+class AssetArchive;
+class TextureLoader;
+
 // texture wrapper
 struct Texture
 {
@@ -67,16 +54,26 @@ struct Texture
 	GLuint depth_render_buffer_id;
 	int width;
 	int height;
+	bool pending; // requested from the loader, pixels not uploaded yet
+
+	// decodes through this loader when set, load_async loads synchronously otherwise
+	static TextureLoader* loader;
+	// textures_path names are uploaded from this archive when it has them, no decode
+	static const AssetArchive* archive;
 	
 	// Loads texture from file specified by path
 	bool load_from_file(const char* path);
+	// Same, but the pixels are decoded on a worker (copied from the archive when packed):
+	// id, width and height are set on return, the pixels follow a few frames later
+	bool load_async(const char* path);
 	bool is_valid()const; // True if texture is valid
+	bool is_pending()const; // True while the pixels are still being decoded
+	bool is_ready()const; // True if texture is valid and its pixels are uploaded
 	bool create_from_screen(GLFWwindow const * const window); // Screen texture
 };
 
-// an entity boils down to a collection of components,
-// organized by their in-game context (mesh, effect, motion, etc...)
-struct Entity {
+// the components of an entity the renderer owns, drawn from the Body next to it
+struct Renderable {
 	// projection contains the orthographic projection matrix. As every Entity::draw()
 	// renders itself it needs it to correctly bind it to its shader.
 	virtual void draw(const mat3& projection) = 0;
@@ -102,29 +99,12 @@ protected:
 		void release(); // release shaders and program
 	} effect;
 
-	// all data relevant to the motion of the salmon.
-	struct Motion {
-		vec2 position;
-		float radians;
-		float speed;
-	} motion;
-
-	// scale is used in the bounding box calculations, 
-	// and so contextually belongs here (for now).
-	struct Physics {
-		vec2 scale;
-	} physics;
-
-	// transform component handles transformations passed to the Vertex shader.
-	// gl Immediate mode equivalent, see the Rendering and Transformations section in the
-	// specification pdf.
-	struct Transform {
-		mat3 out;
-
-		void begin();
-		void scale(vec2 scale);
-		void rotate(float radians);
-		void translate(vec2 offset);
-		void end();
-	} transform;
+	// transform component handles transformations passed to the Vertex shader (geometry.hpp).
+	Transform transform;
+};
+
+// an entity boils down to a collection of components,
+// organized by their in-game context (mesh, effect, motion, etc...)
+// Char, Wanderer, Spotter and Bullets pair a chameleon_core *Sim class with Renderable instead
+struct Entity : Body, Renderable {
 };
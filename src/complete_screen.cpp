@@ -5,58 +5,42 @@
 #include <algorithm>
 #include <cmath>
 
-Texture CompleteScreen::pointer;
-Texture CompleteScreen::game_done;
-Texture CompleteScreen::main_menu;
-Texture CompleteScreen::quit;
-Texture CompleteScreen::piere_win;
-
 bool CompleteScreen::init()
 {
 	// load shared texture
-	if (!pointer.is_valid())
+	pointer = TextureManager::load(textures_path("pointer.png"), "complete_screen");
+	if (!pointer)
 	{
-		if (!pointer.load_from_file(textures_path("pointer.png")))
-		{
-			fprintf(stderr, "Failed to load pointer texture!");
-			return false;
-		}
+		fprintf(stderr, "Failed to load pointer texture!");
+		return false;
 	}
 
-	if (!game_done.is_valid())
+	game_done = TextureManager::load(textures_path("congratulations.png"), "complete_screen");
+	if (!game_done)
 	{
-		if (!game_done.load_from_file(textures_path("congratulations.png")))
-		{
-			fprintf(stderr, "Failed to load game done texture!");
-			return false;
-		}
+		fprintf(stderr, "Failed to load game done texture!");
+		return false;
 	}
 
-	if (!main_menu.is_valid())
+	main_menu = TextureManager::load(textures_path("main_menu.png"), "complete_screen");
+	if (!main_menu)
 	{
-		if (!main_menu.load_from_file(textures_path("main_menu.png")))
-		{
-			fprintf(stderr, "Failed to load main menu texture!");
-			return false;
-		}
+		fprintf(stderr, "Failed to load main menu texture!");
+		return false;
 	}
 
-	if (!quit.is_valid())
+	quit = TextureManager::load(textures_path("quit.png"), "complete_screen");
+	if (!quit)
 	{
-		if (!quit.load_from_file(textures_path("quit.png")))
-		{
-			fprintf(stderr, "Failed to load quit texture!");
-			return false;
-		}
+		fprintf(stderr, "Failed to load quit texture!");
+		return false;
 	}
 
-	if (!piere_win.is_valid())
+	piere_win = TextureManager::load(textures_path("piere_win.png"), "complete_screen");
+	if (!piere_win)
 	{
-		if (!piere_win.load_from_file(textures_path("piere_win.png")))
-		{
-			fprintf(stderr, "Failed to load piere win texture!");
-			return false;
-		}
+		fprintf(stderr, "Failed to load piere win texture!");
+		return false;
 	}
 
 	// the position corresponds to the center of the texture
@@ -126,29 +110,29 @@ void CompleteScreen::update(unsigned int state)
 void CompleteScreen::draw(const mat3 &proj)
 {
 	// pointer
-	vec2 pointer_scale = vec2({pointer.width / (8 * SCREEN_WIDTH), pointer.height / (8 * SCREEN_WIDTH)});
+	vec2 pointer_scale = vec2({pointer->width / (8 * SCREEN_WIDTH), pointer->height / (8 * SCREEN_WIDTH)});
 	//vec2 m_pointer_pos
-	draw_element(proj, pointer, pointer_pos, pointer_scale);
+	draw_element(proj, *pointer, pointer_pos, pointer_scale);
 
 	// game done
 	vec2 game_done_pos = vec2({SCREEN_WIDTH / 2.f, 1 * (SCREEN_HEIGHT / 4.f)});
-	vec2 game_done_scale = vec2({game_done.width * 1.5f / (2 * SCREEN_WIDTH), game_done.height * 1.5f / (2 * SCREEN_WIDTH)});
-	draw_element(proj, game_done, game_done_pos, game_done_scale);
+	vec2 game_done_scale = vec2({game_done->width * 1.5f / (2 * SCREEN_WIDTH), game_done->height * 1.5f / (2 * SCREEN_WIDTH)});
+	draw_element(proj, *game_done, game_done_pos, game_done_scale);
 
 	// piere win over
-	vec2 piere_win_scale = vec2({piere_win.width / (2.2f * SCREEN_WIDTH), piere_win.height / (2.0f * SCREEN_WIDTH)});
+	vec2 piere_win_scale = vec2({piere_win->width / (2.2f * SCREEN_WIDTH), piere_win->height / (2.0f * SCREEN_WIDTH)});
 	vec2 piere_win_pos = vec2({300.f, SCREEN_HEIGHT / 1.5f});
-	draw_element(proj, piere_win, piere_win_pos, piere_win_scale);
+	draw_element(proj, *piere_win, piere_win_pos, piere_win_scale);
 
 	// main menu
 	vec2 main_menu_pos = vec2({850.f, 2 * (SCREEN_HEIGHT / 4.f)});
-	vec2 main_menu_scale = vec2({main_menu.width / (2 * SCREEN_WIDTH), main_menu.height / (2 * SCREEN_WIDTH)});
-	draw_element(proj, main_menu, main_menu_pos, main_menu_scale);
+	vec2 main_menu_scale = vec2({main_menu->width / (2 * SCREEN_WIDTH), main_menu->height / (2 * SCREEN_WIDTH)});
+	draw_element(proj, *main_menu, main_menu_pos, main_menu_scale);
 
 	// quit
 	vec2 quit_pos = vec2({850.f, 3 * (SCREEN_HEIGHT / 4.f)});
-	vec2 quit_scale = vec2({quit.width / (2 * SCREEN_WIDTH), quit.height / (2 * SCREEN_WIDTH)});
-	draw_element(proj, quit, quit_pos, quit_scale);
+	vec2 quit_scale = vec2({quit->width / (2 * SCREEN_WIDTH), quit->height / (2 * SCREEN_WIDTH)});
+	draw_element(proj, *quit, quit_pos, quit_scale);
 }
 
 void CompleteScreen::draw_element(const mat3& proj, const Texture& texture, vec2 pos, vec2 scale)
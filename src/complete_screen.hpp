@@ -3,16 +3,17 @@
 // internal
 #include "common.hpp"
 #include "constants.hpp"
+#include "texture_manager.hpp"
 
 // complete screen
 class CompleteScreen : public Entity
 {
 	// shared texture
-	static Texture pointer;
-	static Texture game_done;
-	static Texture main_menu;
-	static Texture quit;
-	static Texture piere_win;
+	TextureHandle pointer;
+	TextureHandle game_done;
+	TextureHandle main_menu;
+	TextureHandle quit;
+	TextureHandle piere_win;
 
 private:
 	vec2 pointer_pos;
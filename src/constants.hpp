@@ -7,6 +7,12 @@ static constexpr float SCREEN_HEIGHT = 800.f;
 // projection
 static constexpr float PROJECTION_SCALE = 9.5f;
 
+// level grid
+static constexpr float TILE_SIZE = 20.f;
+// built-in levels in tiles, level files and scenarios can be any size
+static constexpr int MAP_WIDTH = 60;
+static constexpr int MAP_HEIGHT = 40;
+
 // game state
 static constexpr unsigned int START_SCREEN = 0;
 static constexpr unsigned int CONTROL_SCREEN = 1;
@@ -27,6 +33,7 @@ static constexpr unsigned int LEVEL_4_CUTSCENE = 4500;
 static constexpr unsigned int LEVEL_5 = 5000;
 static constexpr unsigned int LEVEL_5_CUTSCENE = 5500;
 static constexpr unsigned int LEVEL_TUTORIAL = 999000;
+static constexpr unsigned int LEVEL_SCENARIO = 998000; // generated, see scenario.hpp
 static constexpr unsigned int RESUME = 0;
 static constexpr unsigned int RESTART = 1;
 static constexpr unsigned int MAIN_MENU = 2;
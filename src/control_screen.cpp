@@ -4,23 +4,19 @@
 // stdlib
 #include <cmath>
 
-Texture ControlScreen::control_screen;
-
 bool ControlScreen::init()
 {
 	// load shared texture
-	if (!control_screen.is_valid())
+	control_screen = TextureManager::load(textures_path("control_screen.png"), "control_screen");
+	if (!control_screen)
 	{
-		if (!control_screen.load_from_file(textures_path("control_screen.png")))
-		{
-			fprintf(stderr, "Failed to load control texture!");
-			return false;
-		}
+		fprintf(stderr, "Failed to load control texture!");
+		return false;
 	}
 
 	// the position corresponds to the center of the texture
-	float wr = control_screen.width * 0.5f;
-	float hr = control_screen.height * 0.5f;
+	float wr = control_screen->width * 0.5f;
+	float hr = control_screen->height * 0.5f;
 
 	TexturedVertex vertices[4];
 	vertices[0].position = {-wr, +hr, -0.0f};
@@ -59,8 +55,8 @@ bool ControlScreen::init()
 	motion.position.x = SCREEN_WIDTH / 2;
 	motion.position.y = SCREEN_HEIGHT / 2;
 
-	physics.scale.x = SCREEN_WIDTH / control_screen.width;
-	physics.scale.y = SCREEN_HEIGHT / control_screen.height;
+	physics.scale.x = SCREEN_WIDTH / control_screen->width;
+	physics.scale.y = SCREEN_HEIGHT / control_screen->height;
 
 	return true;
 }
@@ -113,7 +109,7 @@ void ControlScreen::draw(const mat3 &projection)
 
 	// enable and binding texture to slot 0
 	glActiveTexture(GL_TEXTURE0);
-	glBindTexture(GL_TEXTURE_2D, control_screen.id);
+	glBindTexture(GL_TEXTURE_2D, control_screen->id);
 
 	// set uniform values to the currently bound program
 	glUniformMatrix3fv(transform_uloc, 1, GL_FALSE, (float *)&transform.out);
@@ -3,12 +3,13 @@
 // internal
 #include "common.hpp"
 #include "constants.hpp"
+#include "texture_manager.hpp"
 
 // control screen
 class ControlScreen : public Entity
 {
 	// shared texture
-	static Texture control_screen;
+	TextureHandle control_screen;
 
 public:
 	bool init();
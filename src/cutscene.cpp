@@ -7,79 +7,139 @@
 #include <string>
 #include <iostream>
 
-Texture Cutscene::texture_dialogue_box;
-Texture Cutscene::texture_dialogue_box_left;
-Texture Cutscene::texture_dialogue_box_right;
-Texture Cutscene::texture_dialogue_box_mid;
-Texture Cutscene::enemy_texture;
 //Texture Cutscene::skip_texture;
-Texture Cutscene::texture_background;
 
 using namespace std;
 
-bool Cutscene::init()
+namespace
 {
-	dialogue_counter = 1;
-	current_cutscene_state = 4;
-
-	// load shared texture
-	if (!texture_dialogue_box.is_valid())
+// the panels of one cutscene, numbered on from the previous cutscene
+struct panel_sequence
+{
+	unsigned int state;
+	unsigned int first;
+	unsigned int last;
+	const char *folder;
+};
+
+// portraits and background switched to on a panel, null keeps the current one
+struct panel_change
+{
+	unsigned int counter;
+	const char *left;
+	const char *right;
+	const char *background;
+};
+
+const panel_sequence SEQUENCES[] = {
+	{STORY_SCREEN, 1, 27, "story"},
+	{LEVEL_TUTORIAL, 28, 49, "tutorial"},
+	{LEVEL_1_CUTSCENE, 50, 69, "level1"},
+	{LEVEL_2_CUTSCENE, 70, 80, "level2"},
+	{LEVEL_3_CUTSCENE, 81, 92, "level3"},
+};
+
+const panel_change CHANGES[] = {
+	{1, "spotter.png", "wanderer.png", "bg_story_0.png"},
+	{4, "dialogue_box_face.png", "roger.png", "bg_story_1.png"},
+	{6, "pierre.png", nullptr, nullptr},
+	{14, nullptr, "dialogue_box_face.png", nullptr},
+	{18, nullptr, "intel.png", nullptr},
+	{28, "pierre.png", "intel.png", nullptr},
+	{50, "pierre.png", "intel.png", "bg_level1_0.png"},
+	{58, nullptr, "wanderer.png", nullptr},
+	{59, nullptr, "intel.png", nullptr},
+	{67, nullptr, "dialogue_box_face.png", nullptr},
+	{70, "pierre.png", "intel.png", "bg_level2_0.png"},
+	{76, nullptr, "spotter.png", nullptr},
+	{77, nullptr, "intel.png", nullptr},
+	{81, "pierre.png", "intel.png", "bg_level3_0.png"},
+};
+
+// panels decoded ahead of the one shown, across cutscenes too, so the next
+// cutscene's first panel and background are ready before its level ends
+const unsigned int LOOKAHEAD = 3;
+
+const panel_sequence *find_sequence(unsigned int counter)
+{
+	for (const panel_sequence &sequence : SEQUENCES)
 	{
-		if (!texture_dialogue_box.load_from_file(textures_path("cutscenes/dialogue_box.png")))
-		{
-			fprintf(stderr, "Failed to load dialogue texture!");
-			return false;
-		}
+		if (counter >= sequence.first && counter <= sequence.last)
+			return &sequence;
 	}
+	return nullptr;
+}
 
-	if (!texture_dialogue_box_left.is_valid())
+const panel_change *find_change(unsigned int counter)
+{
+	for (const panel_change &change : CHANGES)
 	{
-		if (!texture_dialogue_box_left.load_from_file(textures_path("cutscenes/dialogue_box_face.png")))
-		{
-			fprintf(stderr, "Failed to load dialogue texture!");
-			return false;
-		}
+		if (change.counter == counter)
+			return &change;
 	}
+	return nullptr;
+}
 
-	if (!texture_dialogue_box_right.is_valid())
+// latest portrait or background at or before the counter, null before the first change
+const char *latest_change(unsigned int counter, const char *panel_change::*field)
+{
+	const char *name = nullptr;
+	for (const panel_change &change : CHANGES)
 	{
-		if (!texture_dialogue_box_right.load_from_file(textures_path("cutscenes/dialogue_box_face.png")))
-		{
-			fprintf(stderr, "Failed to load dialogue texture!");
-			return false;
-		}
+		if (change.counter > counter)
+			break;
+		if (change.*field != nullptr)
+			name = change.*field;
 	}
+	return name;
+}
 
-	if (!texture_dialogue_box_mid.is_valid())
-	{
-		if (!texture_dialogue_box_mid.load_from_file(textures_path("cutscenes/dialogue_placeholder.png")))
-		{
-			fprintf(stderr, "Failed to load dialogue texture!");
-			return false;
-		}
-	}
+string cutscene_path(const string &name)
+{
+	return textures_path("cutscenes/") + name;
+}
+
+string panel_path(const panel_sequence &sequence, unsigned int counter)
+{
+	return cutscene_path(string(sequence.folder) + "/" + to_string(counter) + ".png");
+}
+
+TextureHandle load(const string &path)
+{
+	return TextureManager::load(path, "cutscene");
+}
+} // namespace
 
-	if (!enemy_texture.is_valid())
+bool Cutscene::init()
+{
+	dialogue_counter = 1;
+	current_cutscene_state = m_shown_state = 4;
+	m_show_counter = m_shown_counter = 0;
+
+	// load shared texture
+	texture_dialogue_box = TextureManager::load(textures_path("cutscenes/dialogue_box.png"), "cutscene");
+	if (!texture_dialogue_box)
 	{
-		if (!enemy_texture.load_from_file(textures_path("wanderers/1.png")))
-		{
-			fprintf(stderr, "Failed to load enemy texture!");
-			return false;
-		}
+		fprintf(stderr, "Failed to load dialogue texture!");
+		return false;
 	}
 
-	if (!texture_background.is_valid())
+	enemy_texture = TextureManager::load(textures_path("wanderers/1.png"), "cutscene");
+	if (!enemy_texture)
 	{
-		if (!texture_background.load_from_file(textures_path("cutscenes/bg_story_0.png")))
-		{
-			fprintf(stderr, "Failed to load background texture!");
-			return false;
-		}
+		fprintf(stderr, "Failed to load enemy texture!");
+		return false;
 	}
 
+	// placeholders until the story starts, its first panels decode meanwhile
+	m_left = m_right = load(cutscene_path("dialogue_box_face.png"));
+	m_panel = load(cutscene_path("dialogue_placeholder.png"));
+	m_background = load(cutscene_path("bg_story_0.png"));
+	prefetch(0);
+
 	/* if (!skip_texture.is_valid())
 	{
-		if (!skip_texture.load_from_file(textures_path("skip.png")))
+		if (!skip_texture.load_async(textures_path("skip.png")))
 		{
 			fprintf(stderr, "Failed to load skip texture!");
 			return false;
@@ -137,6 +197,14 @@ void Cutscene::destroy()
 	glDeleteVertexArrays(1, &mesh.vao);
 
 	effect.release();
+
+	texture_dialogue_box.reset();
+	enemy_texture.reset();
+	m_panel.reset();
+	m_left.reset();
+	m_right.reset();
+	m_background.reset();
+	m_prefetched.clear();
 }
 
 void Cutscene::update() {}
@@ -156,49 +224,53 @@ void Cutscene::draw(const mat3 &proj) {}
 
 void Cutscene::draw(const mat3 &proj, vec2 wsize, const vec2 wpoint)
 {
-	float wscale = current_cutscene_state == LEVEL_TUTORIAL ? (float)SCREEN_WIDTH * ((float)SCREEN_WIDTH / wsize.x) : (float)SCREEN_WIDTH;
+	float wscale = m_shown_state == LEVEL_TUTORIAL ? (float)SCREEN_WIDTH * ((float)SCREEN_WIDTH / wsize.x) : (float)SCREEN_WIDTH;
 
 	vec2 d_box_trans = vec2({0.f,0.f});
 	vec2 d_text_trans = vec2({0.f,0.f});
 	vec2 d_face_trans_left = vec2({0.f,0.f});
 	vec2 d_face_trans_right = vec2({0.f,0.f});
 
-	vec2 d_box_scale = vec2({(float)texture_dialogue_box.width / wscale, (float)texture_dialogue_box.height / wscale});
-	vec2 d_text_scale = vec2({(float)texture_dialogue_box_mid.width / wscale, (float)texture_dialogue_box_mid.height / wscale});
-	vec2 d_face_scale = vec2({(float)texture_dialogue_box_left.width / wscale, (float)texture_dialogue_box_left.height / wscale});
+	vec2 d_box_scale = vec2({(float)texture_dialogue_box->width / wscale, (float)texture_dialogue_box->height / wscale});
+	vec2 d_text_scale = vec2({(float)m_panel->width / wscale, (float)m_panel->height / wscale});
+	vec2 d_face_scale = vec2({(float)m_left->width / wscale, (float)m_left->height / wscale});
 
-	if (current_cutscene_state == LEVEL_TUTORIAL)
+	if (m_shown_state == LEVEL_TUTORIAL)
 	{
-		d_box_trans.x = wpoint.x + (float)texture_dialogue_box.width * (d_box_scale.x) / 2;
-		d_box_trans.y = wpoint.y + (float)texture_dialogue_box.height * (d_box_scale.y * 3);
+		d_box_trans.x = wpoint.x + (float)texture_dialogue_box->width * (d_box_scale.x) / 2;
+		d_box_trans.y = wpoint.y + (float)texture_dialogue_box->height * (d_box_scale.y * 3);
 
-		d_text_trans.x = wpoint.x + (float)texture_dialogue_box_mid.width * (d_text_scale.x * 1.1250);
-		d_text_trans.y = wpoint.y + (float)texture_dialogue_box_mid.height * (d_text_scale.y * 3);
+		d_text_trans.x = wpoint.x + (float)m_panel->width * (d_text_scale.x * 1.1250);
+		d_text_trans.y = wpoint.y + (float)m_panel->height * (d_text_scale.y * 3);
 
-		d_face_trans_left.x = wpoint.x + (float)texture_dialogue_box_left.width * (d_face_scale.x * 3);
-		d_face_trans_left.y = wpoint.y + (float)texture_dialogue_box_left.height * (d_face_scale.y * 3); 
-		d_face_trans_right.x = wpoint.x + wsize.x - (float)texture_dialogue_box_left.width * (d_face_scale.x * 3);
-		d_face_trans_right.y = wpoint.y + (float)texture_dialogue_box_left.height * (d_face_scale.y * 3);
+		d_face_trans_left.x = wpoint.x + (float)m_left->width * (d_face_scale.x * 3);
+		d_face_trans_left.y = wpoint.y + (float)m_left->height * (d_face_scale.y * 3); 
+		d_face_trans_right.x = wpoint.x + wsize.x - (float)m_left->width * (d_face_scale.x * 3);
+		d_face_trans_right.y = wpoint.y + (float)m_left->height * (d_face_scale.y * 3);
 	}
 	else
 	{
-		d_face_trans_left = vec2({(float)(texture_dialogue_box_left.width / 2), (float)(texture_dialogue_box_left.height / 2)});
-		d_text_trans = vec2({(float)(texture_dialogue_box_mid.width / 2) + (float)texture_dialogue_box_left.width, (float)(texture_dialogue_box_mid.height / 2)});
-		d_face_trans_right = vec2({(float)(SCREEN_WIDTH - texture_dialogue_box_right.width / 2), (float)(texture_dialogue_box_right.height / 2)});
-		d_box_trans = vec2({(float)(texture_dialogue_box.width / 2), (float)(texture_dialogue_box.height / 2)});
+		d_face_trans_left = vec2({(float)(m_left->width / 2), (float)(m_left->height / 2)});
+		d_text_trans = vec2({(float)(m_panel->width / 2) + (float)m_left->width, (float)(m_panel->height / 2)});
+		d_face_trans_right = vec2({(float)(SCREEN_WIDTH - m_right->width / 2), (float)(m_right->height / 2)});
+		d_box_trans = vec2({(float)(texture_dialogue_box->width / 2), (float)(texture_dialogue_box->height / 2)});
 	}
 
-	draw_element(proj, texture_dialogue_box_left, d_face_trans_left, d_face_scale);
-	draw_element(proj, texture_dialogue_box_mid, d_text_trans, d_text_scale);
-	draw_element(proj, texture_dialogue_box_right, d_face_trans_right, d_face_scale);
-	draw_element(proj, texture_dialogue_box, d_box_trans, d_box_scale);
+	draw_element(proj, *m_left, d_face_trans_left, d_face_scale);
+	draw_element(proj, *m_panel, d_text_trans, d_text_scale);
+	draw_element(proj, *m_right, d_face_trans_right, d_face_scale);
+	draw_element(proj, *texture_dialogue_box, d_box_trans, d_box_scale);
 
-	if (current_cutscene_state != LEVEL_TUTORIAL)
-		draw_element(proj, texture_background, vec2({(float)(SCREEN_WIDTH / 2), (float)(SCREEN_HEIGHT / 2)}), vec2({1.f,1.f}));
+	if (m_shown_state != LEVEL_TUTORIAL)
+		draw_element(proj, *m_background, vec2({(float)(SCREEN_WIDTH / 2), (float)(SCREEN_HEIGHT / 2)}), vec2({1.f,1.f}));
 }
 
 void Cutscene::draw_element(const mat3& proj, const Texture& texture, vec2 pos, vec2 scale)
 {
+	// a panel nothing prefetched shows up once decoded, World redraws until then
+	if (!texture.is_ready())
+		return;
+
 	// transformation
 	transform.begin();
 	transform.translate(pos);
@@ -249,16 +321,11 @@ void Cutscene::draw_element(const mat3& proj, const Texture& texture, vec2 pos,
 
 bool Cutscene::dialogue_done(unsigned int cutscene_state)
 {
-	if (cutscene_state == 4 && dialogue_counter == 27)
-		return true;
-	else if (cutscene_state == LEVEL_TUTORIAL && dialogue_counter == 49)
-		return true;
-	else if (cutscene_state == LEVEL_1_CUTSCENE && dialogue_counter == 69)
-		return true;
-	else if (cutscene_state == LEVEL_2_CUTSCENE && dialogue_counter == 80)
-		return true;
-	else if (cutscene_state == LEVEL_3_CUTSCENE && dialogue_counter == 92)
-		return true;
+	for (const panel_sequence &sequence : SEQUENCES)
+	{
+		if (sequence.state == cutscene_state)
+			return dialogue_counter == sequence.last;
+	}
 
 	return false;
 }
@@ -268,240 +335,83 @@ void Cutscene::increment_dialogue_counter(unsigned int game_state)
 	dialogue_counter++;
 	current_cutscene_state = game_state;
 
-	if (game_state == STORY_SCREEN)
+	for (const panel_sequence &sequence : SEQUENCES)
 	{
-		string temp_str = "data/textures/cutscenes/story/" + to_string(dialogue_counter) + ".png";
-		string s(PROJECT_SOURCE_DIR);
-		s += temp_str;
-		const char *path = s.c_str();
-
-		texture_dialogue_box_mid.~Texture();
-		texture_dialogue_box_mid.load_from_file(path);
-
-		if (dialogue_counter == 1)
+		if (sequence.state == game_state)
 		{
-			texture_dialogue_box_left.~Texture();
-			texture_dialogue_box_left.load_from_file(textures_path("cutscenes/spotter.png"));
-			texture_dialogue_box_right.~Texture();
-			texture_dialogue_box_right.load_from_file(textures_path("cutscenes/wanderer.png"));
-
-			texture_background.~Texture();
-			texture_background.load_from_file(textures_path("cutscenes/bg_story_0.png"));
-		}
-		else if (dialogue_counter == 4)
-		{
-			texture_dialogue_box_left.~Texture();
-			texture_dialogue_box_left.load_from_file(textures_path("cutscenes/dialogue_box_face.png"));
-			texture_dialogue_box_right.~Texture();
-			texture_dialogue_box_right.load_from_file(textures_path("cutscenes/roger.png"));
-
-			texture_background.~Texture();
-			texture_background.load_from_file(textures_path("cutscenes/bg_story_1.png"));
-		}
-		else if (dialogue_counter == 6)
-		{
-			texture_dialogue_box_left.~Texture();
-			texture_dialogue_box_left.load_from_file(textures_path("cutscenes/pierre.png"));
-		}
-		else if (dialogue_counter == 14)
-		{
-			texture_dialogue_box_right.~Texture();
-			texture_dialogue_box_right.load_from_file(textures_path("cutscenes/dialogue_box_face.png"));
-		}
-		else if (dialogue_counter == 18)
-		{
-			texture_dialogue_box_right.~Texture();
-			texture_dialogue_box_right.load_from_file(textures_path("cutscenes/intel.png"));
+			m_show_counter = dialogue_counter;
+			break;
 		}
 	}
+}
 
-	else if (game_state == LEVEL_TUTORIAL)
-	{
-		string temp_str = "data/textures/cutscenes/tutorial/" + to_string(dialogue_counter) + ".png";
-		string s(PROJECT_SOURCE_DIR);
-		s += temp_str;
-		const char *path = s.c_str();
-
-		texture_dialogue_box_mid.~Texture();
-		texture_dialogue_box_mid.load_from_file(path);
+// only the start of a cutscene shows a panel, other values just move the counter
+void Cutscene::set_dialogue_counter(unsigned int cutscene_state, unsigned int counter_value)
+{
+	dialogue_counter = counter_value;
+	current_cutscene_state = cutscene_state;
 
-		if (dialogue_counter == 28)
+	for (const panel_sequence &sequence : SEQUENCES)
+	{
+		if (sequence.state == cutscene_state && sequence.first == counter_value)
 		{
-			texture_dialogue_box_left.~Texture();
-			texture_dialogue_box_left.load_from_file(textures_path("cutscenes/pierre.png"));
-			texture_dialogue_box_right.~Texture();
-			texture_dialogue_box_right.load_from_file(textures_path("cutscenes/intel.png"));
+			m_show_counter = dialogue_counter;
+			break;
 		}
 	}
+}
 
-	else if (game_state == LEVEL_1_CUTSCENE)
-	{
-		string temp_str = "data/textures/cutscenes/level1/" + to_string(dialogue_counter) + ".png";
-		string s(PROJECT_SOURCE_DIR);
-		s += temp_str;
-		const char *path = s.c_str();
-
-		texture_dialogue_box_mid.~Texture();
-		texture_dialogue_box_mid.load_from_file(path);
-
-		if (dialogue_counter == 50)
-		{
-			texture_dialogue_box_left.~Texture();
-			texture_dialogue_box_left.load_from_file(textures_path("cutscenes/pierre.png"));
-			texture_dialogue_box_right.~Texture();
-			texture_dialogue_box_right.load_from_file(textures_path("cutscenes/intel.png"));
+void Cutscene::sync()
+{
+	m_shown_state = current_cutscene_state;
+	if (m_show_counter == m_shown_counter)
+		return;
 
-			texture_background.~Texture();
-			texture_background.load_from_file(textures_path("cutscenes/bg_level1_0.png"));
-		}
-		else if (dialogue_counter == 58)
-		{
-			texture_dialogue_box_right.~Texture();
-			texture_dialogue_box_right.load_from_file(textures_path("cutscenes/wanderer.png"));
-		}
-		else if (dialogue_counter == 59)
-		{
-			texture_dialogue_box_right.~Texture();
-			texture_dialogue_box_right.load_from_file(textures_path("cutscenes/intel.png"));
-		}
-		else if (dialogue_counter == 67)
-		{
-			texture_dialogue_box_right.~Texture();
-			texture_dialogue_box_right.load_from_file(textures_path("cutscenes/dialogue_box_face.png"));
-		}
-	}
+	m_shown_counter = m_show_counter;
+	show_panel(m_shown_counter);
+}
 
-	else if (game_state == LEVEL_2_CUTSCENE)
-	{
-		string temp_str = "data/textures/cutscenes/level2/" + to_string(dialogue_counter) + ".png";
-		string s(PROJECT_SOURCE_DIR);
-		s += temp_str;
-		const char *path = s.c_str();
-		
-		texture_dialogue_box_mid.~Texture();
-		texture_dialogue_box_mid.load_from_file(path);
-
-		if (dialogue_counter == 70)
-		{
-			texture_dialogue_box_left.~Texture();
-			texture_dialogue_box_left.load_from_file(textures_path("cutscenes/pierre.png"));
-			texture_dialogue_box_right.~Texture();
-			texture_dialogue_box_right.load_from_file(textures_path("cutscenes/intel.png"));
-
-			//skip_texture.~Texture();
-			//skip_texture.load_from_file(textures_path("skip.png"));
-			texture_background.~Texture();
-			texture_background.load_from_file(textures_path("cutscenes/bg_level2_0.png"));
-		}
-		else if (dialogue_counter == 76)
-		{
-			texture_dialogue_box_right.~Texture();
-			texture_dialogue_box_right.load_from_file(textures_path("cutscenes/spotter.png"));
-		}
-		else if (dialogue_counter == 77)
-		{
-			texture_dialogue_box_right.~Texture();
-			texture_dialogue_box_right.load_from_file(textures_path("cutscenes/intel.png"));
-		}
-	}
+// portraits and background come from the latest changes, so panels passed between
+// two syncs don't lose theirs
+void Cutscene::show_panel(unsigned int counter)
+{
+	const panel_sequence *sequence = find_sequence(counter);
+	if (sequence == nullptr)
+		return;
 
-	else if (game_state == LEVEL_3_CUTSCENE)
-	{
-		string temp_str = "data/textures/cutscenes/level3/" + to_string(dialogue_counter) + ".png";
-		string s(PROJECT_SOURCE_DIR);
-		s += temp_str;
-		const char *path = s.c_str();
+	m_panel = load(panel_path(*sequence, counter));
 
-		texture_dialogue_box_mid.~Texture();
-		texture_dialogue_box_mid.load_from_file(path);
+	if (const char *left = latest_change(counter, &panel_change::left))
+		m_left = load(cutscene_path(left));
+	if (const char *right = latest_change(counter, &panel_change::right))
+		m_right = load(cutscene_path(right));
+	if (const char *background = latest_change(counter, &panel_change::background))
+		m_background = load(cutscene_path(background));
 
-		if (dialogue_counter == 81)
-		{
-			texture_dialogue_box_left.~Texture();
-			texture_dialogue_box_left.load_from_file(textures_path("cutscenes/pierre.png"));
-			texture_dialogue_box_right.~Texture();
-			texture_dialogue_box_right.load_from_file(textures_path("cutscenes/shooter.png"));
-
-			//skip_texture.~Texture();
-			//skip_texture.load_from_file(textures_path("skip.png"));
-			texture_background.~Texture();
-			texture_background.load_from_file(textures_path("cutscenes/bg_level3_0.png"));
-		}
-		else if (dialogue_counter == 83)
-		{
-			texture_dialogue_box_right.~Texture();
-			texture_dialogue_box_right.load_from_file(textures_path("cutscenes/intel.png"));
-		}
-	}
+	prefetch(counter);
 }
 
-void Cutscene::set_dialogue_counter(unsigned int cutscene_state, unsigned int counter_value)
+// the new handles are taken before the old ones go, textures still ahead stay loaded
+void Cutscene::prefetch(unsigned int counter)
 {
-	dialogue_counter = counter_value;
-	current_cutscene_state = cutscene_state;
-
-	if (cutscene_state == STORY_SCREEN && counter_value == 1)
-	{
-		texture_dialogue_box_mid.~Texture();
-		texture_dialogue_box_mid.load_from_file(textures_path("cutscenes/story/1.png"));
-		texture_dialogue_box_left.~Texture();
-		texture_dialogue_box_left.load_from_file(textures_path("cutscenes/spotter.png"));
-		texture_dialogue_box_right.~Texture();
-		texture_dialogue_box_right.load_from_file(textures_path("cutscenes/wanderer.png"));
-
-		//skip_texture.~Texture();
-		//skip_texture.load_from_file(textures_path("skip.png"));
-
-		texture_background.~Texture();
-		texture_background.load_from_file(textures_path("cutscenes/bg_story_0.png"));
-	}
-	else if (cutscene_state == LEVEL_TUTORIAL && counter_value == 28)
+	std::vector<TextureHandle> prefetched;
+	for (unsigned int next = counter + 1; next <= counter + LOOKAHEAD; next++)
 	{
-		texture_dialogue_box_mid.~Texture();
-		texture_dialogue_box_mid.load_from_file(textures_path("cutscenes/tutorial/28.png"));
-		texture_dialogue_box_left.~Texture();
-		texture_dialogue_box_left.load_from_file(textures_path("cutscenes/pierre.png"));
-		texture_dialogue_box_right.~Texture();
-		texture_dialogue_box_right.load_from_file(textures_path("cutscenes/intel.png"));
+		const panel_sequence *sequence = find_sequence(next);
+		if (sequence == nullptr)
+			break;
+
+		prefetched.push_back(load(panel_path(*sequence, next)));
+
+		const panel_change *change = find_change(next);
+		if (change == nullptr)
+			continue;
+		if (change->left != nullptr)
+			prefetched.push_back(load(cutscene_path(change->left)));
+		if (change->right != nullptr)
+			prefetched.push_back(load(cutscene_path(change->right)));
+		if (change->background != nullptr)
+			prefetched.push_back(load(cutscene_path(change->background)));
 	}
-	else if (cutscene_state == LEVEL_1_CUTSCENE && counter_value == 50)
-	{
-		texture_dialogue_box_mid.~Texture();
-		texture_dialogue_box_mid.load_from_file(textures_path("cutscenes/level1/50.png"));
-		texture_dialogue_box_left.~Texture();
-		texture_dialogue_box_left.load_from_file(textures_path("cutscenes/pierre.png"));
-		texture_dialogue_box_right.~Texture();
-		texture_dialogue_box_right.load_from_file(textures_path("cutscenes/intel.png"));
-
-		//skip_texture.~Texture();
-		//skip_texture.load_from_file(textures_path("skip.png"));
-		texture_background.~Texture();
-		texture_background.load_from_file(textures_path("cutscenes/bg_level1_0.png"));
-	}
-	else if (cutscene_state == LEVEL_2_CUTSCENE && counter_value == 70)
-	{
-		texture_dialogue_box_mid.~Texture();
-		texture_dialogue_box_mid.load_from_file(textures_path("cutscenes/level2/70.png"));
-		texture_dialogue_box_left.~Texture();
-		texture_dialogue_box_left.load_from_file(textures_path("cutscenes/pierre.png"));
-		texture_dialogue_box_right.~Texture();
-		texture_dialogue_box_right.load_from_file(textures_path("cutscenes/intel.png"));
-
-		texture_background.~Texture();
-		texture_background.load_from_file(textures_path("cutscenes/bg_level2_0.png"));
-	}
-	else if (cutscene_state == LEVEL_3_CUTSCENE && counter_value == 81)
-	{
-		texture_dialogue_box_mid.~Texture();
-		texture_dialogue_box_mid.load_from_file(textures_path("cutscenes/level3/81.png"));
-		texture_dialogue_box_left.~Texture();
-		texture_dialogue_box_left.load_from_file(textures_path("cutscenes/pierre.png"));
-		texture_dialogue_box_right.~Texture();
-		texture_dialogue_box_right.load_from_file(textures_path("cutscenes/intel.png"));
-
-		//skip_texture.~Texture();
-		//skip_texture.load_from_file(textures_path("skip.png"));
-		texture_background.~Texture();
-		texture_background.load_from_file(textures_path("cutscenes/bg_level3_0.png"));
-	}
-}
\ No newline at end of file
+	m_prefetched.swap(prefetched);
+}
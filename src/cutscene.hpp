@@ -3,21 +3,35 @@
 // internal
 #include "common.hpp"
 #include "constants.hpp"
+#include "texture_manager.hpp"
+
+// stlib
+#include <string>
+#include <vector>
 
 // start screen
 class Cutscene : public Entity
 {
 	// shared texture
-	static Texture texture_dialogue_box;
-	static Texture texture_dialogue_box_left;
-	static Texture texture_dialogue_box_right;
-	static Texture texture_dialogue_box_mid;
-	static Texture enemy_texture;
+	TextureHandle texture_dialogue_box;
+	TextureHandle enemy_texture;
 	//static Texture skip_texture;
-	static Texture texture_background;
+
+	// panels, portraits and backgrounds shown
+	TextureHandle m_panel;
+	TextureHandle m_left;
+	TextureHandle m_right;
+	TextureHandle m_background;
+
+	// the next panels and their portraits and backgrounds, held so they stay loaded
+	std::vector<TextureHandle> m_prefetched;
 
   unsigned int dialogue_counter;
 
+	// the counter moves on the simulation thread, sync() loads its panel on the GL thread
+	unsigned int m_show_counter;  // panel asked for, 0 for none
+	unsigned int m_shown_counter; // panel the textures are loaded for
+
 	int left_dialogues[43] = {
 		1, 3, 6, 7, 10, 14, 15, 17, 19, 20, 26, 27, 30, 31, 34,
 		37, 39, 41, 43, 46, 47, 51, 53, 55, 57, 59, 61, 63, 67,
@@ -25,12 +39,19 @@ class Cutscene : public Entity
 	};
 
 	unsigned int current_cutscene_state;
+	unsigned int m_shown_state; // current_cutscene_state as of the last sync, draw lays out by it
+
+	void show_panel(unsigned int counter);
+	void prefetch(unsigned int counter);
 
 public:
 	bool init();
 	void destroy();
 	void update();
 
+	// GL thread: loads the panel the counter moved to and prefetches the next ones
+	void sync();
+
 	void draw(const mat3& proj) override;
 	void draw(const mat3& proj, vec2 wsize, const vec2 wpoint);
 	void draw_element(const mat3& proj, const Texture& texture, vec2 pos, vec2 scale);
@@ -0,0 +1,110 @@
+// header
+#include "frame_pacer.hpp"
+
+// stlib
+#include <algorithm>
+#include <thread>
+
+#if defined(__linux__)
+#include <cerrno>
+#include <time.h>
+#endif
+
+namespace
+{
+// steady_clock is CLOCK_MONOTONIC on linux, so deadlines can be passed through as they are.
+// clock_nanosleep with an absolute deadline doesn't drift when interrupted and wakes with
+// sub-millisecond precision where Sleep/usleep round to the scheduler tick
+void sleep_until(FramePacer::Clock::time_point deadline)
+{
+#if defined(__linux__)
+	auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(deadline.time_since_epoch()).count();
+	timespec ts;
+	ts.tv_sec = (time_t)(ns / 1000000000);
+	ts.tv_nsec = (long)(ns % 1000000000);
+	while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, nullptr) == EINTR)
+	{
+	}
+#else
+	std::this_thread::sleep_until(deadline);
+#endif
+}
+
+FramePacer::Clock::duration period(float hz)
+{
+	return std::chrono::duration_cast<FramePacer::Clock::duration>(std::chrono::duration<double>(1.0 / hz));
+}
+} // namespace
+
+FramePacer::FramePacer() : m_step(period(25.f)),
+						   m_frame(0),
+						   m_max_catch_up(5),
+						   m_accumulator(0),
+						   m_dropped_steps(0)
+{
+}
+
+void FramePacer::init(float sim_hz, float frame_cap_hz, int max_catch_up)
+{
+	m_step = period(sim_hz);
+	m_frame = frame_cap_hz > 0.f ? period(frame_cap_hz) : Clock::duration(0);
+	m_max_catch_up = std::max(1, max_catch_up);
+
+	m_last = Clock::now();
+	m_next_frame = m_last;
+	m_accumulator = Clock::duration(0);
+	m_dropped_steps = 0;
+}
+
+void FramePacer::resync()
+{
+	m_last = Clock::now();
+	m_next_frame = m_last;
+	m_accumulator = Clock::duration(0);
+}
+
+int FramePacer::begin_frame()
+{
+	Clock::time_point now = Clock::now();
+	m_accumulator += now - m_last;
+	m_last = now;
+
+	int steps = (int)(m_accumulator / m_step);
+	if (steps > m_max_catch_up)
+	{
+		m_dropped_steps += steps - m_max_catch_up;
+		m_accumulator = m_accumulator % m_step + m_max_catch_up * m_step;
+		steps = m_max_catch_up;
+	}
+
+	m_accumulator -= steps * m_step;
+	return steps;
+}
+
+void FramePacer::end_frame()
+{
+	if (m_frame == Clock::duration(0))
+		return;
+
+	m_next_frame += m_frame;
+	Clock::time_point now = Clock::now();
+	if (m_next_frame < now)
+		m_next_frame = now;
+	else
+		sleep_until(m_next_frame);
+}
+
+float FramePacer::get_step_ms() const
+{
+	return std::chrono::duration<float, std::milli>(m_step).count();
+}
+
+float FramePacer::get_alpha() const
+{
+	return std::min(1.f, (float)m_accumulator.count() / (float)m_step.count());
+}
+
+int FramePacer::get_dropped_steps() const
+{
+	return m_dropped_steps;
+}
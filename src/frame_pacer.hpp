@@ -0,0 +1,46 @@
+#pragma once
+
+// stlib
+#include <chrono>
+
+// fixed timestep clock for the main loop
+// real time is accumulated and handed out as whole simulation steps, the remainder
+// is the interpolation factor between the last two simulated states
+class FramePacer
+{
+public:
+	using Clock = std::chrono::steady_clock;
+
+private:
+	Clock::duration m_step;
+	Clock::duration m_frame; // zero: presenting (vsync) paces the frames
+	int m_max_catch_up;
+
+	Clock::time_point m_last;
+	Clock::time_point m_next_frame;
+	Clock::duration m_accumulator;
+	int m_dropped_steps;
+
+public:
+	FramePacer();
+
+	// frame_cap_hz <= 0 leaves pacing to the swap interval
+	void init(float sim_hz, float frame_cap_hz, int max_catch_up);
+
+	// forgets the time since the last frame, used after the loop blocked on purpose
+	void resync();
+
+	// steps to simulate for the time passed since the last call, at most max_catch_up,
+	// a longer stall (debugger, window drag) is dropped instead of replayed
+	int begin_frame();
+
+	// sleeps until the next frame deadline when frames are capped
+	void end_frame();
+
+	float get_step_ms() const;
+
+	// 0..1, how far render time is past the last simulated step
+	float get_alpha() const;
+
+	int get_dropped_steps() const;
+};
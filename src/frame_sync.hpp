@@ -0,0 +1,134 @@
+#pragma once
+
+// stlib
+#include <atomic>
+#include <cstddef>
+
+// single producer / single consumer handoff of the latest value. The producer fills
+// write_slot() and publishes it, the consumer acquires the newest published value.
+// Neither side blocks and the consumer never sees a half written value.
+template <typename T>
+class TripleBuffer
+{
+private:
+	static constexpr int FRESH = 4; // set on the middle index while it holds an unread value
+
+	T m_slots[3];
+	int m_write;
+	int m_read;
+	std::atomic<int> m_middle;
+
+public:
+	TripleBuffer() : m_write(0), m_read(1), m_middle(2) {}
+
+	T &write_slot() { return m_slots[m_write]; }
+
+	void publish() { m_write = m_middle.exchange(m_write | FRESH) & ~FRESH; }
+
+	// true if something newer than the current read_slot() was published
+	bool acquire()
+	{
+		if (!(m_middle.load() & FRESH))
+			return false;
+		m_read = m_middle.exchange(m_read) & ~FRESH;
+		return true;
+	}
+
+	const T &read_slot() const { return m_slots[m_read]; }
+};
+
+// bounded single producer / single consumer ring, push fails when full
+template <typename T, size_t N>
+class SpscQueue
+{
+	static_assert((N & (N - 1)) == 0, "SpscQueue capacity must be a power of two");
+
+private:
+	T m_items[N];
+	std::atomic<size_t> m_head; // next slot to pop, written by the consumer
+	std::atomic<size_t> m_tail; // next slot to push, written by the producer
+
+public:
+	SpscQueue() : m_head(0), m_tail(0) {}
+
+	bool push(const T &item)
+	{
+		size_t tail = m_tail.load(std::memory_order_relaxed);
+		if (tail - m_head.load(std::memory_order_acquire) == N)
+			return false;
+		m_items[tail & (N - 1)] = item;
+		m_tail.store(tail + 1, std::memory_order_release);
+		return true;
+	}
+
+	bool pop(T &out)
+	{
+		size_t head = m_head.load(std::memory_order_relaxed);
+		if (head == m_tail.load(std::memory_order_acquire))
+			return false;
+		out = m_items[head & (N - 1)];
+		m_head.store(head + 1, std::memory_order_release);
+		return true;
+	}
+};
+
+// bounded multi producer / single consumer ring, push fails when full
+// every slot carries a sequence number: producers claim the tail with a CAS and
+// publish the slot by bumping its sequence, the consumer only reads published slots
+template <typename T, size_t N>
+class MpscQueue
+{
+	static_assert((N & (N - 1)) == 0, "MpscQueue capacity must be a power of two");
+
+private:
+	struct slot
+	{
+		std::atomic<size_t> sequence; // index + 1 once filled, index + N once popped
+		T item;
+	};
+
+	slot m_slots[N];
+	std::atomic<size_t> m_tail; // next slot to push, claimed by the producers
+	size_t m_head; // next slot to pop, consumer only
+
+public:
+	MpscQueue() : m_tail(0), m_head(0)
+	{
+		for (size_t i = 0; i < N; i++)
+			m_slots[i].sequence.store(i, std::memory_order_relaxed);
+	}
+
+	bool push(const T &item)
+	{
+		size_t tail = m_tail.load(std::memory_order_relaxed);
+		for (;;)
+		{
+			slot &s = m_slots[tail & (N - 1)];
+			size_t sequence = s.sequence.load(std::memory_order_acquire);
+			if (sequence == tail)
+			{
+				if (m_tail.compare_exchange_weak(tail, tail + 1, std::memory_order_relaxed))
+				{
+					s.item = item;
+					s.sequence.store(tail + 1, std::memory_order_release);
+					return true;
+				}
+			}
+			else if (sequence < tail)
+				return false; // not popped yet, the ring is full
+			else
+				tail = m_tail.load(std::memory_order_relaxed);
+		}
+	}
+
+	bool pop(T &out)
+	{
+		slot &s = m_slots[m_head & (N - 1)];
+		if (s.sequence.load(std::memory_order_acquire) != m_head + 1)
+			return false;
+		out = s.item;
+		s.sequence.store(m_head + N, std::memory_order_release);
+		m_head++;
+		return true;
+	}
+};
@@ -5,58 +5,42 @@
 #include <algorithm>
 #include <cmath>
 
-Texture GameoverScreen::pointer;
-Texture GameoverScreen::game_over;
-Texture GameoverScreen::retry;
-Texture GameoverScreen::main_menu;
-Texture GameoverScreen::piere_gameover;
-
 bool GameoverScreen::init()
 {
 	// load shared texture
-	if (!pointer.is_valid())
+	pointer = TextureManager::load(textures_path("pointer.png"), "gameover_screen");
+	if (!pointer)
 	{
-		if (!pointer.load_from_file(textures_path("pointer.png")))
-		{
-			fprintf(stderr, "Failed to load pointer texture!");
-			return false;
-		}
+		fprintf(stderr, "Failed to load pointer texture!");
+		return false;
 	}
 
-	if (!game_over.is_valid())
+	game_over = TextureManager::load(textures_path("game_over.png"), "gameover_screen");
+	if (!game_over)
 	{
-		if (!game_over.load_from_file(textures_path("game_over.png")))
-		{
-			fprintf(stderr, "Failed to load game over texture!");
-			return false;
-		}
+		fprintf(stderr, "Failed to load game over texture!");
+		return false;
 	}
 
-	if (!retry.is_valid())
+	retry = TextureManager::load(textures_path("retry.png"), "gameover_screen");
+	if (!retry)
 	{
-		if (!retry.load_from_file(textures_path("retry.png")))
-		{
-			fprintf(stderr, "Failed to load retry texture!");
-			return false;
-		}
+		fprintf(stderr, "Failed to load retry texture!");
+		return false;
 	}
 
-    if (!main_menu.is_valid())
+	main_menu = TextureManager::load(textures_path("main_menu.png"), "gameover_screen");
+	if (!main_menu)
 	{
-		if (!main_menu.load_from_file(textures_path("main_menu.png")))
-		{
-			fprintf(stderr, "Failed to load main menu texture!");
-			return false;
-		}
+		fprintf(stderr, "Failed to load main menu texture!");
+		return false;
 	}
 
-	if (!piere_gameover.is_valid())
+	piere_gameover = TextureManager::load(textures_path("piere_gameover.png"), "gameover_screen");
+	if (!piere_gameover)
 	{
-		if (!piere_gameover.load_from_file(textures_path("piere_gameover.png")))
-		{
-			fprintf(stderr, "Failed to load piere game over texture!");
-			return false;
-		}
+		fprintf(stderr, "Failed to load piere game over texture!");
+		return false;
 	}
 
 	// the position corresponds to the center of the texture
@@ -126,29 +110,29 @@ void GameoverScreen::update(unsigned int state)
 void GameoverScreen::draw(const mat3 &proj)
 {
 	// pointer
-	vec2 pointer_scale = vec2({pointer.width / (8 * SCREEN_WIDTH), pointer.height / (8 * SCREEN_WIDTH)});
+	vec2 pointer_scale = vec2({pointer->width / (8 * SCREEN_WIDTH), pointer->height / (8 * SCREEN_WIDTH)});
 	//vec2 m_pointer_pos
-	draw_element(proj, pointer, pointer_pos, pointer_scale);
+	draw_element(proj, *pointer, pointer_pos, pointer_scale);
 
 	// game over
 	vec2 game_over_pos = vec2({SCREEN_WIDTH / 2.f, 1 * (SCREEN_HEIGHT / 4.f)});
-	vec2 game_over_scale = vec2({game_over.width * 1.5f / (2 * SCREEN_WIDTH), game_over.height * 1.5f / (2 * SCREEN_WIDTH)});
-	draw_element(proj, game_over, game_over_pos, game_over_scale);
+	vec2 game_over_scale = vec2({game_over->width * 1.5f / (2 * SCREEN_WIDTH), game_over->height * 1.5f / (2 * SCREEN_WIDTH)});
+	draw_element(proj, *game_over, game_over_pos, game_over_scale);
 
 	// piere game over
-	vec2 piere_gameover_scale = vec2({piere_gameover.width / (1.8f * SCREEN_WIDTH), piere_gameover.height / (1.8f * SCREEN_WIDTH)});
+	vec2 piere_gameover_scale = vec2({piere_gameover->width / (1.8f * SCREEN_WIDTH), piere_gameover->height / (1.8f * SCREEN_WIDTH)});
 	vec2 piere_gameover_pos = vec2({300.f, SCREEN_HEIGHT / 1.5f});
-	draw_element(proj, piere_gameover, piere_gameover_pos, piere_gameover_scale);
+	draw_element(proj, *piere_gameover, piere_gameover_pos, piere_gameover_scale);
 
 	// retry
 	vec2 retry_pos = vec2({850.f, 2 * (SCREEN_HEIGHT / 4.f)});
-	vec2 retry_scale = vec2({retry.width / (2 * SCREEN_WIDTH), retry.height / (2 * SCREEN_WIDTH)});
-	draw_element(proj, retry, retry_pos, retry_scale);
+	vec2 retry_scale = vec2({retry->width / (2 * SCREEN_WIDTH), retry->height / (2 * SCREEN_WIDTH)});
+	draw_element(proj, *retry, retry_pos, retry_scale);
 
     // main menu
 	vec2 main_menu_pos = vec2({850.f, 3 * (SCREEN_HEIGHT / 4.f)});
-	vec2 main_menu_scale = vec2({main_menu.width / (2 * SCREEN_WIDTH), main_menu.height / (2 * SCREEN_WIDTH)});
-	draw_element(proj, main_menu, main_menu_pos, main_menu_scale);
+	vec2 main_menu_scale = vec2({main_menu->width / (2 * SCREEN_WIDTH), main_menu->height / (2 * SCREEN_WIDTH)});
+	draw_element(proj, *main_menu, main_menu_pos, main_menu_scale);
 }
 
 void GameoverScreen::draw_element(const mat3& proj, const Texture& texture, vec2 pos, vec2 scale)
@@ -3,16 +3,17 @@
 // internal
 #include "common.hpp"
 #include "constants.hpp"
+#include "texture_manager.hpp"
 
 // gameover screen
 class GameoverScreen : public Entity
 {
 	// shared texture
-	static Texture pointer;
-	static Texture game_over;
-	static Texture retry;
-	static Texture main_menu;
-	static Texture piere_gameover;
+	TextureHandle pointer;
+	TextureHandle game_over;
+	TextureHandle retry;
+	TextureHandle main_menu;
+	TextureHandle piere_gameover;
 
 private:
 	vec2 pointer_pos;
@@ -0,0 +1,84 @@
+// header
+#include "geometry.hpp"
+
+// stlib
+#include <cmath>
+
+float dot(vec2 l, vec2 r)
+{
+	return l.x * r.x + l.y * r.y;
+}
+
+float dot(vec3 l, vec3 r)
+{
+	return l.x * r.x + l.y * r.y + l.z * r.z;
+}
+
+vec2 add(vec2 a, vec2 b) { return { a.x+b.x, a.y+b.y }; }
+vec2 sub(vec2 a, vec2 b) { return { a.x-b.x, a.y-b.y }; }
+vec2 mul(vec2 a, float b) { return { a.x*b, a.y*b }; }
+vec3 mul(mat3 m, vec3 v) { return {
+  dot(vec3{m.c0.x, m.c1.x, m.c2.x}, v),
+  dot(vec3{m.c0.y, m.c1.y, m.c2.y}, v),
+  dot(vec3{m.c0.z, m.c1.z, m.c2.z}, v)
+}; }
+float sq_len(vec2 a) { return dot(a, a); }
+float len(vec2 a) { return std::sqrt(sq_len(a)); }
+vec2 to_vec2(vec3 v) { return { v.x, v.y }; }
+
+mat3 mul(const mat3 & l, const mat3 & r)
+{
+	mat3 l_t = { { l.c0.x, l.c1.x, l.c2.x},
+	{ l.c0.y, l.c1.y, l.c2.y } ,
+	{ l.c0.z, l.c1.z, l.c2.z } };
+
+	mat3 ret;
+	ret.c0.x = dot(l_t.c0, r.c0);
+	ret.c0.y = dot(l_t.c1, r.c0);
+	ret.c0.z = dot(l_t.c2, r.c0);
+
+	ret.c1.x = dot(l_t.c0, r.c1);
+	ret.c1.y = dot(l_t.c1, r.c1);
+	ret.c1.z = dot(l_t.c2, r.c1);
+
+	ret.c2.x = dot(l_t.c0, r.c2);
+	ret.c2.y = dot(l_t.c1, r.c2);
+	ret.c2.z = dot(l_t.c2, r.c2);
+	return ret;
+}
+
+vec2 normalize(vec2 v)
+{
+	float m = sqrtf(dot(v, v));
+	return { v.x / m, v.y / m };
+}
+
+void Transform::begin()
+{
+	out = { { 1.f, 0.f, 0.f }, { 0.f, 1.f, 0.f}, { 0.f, 0.f, 1.f} };
+}
+
+void Transform::scale(vec2 scale)
+{
+	mat3 S = { { scale.x, 0.f, 0.f },{ 0.f, scale.y, 0.f },{ 0.f, 0.f, 1.f } };
+	out = mul(out, S);
+}
+
+void Transform::rotate(float radians)
+{
+	float c = cosf(radians);
+	float s = sinf(radians);
+	mat3 R = { { c, s, 0.f },{ -s, c, 0.f },{ 0.f, 0.f, 1.f } };
+	out = mul(out, R);
+}
+
+void Transform::translate(vec2 offset)
+{
+	mat3 T = { { 1.f, 0.f, 0.f },{ 0.f, 1.f, 0.f },{ offset.x, offset.y, 1.f } };
+	out = mul(out, T);
+}
+
+void Transform::end()
+{
+	//
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+// not much math is needed and there are already way too many libraries linked (:
+// If you want to do some overloads..
+struct vec2 { float x, y; };
+struct vec3 { float x, y, z; };
+struct mat3 { vec3 c0, c1, c2; };
+
+// utility functions
+float dot(vec2 l, vec2 r);
+float dot(vec3 l, vec3 r);
+mat3 mul(const mat3& l, const mat3& r);
+vec2 mul(vec2 a, float b);
+vec3 mul(mat3 m, vec3 v);
+vec2 normalize(vec2 v);
+vec2 add(vec2 a, vec2 b);
+vec2 sub(vec2 a, vec2 b);
+vec2 to_vec2(vec3 v);
+float sq_len(vec2 a);
+float len(vec2 a);
+
+// transformations passed to the Vertex shader, the gl Immediate mode equivalent, see the
+// Rendering and Transformations section in the specification pdf
+struct Transform {
+	mat3 out;
+
+	void begin();
+	void scale(vec2 scale);
+	void rotate(float radians);
+	void translate(vec2 offset);
+	void end();
+};
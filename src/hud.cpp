@@ -5,31 +5,24 @@
 #include <string>
 #include <iostream>
 
-Texture Hud::hud;
-Texture Hud::tooltip;
-
 using namespace std;
 
 bool Hud::init()
 {
 
   // load shared texture
-  if (!hud.is_valid())
+  hud = TextureManager::load(textures_path("hud.png"), "hud");
+  if (!hud)
   {
-    if (!hud.load_from_file(textures_path("hud.png")))
-    {
-      fprintf(stderr, "Failed to load hud texture!");
-      return false;
-    }
+    fprintf(stderr, "Failed to load hud texture!");
+    return false;
   }
 
-  if (!tooltip.is_valid())
+  tooltip = TextureManager::load(textures_path("tooltip_red.png"), "hud");
+  if (!tooltip)
   {
-    if (!tooltip.load_from_file(textures_path("tooltip_red.png")))
-    {
-      fprintf(stderr, "Failed to load tooltip texture!");
-      return false;
-    }
+    fprintf(stderr, "Failed to load tooltip texture!");
+    return false;
   }
 
 	// the position corresponds to the center of the texture
@@ -155,7 +148,7 @@ void Hud::draw(const mat3 &projection)
 
   // enable and binding texture to slot 0
   glActiveTexture(GL_TEXTURE0);
-  glBindTexture(GL_TEXTURE_2D, hud.id);
+  glBindTexture(GL_TEXTURE_2D, hud->id);
 
   // set uniform values to the currently bound program
   glUniformMatrix3fv(transform_uloc, 1, GL_FALSE, (float *)&transform.out);
@@ -218,7 +211,7 @@ void Hud::draw(const mat3 &projection)
 
   // enable and binding texture to slot 0
   glActiveTexture(GL_TEXTURE0);
-  glBindTexture(GL_TEXTURE_2D, tooltip.id);
+  glBindTexture(GL_TEXTURE_2D, tooltip->id);
 
   // set uniform values to the currently bound program
   glUniformMatrix3fv(transform_uloc, 1, GL_FALSE, (float *)&transform.out);
@@ -241,32 +234,28 @@ void Hud::set_tooltip(char color, bool value)
     show_red_tooltip = value;
     if (value)
     {
-      tooltip.~Texture();
-      tooltip.load_from_file(textures_path("tooltip_red.png"));
+      tooltip = TextureManager::load(textures_path("tooltip_red.png"), "hud");
     }
     break;
   case 'G':
     show_green_tooltip = value;
     if (value)
     {
-      tooltip.~Texture();
-      tooltip.load_from_file(textures_path("tooltip_green.png"));
+      tooltip = TextureManager::load(textures_path("tooltip_green.png"), "hud");
     }
     break;
   case 'B':
     show_blue_tooltip = value;
     if (value)
     {
-      tooltip.~Texture();
-      tooltip.load_from_file(textures_path("tooltip_blue.png"));
+      tooltip = TextureManager::load(textures_path("tooltip_blue.png"), "hud");
     }
     break;
   case 'Y':
     show_yellow_tooltip = value;
     if (value)
     {
-      tooltip.~Texture();
-      tooltip.load_from_file(textures_path("tooltip_yellow.png"));
+      tooltip = TextureManager::load(textures_path("tooltip_yellow.png"), "hud");
     }
     break;
   } */
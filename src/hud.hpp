@@ -3,13 +3,14 @@
 // internal
 #include "common.hpp"
 #include "constants.hpp"
+#include "texture_manager.hpp"
 
 // hud
 class Hud : public Entity
 {
 	// shared texture
-	static Texture hud;
-	static Texture tooltip;
+	TextureHandle hud;
+	TextureHandle tooltip;
 
 	vec2 red_tooltip_position;
 	vec2 blue_tooltip_position;
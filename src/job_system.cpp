@@ -0,0 +1,274 @@
+// header
+#include "job_system.hpp"
+
+// stlib
+#include <algorithm>
+#include <chrono>
+
+namespace
+{
+thread_local int t_thread_index = 0;
+
+float elapsed_ms(std::chrono::steady_clock::time_point start)
+{
+	return std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+} // namespace
+
+////////////////////
+// JOB SYSTEM
+////////////////////
+
+JobSystem::JobSystem() : m_running(false),
+						 m_queued(0)
+{
+	m_queues.emplace_back(new job_queue());
+}
+
+JobSystem::~JobSystem()
+{
+	destroy();
+}
+
+void JobSystem::init(int worker_count)
+{
+	destroy();
+
+	if (worker_count < 0)
+		worker_count = std::max(0, (int)std::thread::hardware_concurrency() - 1);
+
+	m_running = true;
+	for (int i = 0; i < worker_count; i++)
+		m_queues.emplace_back(new job_queue());
+	for (int i = 0; i < worker_count; i++)
+		m_threads.emplace_back(&JobSystem::worker_loop, this, i + 1);
+}
+
+void JobSystem::destroy()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_wake_mutex);
+		m_running = false;
+	}
+	m_wake.notify_all();
+	for (auto &thread : m_threads)
+		thread.join();
+	m_threads.clear();
+	m_queues.resize(1);
+}
+
+int JobSystem::get_thread_count() const
+{
+	return (int)m_threads.size() + 1;
+}
+
+int JobSystem::current_thread()
+{
+	return t_thread_index;
+}
+
+void JobSystem::submit(job j)
+{
+	if (m_threads.empty())
+	{
+		j();
+		return;
+	}
+
+	int thread = std::min(t_thread_index, (int)m_queues.size() - 1);
+	{
+		std::lock_guard<std::mutex> lock(m_queues[thread]->mutex);
+		m_queues[thread]->jobs.push_back(std::move(j));
+	}
+	{
+		// taken so a worker can't miss the count between its check and its wait
+		std::lock_guard<std::mutex> lock(m_wake_mutex);
+		m_queued++;
+	}
+	m_wake.notify_one();
+}
+
+bool JobSystem::run_one()
+{
+	job j;
+	if (!pop_or_steal(std::min(t_thread_index, (int)m_queues.size() - 1), j))
+		return false;
+	j();
+	return true;
+}
+
+// own queue from the back (most recent, still in cache), others from the front
+bool JobSystem::pop_or_steal(int thread, job &out)
+{
+	{
+		job_queue &own = *m_queues[thread];
+		std::lock_guard<std::mutex> lock(own.mutex);
+		if (!own.jobs.empty())
+		{
+			out = std::move(own.jobs.back());
+			own.jobs.pop_back();
+			m_queued--;
+			return true;
+		}
+	}
+
+	int count = (int)m_queues.size();
+	for (int i = 1; i < count; i++)
+	{
+		job_queue &victim = *m_queues[(thread + i) % count];
+		std::lock_guard<std::mutex> lock(victim.mutex);
+		if (!victim.jobs.empty())
+		{
+			out = std::move(victim.jobs.front());
+			victim.jobs.pop_front();
+			m_queued--;
+			return true;
+		}
+	}
+	return false;
+}
+
+void JobSystem::worker_loop(int thread)
+{
+	t_thread_index = thread;
+	while (true)
+	{
+		job j;
+		if (pop_or_steal(thread, j))
+		{
+			j();
+			continue;
+		}
+
+		std::unique_lock<std::mutex> lock(m_wake_mutex);
+		m_wake.wait(lock, [this] { return !m_running || m_queued > 0; });
+		if (!m_running)
+			return;
+	}
+}
+
+void JobSystem::parallel_for(int count, int grain, const std::function<void(int begin, int end)> &body)
+{
+	if (count <= 0)
+		return;
+	grain = std::max(1, grain);
+
+	// not worth waking anyone
+	if (m_threads.empty() || count <= grain)
+	{
+		body(0, count);
+		return;
+	}
+
+	int chunks = (count + grain - 1) / grain;
+	std::atomic<int> remaining(chunks);
+
+	// the calling thread takes the first chunk itself
+	for (int c = 1; c < chunks; c++)
+	{
+		int begin = c * grain;
+		int end = std::min(count, begin + grain);
+		submit([&body, &remaining, begin, end] {
+			body(begin, end);
+			remaining--;
+		});
+	}
+	body(0, std::min(count, grain));
+	remaining--;
+
+	while (remaining > 0)
+	{
+		if (!run_one())
+			std::this_thread::yield();
+	}
+}
+
+////////////////////
+// JOB GRAPH
+////////////////////
+
+int JobGraph::add(const char *name, std::function<void()> body, bool main_thread)
+{
+	m_nodes.push_back({name, std::move(body), main_thread, {}, 0});
+	return (int)m_nodes.size() - 1;
+}
+
+void JobGraph::depend(int job, int on)
+{
+	m_nodes[on].dependents.push_back(job);
+	m_nodes[job].dependency_count++;
+}
+
+void JobGraph::clear()
+{
+	m_nodes.clear();
+}
+
+void JobGraph::run(JobSystem &jobs)
+{
+	int count = (int)m_nodes.size();
+	m_timings.assign(count, {nullptr, 0.f, 0});
+
+	std::unique_ptr<std::atomic<int>[]> waiting(new std::atomic<int>[count]);
+	for (int i = 0; i < count; i++)
+		waiting[i] = m_nodes[i].dependency_count;
+
+	std::atomic<int> finished(0);
+	std::mutex main_mutex;
+	std::vector<int> main_ready;
+
+	// declared before the lambdas so start and execute can call each other
+	std::function<void(int)> start;
+	std::function<void(int)> execute = [&](int i) {
+		auto begin = std::chrono::steady_clock::now();
+		m_nodes[i].body();
+		m_timings[i] = {m_nodes[i].name, elapsed_ms(begin), JobSystem::current_thread()};
+
+		for (int dependent : m_nodes[i].dependents)
+		{
+			if (--waiting[dependent] == 0)
+				start(dependent);
+		}
+		finished++;
+	};
+	start = [&](int i) {
+		if (m_nodes[i].main_thread)
+		{
+			std::lock_guard<std::mutex> lock(main_mutex);
+			main_ready.push_back(i);
+		}
+		else
+		{
+			jobs.submit([&execute, i] { execute(i); });
+		}
+	};
+
+	for (int i = 0; i < count; i++)
+	{
+		if (m_nodes[i].dependency_count == 0)
+			start(i);
+	}
+
+	while (finished < count)
+	{
+		int next = -1;
+		{
+			std::lock_guard<std::mutex> lock(main_mutex);
+			if (!main_ready.empty())
+			{
+				next = main_ready.front();
+				main_ready.erase(main_ready.begin());
+			}
+		}
+
+		if (next >= 0)
+			execute(next);
+		else if (!jobs.run_one())
+			std::this_thread::yield();
+	}
+}
+
+const std::vector<job_timing> &JobGraph::get_timings() const
+{
+	return m_timings;
+}
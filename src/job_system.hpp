@@ -0,0 +1,98 @@
+#pragma once
+
+// stlib
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// wall time of one graph job, thread 0 is the thread that called run()
+struct job_timing
+{
+	const char *name;
+	float ms;
+	int thread;
+};
+
+// work-stealing thread pool. Every thread owns a deque: the owner pushes and pops
+// at the back, idle threads steal from the front of the others. Threads that wait
+// on work (parallel_for, JobGraph::run) keep executing jobs instead of blocking.
+class JobSystem
+{
+public:
+	typedef std::function<void()> job;
+
+private:
+	struct job_queue
+	{
+		std::mutex mutex;
+		std::deque<job> jobs;
+	};
+
+	std::vector<std::thread> m_threads;
+	std::vector<std::unique_ptr<job_queue>> m_queues; // index 0 belongs to the owning thread
+	std::atomic<bool> m_running;
+	std::atomic<int> m_queued;
+	std::mutex m_wake_mutex;
+	std::condition_variable m_wake;
+
+private:
+	void worker_loop(int thread);
+	bool pop_or_steal(int thread, job &out);
+
+public:
+	JobSystem();
+	~JobSystem();
+
+	// worker_count < 0 uses one worker per extra hardware thread, 0 runs everything inline
+	void init(int worker_count = -1);
+	void destroy();
+
+	// workers plus the owning thread
+	int get_thread_count() const;
+
+	// index of the calling thread in this pool, 0 for any thread that is not a worker
+	static int current_thread();
+
+	void submit(job j);
+
+	// runs one queued job on the calling thread, false if none was found
+	bool run_one();
+
+	// calls body on [begin, end) chunks of at most grain items, returns once all are done
+	void parallel_for(int count, int grain, const std::function<void(int begin, int end)> &body);
+};
+
+// jobs with dependencies, run() starts every job whose dependencies have finished.
+// main_thread jobs (GL calls) always run on the thread that called run().
+class JobGraph
+{
+private:
+	struct node
+	{
+		const char *name;
+		std::function<void()> body;
+		bool main_thread;
+		std::vector<int> dependents;
+		int dependency_count;
+	};
+
+	std::vector<node> m_nodes;
+	std::vector<job_timing> m_timings;
+
+public:
+	int add(const char *name, std::function<void()> body, bool main_thread = false);
+
+	// job waits until on has finished
+	void depend(int job, int on);
+
+	void clear();
+	void run(JobSystem &jobs);
+
+	// one entry per job of the last run, in add() order
+	const std::vector<job_timing> &get_timings() const;
+};
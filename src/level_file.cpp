@@ -0,0 +1,258 @@
+// header
+#include "level_file.hpp"
+#include "level_grid.hpp"
+
+// stlib
+#include <cstdio>
+#include <cstring>
+
+// sections are cast in place
+static_assert(sizeof(vec2) == 8, "vec2 is stored as two floats");
+static_assert(sizeof(level_patrol) == 8, "level_patrol is stored as two words");
+static_assert(sizeof(LevelFile::header) % 8 == 0, "sections after the header are 8 byte aligned");
+
+namespace
+{
+size_t align8(size_t bytes)
+{
+	return (bytes + 7) & ~size_t(7);
+}
+
+// first tile with the glyph, -1 when there is none
+void find_tile(const level_source &source, char glyph, int32_t &x, int32_t &y)
+{
+	x = y = -1;
+	for (int i = 0; i < source.width * source.height; i++)
+	{
+		if (source.tiles[i] == glyph)
+		{
+			x = i % source.width;
+			y = i / source.width;
+			return;
+		}
+	}
+}
+
+bool serialize(const level_source &source, std::vector<uint64_t> &image)
+{
+	if (source.width <= 0 || source.height <= 0 || (int)source.tiles.size() != source.width * source.height)
+	{
+		fprintf(stderr, "Level %d has no %dx%d tiles\n", source.level, source.width, source.height);
+		return false;
+	}
+
+	LevelFile::header h;
+	memset(&h, 0, sizeof(h));
+	h.magic = LevelFile::MAGIC;
+	h.version = LevelFile::VERSION;
+	h.level = source.level;
+	h.width = source.width;
+	h.height = source.height;
+	find_tile(source, 'A', h.spawn_x, h.spawn_y);
+	find_tile(source, 'Z', h.trophy_x, h.trophy_y);
+	h.spotter_count = (uint32_t)source.spotters.size();
+	h.shooter_count = (uint32_t)source.shooters.size();
+	h.patrol_count = (uint32_t)source.patrols.size();
+	for (const std::vector<vec2> &patrol : source.patrols)
+		h.point_count += (uint32_t)patrol.size();
+
+	size_t tiles = (size_t)source.width * source.height;
+	size_t offset = align8(sizeof(h));
+	auto place = [&](uint32_t &section, size_t bytes) {
+		section = (uint32_t)offset;
+		offset = align8(offset + bytes);
+	};
+	place(h.tiles_offset, tiles);
+	place(h.classes_offset, tiles);
+	place(h.spotters_offset, h.spotter_count * sizeof(vec2));
+	place(h.shooters_offset, h.shooter_count * sizeof(vec2));
+	place(h.patrols_offset, h.patrol_count * sizeof(level_patrol));
+	place(h.points_offset, h.point_count * sizeof(vec2));
+	h.size = (uint32_t)offset;
+
+	image.assign(offset / sizeof(uint64_t), 0);
+	unsigned char *bytes = reinterpret_cast<unsigned char *>(image.data());
+	memcpy(bytes, &h, sizeof(h));
+	memcpy(bytes + h.tiles_offset, source.tiles.data(), tiles);
+
+	unsigned char *classes = bytes + h.classes_offset;
+	for (size_t i = 0; i < tiles; i++)
+		classes[i] = (unsigned char)LevelGrid::get_tile_class(source.tiles[i]);
+
+	if (h.spotter_count > 0)
+		memcpy(bytes + h.spotters_offset, source.spotters.data(), h.spotter_count * sizeof(vec2));
+	if (h.shooter_count > 0)
+		memcpy(bytes + h.shooters_offset, source.shooters.data(), h.shooter_count * sizeof(vec2));
+
+	level_patrol *patrols = reinterpret_cast<level_patrol *>(bytes + h.patrols_offset);
+	vec2 *points = reinterpret_cast<vec2 *>(bytes + h.points_offset);
+	uint32_t first = 0;
+	for (size_t i = 0; i < source.patrols.size(); i++)
+	{
+		const std::vector<vec2> &patrol = source.patrols[i];
+		patrols[i] = {first, (uint32_t)patrol.size()};
+		for (vec2 point : patrol)
+			points[first++] = point;
+	}
+	return true;
+}
+} // namespace
+
+LevelFile::LevelFile() : m_data(nullptr),
+						 m_size(0)
+{
+}
+
+LevelFile::~LevelFile()
+{
+	close();
+}
+
+bool LevelFile::open(const char *path)
+{
+	close();
+	if (!m_file.open(path))
+		return false;
+
+	if (m_file.get_size() < sizeof(header))
+	{
+		fprintf(stderr, "Invalid level file %s: truncated\n", path);
+		close();
+		return false;
+	}
+
+	m_data = m_file.get_data();
+	m_size = m_file.get_size();
+	return validate(path);
+}
+
+bool LevelFile::build(const level_source &source)
+{
+	close();
+	if (!serialize(source, m_image))
+		return false;
+
+	m_data = reinterpret_cast<const unsigned char *>(m_image.data());
+	m_size = m_image.size() * sizeof(uint64_t);
+	return true;
+}
+
+void LevelFile::close()
+{
+	m_file.close();
+	m_image.clear();
+	m_data = nullptr;
+	m_size = 0;
+}
+
+bool LevelFile::write(const char *path, const level_source &source)
+{
+	std::vector<uint64_t> image;
+	if (!serialize(source, image))
+		return false;
+
+	FILE *file = fopen(path, "wb");
+	if (file == nullptr)
+	{
+		fprintf(stderr, "Failed to open %s\n", path);
+		return false;
+	}
+
+	bool ok = fwrite(image.data(), sizeof(uint64_t), image.size(), file) == image.size();
+	ok = fclose(file) == 0 && ok;
+	if (!ok)
+		fprintf(stderr, "Failed to write %s\n", path);
+	return ok;
+}
+
+// every offset and count is checked once here, the accessors trust them afterwards
+bool LevelFile::validate(const char *name)
+{
+	const header &h = get_header();
+	const char *error = nullptr;
+
+	auto fits = [&](uint32_t offset, uint64_t bytes) {
+		return offset % 8 == 0 && offset >= sizeof(header) && offset + bytes <= h.size;
+	};
+	uint64_t tiles = (uint64_t)h.width * (uint64_t)h.height;
+
+	if (h.magic != MAGIC)
+		error = "not a level file";
+	else if (h.version != VERSION)
+		error = "unsupported version";
+	else if (h.size > m_size)
+		error = "truncated";
+	else if (h.width <= 0 || h.height <= 0)
+		error = "empty level";
+	else if (!fits(h.tiles_offset, tiles) || !fits(h.classes_offset, tiles) ||
+			 !fits(h.spotters_offset, (uint64_t)h.spotter_count * sizeof(vec2)) ||
+			 !fits(h.shooters_offset, (uint64_t)h.shooter_count * sizeof(vec2)) ||
+			 !fits(h.patrols_offset, (uint64_t)h.patrol_count * sizeof(level_patrol)) ||
+			 !fits(h.points_offset, (uint64_t)h.point_count * sizeof(vec2)))
+		error = "section out of bounds";
+	else
+	{
+		for (const level_patrol &patrol : get_patrols())
+		{
+			if ((uint64_t)patrol.first + patrol.count > h.point_count)
+				error = "patrol out of bounds";
+		}
+
+		// TileMap builds its wall bits from the classes and set_tile reclassifies the glyph,
+		// a stale layer would give walls that disagree with both
+		const char *glyphs = get_tiles();
+		const unsigned char *classes = get_tile_classes();
+		for (uint64_t i = 0; i < tiles && error == nullptr; i++)
+		{
+			if (classes[i] != (unsigned char)LevelGrid::get_tile_class(glyphs[i]))
+				error = "tile class doesn't match its tile";
+		}
+	}
+
+	if (error == nullptr)
+		return true;
+
+	fprintf(stderr, "Invalid level file %s: %s\n", name, error);
+	close();
+	return false;
+}
+
+bool LevelFile::is_open() const
+{
+	return m_data != nullptr;
+}
+
+const LevelFile::header &LevelFile::get_header() const
+{
+	return *section<header>(0);
+}
+
+const char *LevelFile::get_tiles() const
+{
+	return section<char>(get_header().tiles_offset);
+}
+
+const unsigned char *LevelFile::get_tile_classes() const
+{
+	return section<unsigned char>(get_header().classes_offset);
+}
+
+level_span<vec2> LevelFile::get_spotters() const
+{
+	return {section<vec2>(get_header().spotters_offset), (int)get_header().spotter_count};
+}
+
+level_span<vec2> LevelFile::get_shooters() const
+{
+	return {section<vec2>(get_header().shooters_offset), (int)get_header().shooter_count};
+}
+
+level_span<level_patrol> LevelFile::get_patrols() const
+{
+	return {section<level_patrol>(get_header().patrols_offset), (int)get_header().patrol_count};
+}
+
+level_span<vec2> LevelFile::get_points() const
+{
+	return {section<vec2>(get_header().points_offset), (int)get_header().point_count};
+}
@@ -0,0 +1,119 @@
+#pragma once
+
+// internal
+#include "geometry.hpp"
+#include "mapped_file.hpp"
+
+// stlib
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// a level as authored, input of LevelFile::build and LevelFile::write
+struct level_source
+{
+	int level = -1;
+	int width = 0;
+	int height = 0;
+	std::vector<char> tiles;                // row major, width * height level characters
+	std::vector<vec2> spotters;             // pixels
+	std::vector<vec2> shooters;             // pixels
+	std::vector<std::vector<vec2>> patrols; // tiles, checkpoints per wanderer
+};
+
+// read-only run of elements inside a level file
+template <typename T>
+struct level_span
+{
+	const T *data;
+	int count;
+
+	const T *begin() const { return data; }
+	const T *end() const { return data + count; }
+};
+
+// patrol of a level file, its checkpoints are points[first, first + count)
+struct level_patrol
+{
+	uint32_t first;
+	uint32_t count;
+};
+
+// versioned binary level, memory mapped
+// guards are used in place, tiles and classes are copied into TileMap chunks once per
+// load, the chunks build their own wall bits
+//
+// little endian, sections 8 byte aligned in this order after the header:
+//   tiles     width * height level characters, row major
+//   classes   width * height LevelGrid tile classes, checked against the tiles on open
+//   spotters  vec2 in pixels
+//   shooters  vec2 in pixels
+//   patrols   level_patrol
+//   points    vec2 in tiles, the patrol checkpoints
+class LevelFile
+{
+public:
+	static constexpr uint32_t MAGIC = 0x4c564c43; // "CLVL"
+	static constexpr uint32_t VERSION = 2; // 1 had a row major walls section
+
+	struct header
+	{
+		uint32_t magic;
+		uint32_t version;
+		uint32_t size; // whole file in bytes
+		int32_t level;
+		int32_t width;
+		int32_t height;
+		int32_t spawn_x; // tiles, -1 when the level has none
+		int32_t spawn_y;
+		int32_t trophy_x;
+		int32_t trophy_y;
+		uint32_t spotter_count;
+		uint32_t shooter_count;
+		uint32_t patrol_count;
+		uint32_t point_count;
+		uint32_t tiles_offset;
+		uint32_t classes_offset;
+		uint32_t spotters_offset;
+		uint32_t shooters_offset;
+		uint32_t patrols_offset;
+		uint32_t points_offset;
+		uint32_t reserved[2];
+	};
+
+private:
+	const unsigned char *m_data;
+	size_t m_size;
+	MappedFile m_file;             // when opened from a file
+	std::vector<uint64_t> m_image; // the file image when built in memory
+
+private:
+	bool validate(const char *name);
+	template <typename T>
+	const T *section(uint32_t offset) const { return reinterpret_cast<const T *>(m_data + offset); }
+
+public:
+	LevelFile();
+	~LevelFile();
+	LevelFile(const LevelFile &) = delete;
+	LevelFile &operator=(const LevelFile &) = delete;
+
+	// maps a level file, false without a message when there is no such file
+	bool open(const char *path);
+	// same layout, built in memory
+	bool build(const level_source &source);
+	void close();
+
+	static bool write(const char *path, const level_source &source);
+
+	bool is_open() const;
+	const header &get_header() const;
+
+	const char *get_tiles() const;
+	const unsigned char *get_tile_classes() const;
+
+	level_span<vec2> get_spotters() const;
+	level_span<vec2> get_shooters() const;
+	level_span<level_patrol> get_patrols() const;
+	level_span<vec2> get_points() const;
+};
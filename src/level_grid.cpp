@@ -0,0 +1,295 @@
+// header
+#include "level_grid.hpp"
+#include "builtin_levels.hpp"
+#include "project_path.hpp"
+#include "scenario.hpp"
+
+// stlib
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+namespace
+{
+const char LEVELS_DIR[] = PROJECT_SOURCE_DIR "./data/levels/";
+
+// one lookup per level character instead of comparing against every wall glyph
+struct tile_class_table
+{
+	unsigned char classes[256];
+};
+
+constexpr tile_class_table make_tile_classes()
+{
+	tile_class_table table = {};
+	for (int i = 0; i < 256; i++)
+		table.classes[i] = (unsigned char)LevelGrid::classify((char)i);
+	return table;
+}
+
+// constant initialized, safe to use from other static initializers
+constexpr tile_class_table TILE_CLASSES = make_tile_classes();
+} // namespace
+
+LevelGrid::LevelGrid() : m_level(-1),
+						 m_current(nullptr),
+						 m_spawn({0.f, 0.f}),
+						 m_revision(0)
+{
+}
+
+bool LevelGrid::load(int level)
+{
+	auto it = m_levels.find(level);
+	if (it == m_levels.end())
+	{
+		char path[512];
+		snprintf(path, sizeof(path), "%s%d.lvl", LEVELS_DIR, level);
+
+		std::unique_ptr<loaded_level> loaded(new loaded_level());
+		if (!loaded->file.open(path))
+		{
+			level_source source;
+			if (!builtin_level(level, source) || !loaded->file.build(source))
+				return false;
+		}
+
+		const LevelFile::header &h = loaded->file.get_header();
+		loaded->tiles.assign(h.width, h.height, loaded->file.get_tiles(), loaded->file.get_tile_classes());
+		analyse(*loaded, level);
+		it = m_levels.emplace(level, std::move(loaded)).first;
+	}
+	return use(*it->second, level);
+}
+
+bool LevelGrid::load(const Scenario &scenario)
+{
+	level_source source;
+	source.level = LEVEL_SCENARIO;
+	source.width = scenario.get_width();
+	source.height = scenario.get_height();
+	source.tiles.reserve((size_t)source.width * source.height);
+	for (int y = 0; y < scenario.get_height(); y++)
+		for (int x = 0; x < scenario.get_width(); x++)
+			source.tiles.push_back(scenario.get_tile(x, y));
+
+	// scenarios place guards on tiles
+	for (vec2 tile : scenario.get_spotters())
+		source.spotters.push_back(get_tile_center_coords(tile));
+	for (vec2 tile : scenario.get_shooters())
+		source.shooters.push_back(get_tile_center_coords(tile));
+	source.patrols = scenario.get_patrols();
+
+	if (!m_built.file.build(source))
+		return false;
+	m_built.tiles.assign(source.width, source.height, m_built.file.get_tiles(), m_built.file.get_tile_classes());
+	analyse(m_built, LEVEL_SCENARIO);
+	return use(m_built, LEVEL_SCENARIO);
+}
+
+// the index and walls outlive level switches like the tiles, an unreachable trophy is
+// reported once so designers see it without playing the level
+void LevelGrid::analyse(loaded_level &loaded, int level)
+{
+	loaded.index.build(loaded.tiles);
+	loaded.index.find_unreachable(loaded.tiles);
+	loaded.walls.build(loaded.tiles);
+	const LevelIndex &index = loaded.index;
+
+	if (!index.has_spawn())
+	{
+		fprintf(stderr, "Level %d has no spawn\n", level);
+		return;
+	}
+	for (vec2 trophy : index.get_unreachable_trophies())
+		fprintf(stderr, "Level %d: trophy at %d %d can't be reached from the spawn\n", level, (int)trophy.x, (int)trophy.y);
+}
+
+bool LevelGrid::use(loaded_level &loaded, int level)
+{
+	m_level = level;
+	m_current = &loaded;
+	m_spawn = loaded.index.has_spawn() ? get_tile_center_coords(loaded.index.get_spawn_tile()) : vec2{0.f, 0.f};
+	m_revision++;
+	return true;
+}
+
+int LevelGrid::get_level() const
+{
+	return m_level;
+}
+
+unsigned int LevelGrid::get_revision() const
+{
+	return m_revision;
+}
+
+int LevelGrid::get_width() const
+{
+	return m_current->tiles.get_width();
+}
+
+int LevelGrid::get_height() const
+{
+	return m_current->tiles.get_height();
+}
+
+const TileMap &LevelGrid::get_tile_map() const
+{
+	return m_current->tiles;
+}
+
+const WallGeometry &LevelGrid::get_walls() const
+{
+	return m_current->walls;
+}
+
+// only what the edit touches is rebuilt, the load diagnostics aren't repeated
+bool LevelGrid::set_tile(int x, int y, char tile)
+{
+	char old_tile = get_tile(x, y);
+	bool was_wall = is_wall_tile(x, y);
+	if (!m_current->tiles.set_tile(x, y, tile))
+		return false;
+
+	// the index only holds the spawn and the trophies
+	if (old_tile == 'A' || tile == 'A' || get_tile_class(old_tile) == TILE_TROPHY || get_tile_class(tile) == TILE_TROPHY)
+	{
+		m_current->index.build(m_current->tiles);
+		m_spawn = m_current->index.has_spawn() ? get_tile_center_coords(m_current->index.get_spawn_tile()) : vec2{0.f, 0.f};
+	}
+	if (was_wall != is_wall_tile(x, y))
+	{
+		m_current->walls.update(m_current->tiles, x, y);
+		m_revision++;
+	}
+	return true;
+}
+
+vec2 LevelGrid::get_spawn_pos() const
+{
+	return m_spawn;
+}
+
+level_span<vec2> LevelGrid::get_spotters() const
+{
+	return m_current->file.get_spotters();
+}
+
+level_span<vec2> LevelGrid::get_shooters() const
+{
+	return m_current->file.get_shooters();
+}
+
+int LevelGrid::get_patrol_count() const
+{
+	return m_current->file.get_patrols().count;
+}
+
+std::vector<vec2> LevelGrid::get_patrol(int index) const
+{
+	const level_patrol &patrol = m_current->file.get_patrols().data[index];
+	const vec2 *points = m_current->file.get_points().data + patrol.first;
+	return std::vector<vec2>(points, points + patrol.count);
+}
+
+int LevelGrid::get_tile_type(vec2 pos) const
+{
+	vec2 tile = get_grid_coords(pos);
+	return m_current->tiles.get_tile_class((int)tile.x, (int)tile.y);
+}
+
+int LevelGrid::get_tile_class(char tile)
+{
+	return TILE_CLASSES.classes[(unsigned char)tile];
+}
+
+bool LevelGrid::is_wall_glyph(char tile)
+{
+	return TILE_CLASSES.classes[(unsigned char)tile] == TILE_WALL;
+}
+
+////////////////////
+// COLLISION GRID
+////////////////////
+
+bool LevelGrid::is_wall_tile(int x, int y) const
+{
+	return m_current->tiles.is_wall(x, y);
+}
+
+// inclusive span, x0 and x1 may come in any order
+bool LevelGrid::any_wall_in_row(int y, int x0, int x1) const
+{
+	return m_current->tiles.any_wall_in_row(y, x0, x1);
+}
+
+bool LevelGrid::any_wall_in_column(int x, int y0, int y1) const
+{
+	return m_current->tiles.any_wall_in_column(x, y0, y1);
+}
+
+// grid raycast (Amanatides & Woo), visits only the tiles the segment crosses
+bool LevelGrid::is_segment_blocked(vec2 from, vec2 to) const
+{
+	float x0 = from.x / TILE_SIZE;
+	float y0 = from.y / TILE_SIZE;
+	float x1 = to.x / TILE_SIZE;
+	float y1 = to.y / TILE_SIZE;
+
+	int tile_x = (int)std::floor(x0);
+	int tile_y = (int)std::floor(y0);
+	int end_x = (int)std::floor(x1);
+	int end_y = (int)std::floor(y1);
+
+	if (is_wall_tile(tile_x, tile_y))
+		return true;
+
+	float dx = x1 - x0;
+	float dy = y1 - y0;
+	int step_x = (dx > 0) ? 1 : ((dx < 0) ? -1 : 0);
+	int step_y = (dy > 0) ? 1 : ((dy < 0) ? -1 : 0);
+
+	// parametric distance along the segment to the next vertical / horizontal tile edge
+	float t_max_x = (step_x > 0) ? (tile_x + 1 - x0) / dx : ((step_x < 0) ? (x0 - tile_x) / -dx : INFINITY);
+	float t_max_y = (step_y > 0) ? (tile_y + 1 - y0) / dy : ((step_y < 0) ? (y0 - tile_y) / -dy : INFINITY);
+	float t_delta_x = (step_x != 0) ? 1.f / std::fabs(dx) : INFINITY;
+	float t_delta_y = (step_y != 0) ? 1.f / std::fabs(dy) : INFINITY;
+
+	// one tile boundary is crossed per step
+	int steps = std::abs(end_x - tile_x) + std::abs(end_y - tile_y);
+	for (int i = 0; i < steps; i++)
+	{
+		if (t_max_x < t_max_y)
+		{
+			tile_x += step_x;
+			t_max_x += t_delta_x;
+		}
+		else
+		{
+			tile_y += step_y;
+			t_max_y += t_delta_y;
+		}
+
+		if (is_wall_tile(tile_x, tile_y))
+			return true;
+	}
+
+	return false;
+}
+
+////////////////////
+// PATHING
+////////////////////
+
+vec2 LevelGrid::get_tile_center_coords(vec2 tile_indices)
+{
+	return vec2{(tile_indices.x * TILE_SIZE) + TILE_SIZE / 2, (tile_indices.y * TILE_SIZE) + TILE_SIZE / 2};
+}
+
+// floored, positions left of or above the level land on negative tiles the bounds checks reject
+vec2 LevelGrid::get_grid_coords(vec2 position)
+{
+	return vec2{std::floor(position.x / TILE_SIZE), std::floor(position.y / TILE_SIZE)};
+}
@@ -0,0 +1,152 @@
+#pragma once
+
+// internal
+#include "constants.hpp"
+#include "geometry.hpp"
+#include "level_file.hpp"
+#include "level_index.hpp"
+#include "tile_map.hpp"
+#include "wall_geometry.hpp"
+
+// stlib
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <vector>
+
+class Scenario;
+
+// tiles, collision grid and guard placements of the current level, read from a LevelFile
+// (data/levels/<level>.lvl, the built-in level when there is none), tiles are copied into a
+// chunked TileMap so levels can have any size
+// no GL, Map draws from it and the simulation queries it
+class LevelGrid
+{
+public:
+	// tile classes returned by get_tile_type
+	static constexpr int TILE_FLOOR = 0;
+	static constexpr int TILE_WALL = 1;
+	static constexpr int TILE_RED = 2;
+	static constexpr int TILE_GREEN = 3;
+	static constexpr int TILE_BLUE = 4;
+	static constexpr int TILE_YELLOW = 5;
+	static constexpr int TILE_CORRIDOR = 6;
+	static constexpr int TILE_TROPHY = 100;
+
+private:
+	struct loaded_level
+	{
+		LevelFile file; // guards are read in place
+		TileMap tiles;
+		LevelIndex index;
+		WallGeometry walls;
+	};
+
+	int m_level;
+	loaded_level *m_current;
+	vec2 m_spawn;
+	unsigned int m_revision;
+
+	// levels stay loaded, switching back is a pointer swap
+	std::map<int, std::unique_ptr<loaded_level>> m_levels;
+	loaded_level m_built; // the current scenario
+
+private:
+	void analyse(loaded_level &loaded, int level);
+	bool use(loaded_level &loaded, int level);
+
+public:
+	// queries are only valid after the first load
+	LevelGrid();
+
+	// LEVEL_TUTORIAL, LEVEL_1..LEVEL_5 or any level with a file, false if there is none
+	bool load(int level);
+
+	// a generated scenario as LEVEL_SCENARIO
+	bool load(const Scenario &scenario);
+	int get_level() const;
+
+	// changes on every load and every tile edit that adds or removes a wall,
+	// anything cached from the collision grid compares it
+	unsigned int get_revision() const;
+
+	// in tiles
+	int get_width() const;
+	int get_height() const;
+	const TileMap &get_tile_map() const;
+
+	// wall tiles merged into rectangles for swept collision, rebuilt with the index
+	const WallGeometry &get_walls() const;
+
+	// level character at a tile, TileMap::NO_TILE outside the level
+	char get_tile(int x, int y) const { return m_current->tiles.get_tile(x, y); }
+
+	// scripted or editor changes, update the index and walls around the tile, false outside the level
+	bool set_tile(int x, int y, char tile);
+
+	// center of the spawn tile in pixels, from the index
+	vec2 get_spawn_pos() const;
+
+	// tile class at a pixel position, floor outside the level
+	int get_tile_type(vec2 pos) const;
+	static int get_tile_class(char tile);
+	static bool is_wall_glyph(char tile);
+
+	// the tile class definition, constexpr so built-in levels are checked while compiling,
+	// get_tile_class answers the same from a table
+	static constexpr int classify(char tile)
+	{
+		switch (tile)
+		{
+		case '0':
+		case '1':
+		case '2':
+		case '3':
+		case '4':
+		case '5':
+		case '6':
+		case '7':
+		case '8':
+		case 'E':
+		case 'N':
+		case 'M':
+		case 'S':
+		case 'U':
+		case 'W':
+			return TILE_WALL;
+		case 'C':
+		case 'A':
+			return TILE_CORRIDOR;
+		case 'Z':
+			return TILE_TROPHY;
+		case 'R':
+			return TILE_RED;
+		case 'G':
+			return TILE_GREEN;
+		case 'B':
+			return TILE_BLUE;
+		case 'Y':
+			return TILE_YELLOW;
+		default:
+			return TILE_FLOOR;
+		}
+	}
+
+	// guards of the level, spotters and shooters in pixels, patrol checkpoints in tiles
+	level_span<vec2> get_spotters() const;
+	level_span<vec2> get_shooters() const;
+	int get_patrol_count() const;
+	std::vector<vec2> get_patrol(int index) const;
+
+	// collision grid queries, tiles outside the level are walls
+	bool is_wall_tile(int x, int y) const;
+	bool any_wall_in_row(int y, int x0, int x1) const;
+	bool any_wall_in_column(int x, int y0, int y1) const;
+
+	// line of sight between pixel positions, true if a wall tile lies on the segment
+	bool is_segment_blocked(vec2 from, vec2 to) const;
+
+	// tile <-> pixel
+	static vec2 get_tile_center_coords(vec2 tile_indices);
+	static vec2 get_grid_coords(vec2 position);
+};
@@ -0,0 +1,98 @@
+// header
+#include "level_index.hpp"
+#include "level_grid.hpp"
+
+namespace
+{
+const int STEP_X[4] = {1, -1, 0, 0};
+const int STEP_Y[4] = {0, 0, 1, -1};
+} // namespace
+
+LevelIndex::LevelIndex() : m_has_spawn(false),
+						   m_spawn({0.f, 0.f})
+{
+}
+
+// one pass over the tiles
+void LevelIndex::build(const TileMap &tiles)
+{
+	m_has_spawn = false;
+	m_spawn = {0.f, 0.f};
+	m_trophies.clear();
+
+	for (int y = 0; y < tiles.get_height(); y++)
+	{
+		for (int x = 0; x < tiles.get_width(); x++)
+		{
+			vec2 tile = {(float)x, (float)y};
+			if (!m_has_spawn && tiles.get_tile(x, y) == 'A')
+			{
+				m_has_spawn = true;
+				m_spawn = tile;
+			}
+
+			if (tiles.get_tile_class(x, y) == LevelGrid::TILE_TROPHY)
+				m_trophies.push_back(tile);
+		}
+	}
+}
+
+void LevelIndex::find_unreachable(const TileMap &tiles)
+{
+	m_unreachable_trophies.clear();
+	if (!m_has_spawn)
+	{
+		m_unreachable_trophies = m_trophies;
+		return;
+	}
+
+	int width = tiles.get_width();
+	std::vector<bool> reached((size_t)width * tiles.get_height(), false);
+	std::vector<int> stack = {(int)m_spawn.y * width + (int)m_spawn.x};
+	reached[stack[0]] = true;
+	while (!stack.empty())
+	{
+		int i = stack.back();
+		stack.pop_back();
+
+		for (int d = 0; d < 4; d++)
+		{
+			int nx = i % width + STEP_X[d];
+			int ny = i / width + STEP_Y[d];
+			if (tiles.is_wall(nx, ny))
+				continue;
+			int n = ny * width + nx;
+			if (!reached[n])
+			{
+				reached[n] = true;
+				stack.push_back(n);
+			}
+		}
+	}
+
+	for (vec2 trophy : m_trophies)
+	{
+		if (!reached[(int)trophy.y * width + (int)trophy.x])
+			m_unreachable_trophies.push_back(trophy);
+	}
+}
+
+bool LevelIndex::has_spawn() const
+{
+	return m_has_spawn;
+}
+
+vec2 LevelIndex::get_spawn_tile() const
+{
+	return m_spawn;
+}
+
+const std::vector<vec2> &LevelIndex::get_trophy_tiles() const
+{
+	return m_trophies;
+}
+
+const std::vector<vec2> &LevelIndex::get_unreachable_trophies() const
+{
+	return m_unreachable_trophies;
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+// internal
+#include "geometry.hpp"
+
+// stlib
+#include <vector>
+
+class TileMap;
+
+// what a level pass finds once at load time: the spawn, the trophies and which of them
+// can be walked to from the spawn, 4-connected over non-wall tiles
+// tile classes (stealth colors, trophy pickup) are O(1) lookups on the TileMap already,
+// so nothing per tile is kept
+class LevelIndex
+{
+	bool m_has_spawn;
+	vec2 m_spawn;
+	std::vector<vec2> m_trophies;
+	std::vector<vec2> m_unreachable_trophies;
+
+public:
+	LevelIndex();
+
+	// the spawn and the trophies
+	void build(const TileMap &tiles);
+
+	// flood fill from the spawn, only for the load diagnostics
+	void find_unreachable(const TileMap &tiles);
+
+	// first 'A' tile, row major
+	bool has_spawn() const;
+	vec2 get_spawn_tile() const;
+
+	const std::vector<vec2> &get_trophy_tiles() const;
+
+	// trophies no walk from the spawn reaches, all of them without a spawn, as of the
+	// last find_unreachable
+	const std::vector<vec2> &get_unreachable_trophies() const;
+};
@@ -3,18 +3,19 @@
 // internal
 #include "common.hpp"
 #include "constants.hpp"
+#include "texture_manager.hpp"
 
 // level screen
 class LevelScreen : public Entity
 {
 	// shared texture
-	static Texture pointer;
-	static Texture tutorial;
-	static Texture level_1;
-	static Texture level_2;
-	static Texture level_3;
-	static Texture level_4;
-	static Texture level_5;
+	TextureHandle pointer;
+	TextureHandle tutorial;
+	TextureHandle level_1;
+	TextureHandle level_2;
+	TextureHandle level_3;
+	TextureHandle level_4;
+	TextureHandle level_5;
 
 private:
 	vec2 m_pointer_pos;
@@ -1,24 +1,60 @@
 // internal
 #include "common.hpp"
+#include "frame_pacer.hpp"
 #include "world.hpp"
 
 #define GL3W_IMPLEMENTATION
 #include <gl3w.h>
 
 // stdlib
-#include <chrono>
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
 
-using Clock = std::chrono::high_resolution_clock;
-
 // global 
 World world;
 
-const float TICK = 40.f;
+// gameplay cooldowns count ticks, so the default rate keeps the original 40ms tick
+const float SIM_HZ = 25.f;
+
+// a longer stall is dropped instead of replayed
+const int MAX_CATCH_UP_STEPS = 5;
+
+// longest block on static screens, input and expose events wake the loop sooner
+const double IDLE_WAIT_S = 0.5;
 
 // entry point
+// --threaded      simulation on its own thread
+// --hz <rate>     simulation steps per second
+// --fps <cap>     cap frames with timed waits instead of vsync
+// --scenario <f>  play a generated scenario (chameleon_scenario_gen) instead of the menus
+// --texture-idle <s>  seconds an unused texture stays loaded
+// --texture-budget <MB>  unused textures kept loaded at most
 int main(int argc, char* argv[])
 {
+	bool threaded = false;
+	float sim_hz = SIM_HZ;
+	float fps_cap = 0.f;
+	const char *scenario_path = nullptr;
+	float texture_idle_s = TextureManager::DEFAULT_IDLE_SECONDS;
+	size_t texture_budget = TextureManager::DEFAULT_UNUSED_BUDGET;
+	for (int i = 1; i < argc; i++)
+	{
+		if (strcmp(argv[i], "--threaded") == 0)
+			threaded = true;
+		else if (strcmp(argv[i], "--hz") == 0 && i + 1 < argc)
+			sim_hz = std::max(1.f, (float)atof(argv[++i]));
+		else if (strcmp(argv[i], "--fps") == 0 && i + 1 < argc)
+			fps_cap = (float)atof(argv[++i]);
+		else if (strcmp(argv[i], "--scenario") == 0 && i + 1 < argc)
+			scenario_path = argv[++i];
+		else if (strcmp(argv[i], "--texture-idle") == 0 && i + 1 < argc)
+			texture_idle_s = std::max(0.f, (float)atof(argv[++i]));
+		else if (strcmp(argv[i], "--texture-budget") == 0 && i + 1 < argc)
+			texture_budget = (size_t)(std::max(0.0, atof(argv[++i])) * (1 << 20));
+	}
+
 	// initializing world (after renderer.init().. sorry)
 	if (!world.init())
 	{
@@ -28,42 +64,63 @@ int main(int argc, char* argv[])
 		return EXIT_FAILURE;
 	}
 
-	auto t = Clock::now();
+	FramePacer pacer;
+	pacer.init(sim_hz, fps_cap, MAX_CATCH_UP_STEPS);
+	world.set_vsync(fps_cap <= 0.f);
+	world.set_texture_idle_time(texture_idle_s);
+	world.set_texture_budget(texture_budget);
 
-	float avg_ms = 0.f;
-	float dt = 0.f;
-
-	// variable timestep loop
-	while (!world.is_over())
+	Scenario scenario;
+	if (scenario_path != nullptr && (!scenario.load(scenario_path) || !world.start_scenario(scenario)))
 	{
-		// processes system messages, if this wasn't present the window would become unresponsive
-		glfwPollEvents();
+		world.destroy();
+		return EXIT_FAILURE;
+	}
 
-		// calculating elapsed times in milliseconds from the previous iteration
-		auto now = Clock::now();
-		float ms = (float)(std::chrono::duration_cast<std::chrono::microseconds>(now - t)).count() / 1000;
+	// simulation on its own thread, this thread only renders
+	if (threaded)
+	{
+		world.start_simulation(pacer.get_step_ms());
+		while (!world.is_over())
+		{
+			// sleeps until input arrives or a tick is likely to be ready
+			glfwWaitEventsTimeout(pacer.get_step_ms() / 1000.0);
+			if (!world.render_frame())
+				break;
+		}
 
-		avg_ms = (avg_ms + ms) / 2;
-		//fprintf(stderr, "cur:%f, avg:%f\n", ms, avg_ms);
+		world.destroy();
+		return EXIT_SUCCESS;
+	}
 
-		if (ms < TICK)
+	// fixed timestep loop, rendering interpolates between the last two steps
+	while (!world.is_over())
+	{
+		// menus, pause and cutscenes: sleep until something happens and redraw only then
+		if (world.is_static_screen())
 		{
-			#if __APPLE__
-				usleep(TICK - ms);
-			#else
-   			Sleep(TICK - ms);
-			#endif
+			glfwWaitEventsTimeout(IDLE_WAIT_S);
+			if (world.needs_redraw())
+			{
+				world.update(pacer.get_step_ms());
+				world.draw();
+			}
+			pacer.resync();
+			continue;
 		}
 
-		t = now;
+		// processes system messages, if this wasn't present the window would become unresponsive
+		glfwPollEvents();
+
+		int steps = pacer.begin_frame();
+		for (int i = 0; i < steps; i++)
+			world.update(pacer.get_step_ms());
 
-		world.update(ms - dt);
-		world.draw();
-		
-		dt = 0.f;
+		world.draw(pacer.get_alpha());
+		pacer.end_frame();
 	}
 
 	world.destroy();
 
 	return EXIT_SUCCESS;
-}
\ No newline at end of file
+}
@@ -3,8 +3,11 @@
 // internal
 #include "common.hpp"
 #include "constants.hpp"
+#include "level_grid.hpp"
 #include "Spotter.hpp"
+#include "texture_manager.hpp"
 
+#include <array>
 #include <vector>
 
 #include "char.hpp"
@@ -13,88 +16,115 @@ class Spotter;
 
 class Map : public Entity
 {
-	// shared texture
-	static Texture wall_texture;
-	static Texture wall_light_texture;
-
-	static Texture corridor_texture;
-	static Texture corridor_texture_red;
-	static Texture corridor_texture_blue;
-	static Texture corridor_texture_green;
-	static Texture corridor_texture_yellow;
-
-	// Level Museum Texture
-	static Texture museum_bottom_left_corner_texture;
-	static Texture museum_bottom_right_corner_texture;
-	static Texture museum_top_left_corner_texture;
-	static Texture museum_top_right_corner_texture;
-	static Texture museum_top_wall_texture;
-	static Texture museum_bottom_wall_texture;
-	static Texture museum_left_wall_texture;
-	static Texture museum_right_wall_texture;
-	static Texture museum_two_walls_texture;
-	static Texture museum_wall_texture;
-	static Texture museum_top_u_texture;
-	static Texture museum_shadow_texture;
-	static Texture museum_corridor_tile_texture;
-	static Texture museum_corridor_tile_red_texture;
-	static Texture museum_corridor_tile_green_texture;
-	static Texture museum_corridor_tile_blue_texture;
-	static Texture museum_corridor_tile_yellow_texture;
-
-	// Level Ruins Textures	
-	static Texture ruins_bottom_left_corner_texture;
-	static Texture ruins_bottom_right_corner_texture;
-	static Texture ruins_top_left_corner_texture;
-	static Texture ruins_top_right_corner_texture;
-	static Texture ruins_top_wall_texture;
-	static Texture ruins_bottom_wall_texture;
-	static Texture ruins_left_wall_texture;
-	static Texture ruins_right_wall_texture;
-	static Texture ruins_two_walls_texture;
-	static Texture ruins_wall_texture;
-	static Texture ruins_top_u_texture;
-	static Texture ruins_end_cap_texture;
-	static Texture ruins_shadow_texture;
-
-	static Texture trophy_texture;
+public:
+	// a spotter's sight cone as the tiles shade it
+	struct spotter_sight
+	{
+		vec2 position;
+		vec2 direction;
+	};
+
+	// what draw reads of the tick, copied into the render snapshot, the tiles of a level
+	// stay loaded so the pointer outlives the level switching away
+	struct draw_state
+	{
+		const TileMap *tiles;
+		int flash;
+		float flash_time;
+		std::vector<spotter_sight> spotters;
+	};
+
+private:
+	// textures of one tile set by level character, empty for characters it doesn't draw
+	struct theme_textures
+	{
+		int theme = -1;
+		std::array<TextureHandle, 128> tiles;
+	};
+
+	// the current level's tile set and the one prefetched for the next level
+	theme_textures m_theme;
+	theme_textures m_next_theme;
 
 private:
+	// tiles of one chunk with their texture, rebuilt when the chunk's revision changes
+	struct tile_sprite
+	{
+		const Texture *texture;
+		vec2 position;
+	};
+	struct chunk_sprites
+	{
+		unsigned int revision = 0; // TileMap revisions start at 1
+		std::vector<tile_sprite> sprites;
+	};
+
 	vec2 translation_tile;
 	float m_dead_time;
 	float m_flash_time;
 	int flash_map;
-	char current_level[40][61];
 
-	int current_level_indicator;
+	// level tiles and collision grid
+	LevelGrid m_level;
+
+	// per chunk of m_drawn_tiles, row major
+	const TileMap *m_drawn_tiles = nullptr;
+	std::vector<chunk_sprites> m_chunk_sprites;
+
+	// pixels, only chunks overlapping it are drawn
+	vec2 m_view_min;
+	vec2 m_view_max;
 
 	//Spotters
-	std::vector<Spotter>* m_spotters;
+	std::vector<Spotter>* m_spotters = nullptr;
+
+private:
+	bool load_theme(int theme, theme_textures &out);
+	void build_chunk_sprites(const TileMap &tiles, int cx, int cy, chunk_sprites &out);
+	const Texture *get_tile_texture(char tile) const;
 
 public:
+	// tile classes returned by get_tile_type
+	static constexpr int TILE_FLOOR = LevelGrid::TILE_FLOOR;
+	static constexpr int TILE_WALL = LevelGrid::TILE_WALL;
+	static constexpr int TILE_RED = LevelGrid::TILE_RED;
+	static constexpr int TILE_GREEN = LevelGrid::TILE_GREEN;
+	static constexpr int TILE_BLUE = LevelGrid::TILE_BLUE;
+	static constexpr int TILE_YELLOW = LevelGrid::TILE_YELLOW;
+	static constexpr int TILE_CORRIDOR = LevelGrid::TILE_CORRIDOR;
+	static constexpr int TILE_TROPHY = LevelGrid::TILE_TROPHY;
+
 	bool init();
 	void destroy();
 
 	// draw tiles
+	void set_view(vec2 view_min, vec2 view_max);
 	void draw(const mat3 &projection) override;
-	void draw_level_tutorial(const mat3& projection);
-	void draw_level_1(const mat3& projection);
-	void draw_level_2(const mat3& projection);
-	void draw_level_3(const mat3& projection);
-	void draw_level_4(const mat3& projection);
-	void draw_level_5(const mat3& projection);
-	void draw_element(const mat3 &projection, const Texture &texture);
+	// GL thread, from the render snapshot
+	void draw(const mat3 &projection, const draw_state &state);
+	void draw_element(const mat3 &projection, const Texture &texture, const draw_state &state);
 
+	// keeps out's capacity, the snapshot is refilled every tick
+	void get_draw_state(draw_state &out) const;
+
+	// the level's tile set follows on the next sync_theme
 	void set_current_map(int level);
+	bool load_scenario(const Scenario &scenario);
 	int get_current_map();
 	vec2 get_spawn_pos() const;
+	const LevelGrid &get_level_grid() const;
+
+	// GL thread: swaps in the current level's tile set, the old one is released
+	void sync_theme();
+	// GL thread: loads a level's tile set in the background so sync_theme finds it ready
+	void prefetch_theme(int level);
 
 	// color detection
 	int get_tile_type(vec2 pos);
 
-	// wall collision
-	void check_wall(Char &ch, const float ms);
+	// line of sight, true if a wall tile lies on the segment
 	bool check_wall(vec2 spotter_pos, vec2 char_pos);
+	void check_wall(const std::vector<vec2> &from, const std::vector<vec2> &to, std::vector<bool> &blocked);
 
 	// char dead time getters and setters .. ported over from water
 	void set_char_dead();
@@ -113,6 +143,12 @@ public:
 	bool is_wall(vec2 grid_coords);
 
 	bool is_wall_texture(char tile);
+	bool is_sight_blocker(int x, int y);
+
+	// collision grid queries, tiles outside the level are walls
+	bool is_wall_tile(int x, int y) const;
+	bool any_wall_in_row(int y, int x0, int x1) const;
+	bool any_wall_in_column(int x, int y0, int y1) const;
 
 	void set_spotter_list(std::vector<Spotter>& spotters);
 };
\ No newline at end of file
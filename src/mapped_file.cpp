@@ -0,0 +1,114 @@
+// header
+#include "mapped_file.hpp"
+
+// stlib
+#include <cstdio>
+
+#if defined(_WIN32)
+#define NOMINMAX
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::MappedFile() : m_data(nullptr),
+						   m_size(0)
+{
+}
+
+MappedFile::~MappedFile()
+{
+	close();
+}
+
+bool MappedFile::open(const char *path)
+{
+	close();
+
+#if defined(_WIN32)
+	HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (file == INVALID_HANDLE_VALUE)
+	{
+		DWORD error = GetLastError();
+		if (error != ERROR_FILE_NOT_FOUND && error != ERROR_PATH_NOT_FOUND)
+			fprintf(stderr, "Failed to open %s\n", path);
+		return false;
+	}
+
+	LARGE_INTEGER size;
+	HANDLE mapping = nullptr;
+	if (GetFileSizeEx(file, &size) && size.QuadPart > 0)
+		mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	void *view = mapping != nullptr ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+
+	// the view keeps the file mapped
+	if (mapping != nullptr)
+		CloseHandle(mapping);
+	CloseHandle(file);
+	if (view == nullptr)
+	{
+		fprintf(stderr, "Failed to map %s\n", path);
+		return false;
+	}
+	m_size = (size_t)size.QuadPart;
+#else
+	int fd = ::open(path, O_RDONLY);
+	if (fd < 0)
+	{
+		if (errno != ENOENT)
+			fprintf(stderr, "Failed to open %s\n", path);
+		return false;
+	}
+
+	struct stat st;
+	void *view = MAP_FAILED;
+	if (fstat(fd, &st) == 0 && st.st_size > 0)
+		view = mmap(nullptr, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+	// the mapping keeps the file open
+	::close(fd);
+	if (view == MAP_FAILED)
+	{
+		fprintf(stderr, "Failed to map %s\n", path);
+		return false;
+	}
+	m_size = (size_t)st.st_size;
+#endif
+
+	m_data = static_cast<const unsigned char *>(view);
+	return true;
+}
+
+void MappedFile::close()
+{
+	if (m_data == nullptr)
+		return;
+
+#if defined(_WIN32)
+	UnmapViewOfFile((void *)m_data);
+#else
+	munmap((void *)m_data, m_size);
+#endif
+	m_data = nullptr;
+	m_size = 0;
+}
+
+bool MappedFile::is_open() const
+{
+	return m_data != nullptr;
+}
+
+const unsigned char *MappedFile::get_data() const
+{
+	return m_data;
+}
+
+size_t MappedFile::get_size() const
+{
+	return m_size;
+}
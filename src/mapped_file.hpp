@@ -0,0 +1,25 @@
+#pragma once
+
+// stlib
+#include <cstddef>
+
+// read-only memory mapping of a whole file
+class MappedFile
+{
+	const unsigned char *m_data;
+	size_t m_size;
+
+public:
+	MappedFile();
+	~MappedFile();
+	MappedFile(const MappedFile &) = delete;
+	MappedFile &operator=(const MappedFile &) = delete;
+
+	// false without a message when there is no such file, empty files can't be mapped
+	bool open(const char *path);
+	void close();
+
+	bool is_open() const;
+	const unsigned char *get_data() const;
+	size_t get_size() const;
+};
@@ -53,6 +53,10 @@ void Overlay::destroy()
 }
 
 void Overlay::draw(const mat3& projection) {
+	draw(projection, get_draw_state());
+}
+
+void Overlay::draw(const mat3& projection, const draw_state& state) {
 	// Enabling alpha channel for textures
 	glEnable(GL_BLEND); glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 	glEnable(GL_DEPTH_TEST);
@@ -75,9 +79,9 @@ void Overlay::draw(const mat3& projection) {
 
 	glUniform1i(screen_text_uloc, 0);
 	glUniform1f(time_uloc, (float)(glfwGetTime() * 10.0f));
-	glUniform1f(alert_mode_uloc, (m_alert_mode) ? 1.f : 0.f);
-	glUniform1f(oscillation_value_uloc, m_oscillation_value);
-	glUniform1i(cooldown_value_uloc, m_cooldown);
+	glUniform1f(alert_mode_uloc, (state.alert_mode) ? 1.f : 0.f);
+	glUniform1f(oscillation_value_uloc, state.oscillation_value);
+	glUniform1i(cooldown_value_uloc, state.cooldown);
 	glUniform1i(max_cooldown_value_uloc, m_max_cooldown);
 	glUniform1f(dead_timer_uloc, (m_dead_time > 0) ? (float)((glfwGetTime() - m_dead_time) * 10.0f) : -1);
 	glUniform1i(window_width_uloc, view_port[2]);
@@ -95,6 +99,11 @@ void Overlay::draw(const mat3& projection) {
 	glDisableVertexAttribArray(0);
 }
 
+Overlay::draw_state Overlay::get_draw_state() const
+{
+	return {m_alert_mode, m_oscillation_value, m_cooldown};
+}
+
 void Overlay::oscillation()
 {
 	if (m_oscillation_value > 0.8f) {
@@ -6,11 +6,22 @@
 class Overlay : public Entity
 {
 public:
+	// what draw reads of the tick, copied into the render snapshot
+	struct draw_state
+	{
+		bool alert_mode;
+		float oscillation_value;
+		int cooldown;
+	};
+
 	int view_port[4];
 
 	bool init(bool in_alert_mode, int max_cooldown);
 	void destroy();
 	void draw(const mat3& projection)override;
+	// GL thread, from the render snapshot
+	void draw(const mat3& projection, const draw_state& state);
+	draw_state get_draw_state() const;
 
 	void oscillation();
 
@@ -138,7 +138,21 @@ void Particles::spawn_particle(vec2 position, int dir)
 	set_fade(1);
 }
 
+void Particles::get_draw_state(draw_state &out) const
+{
+	out.particles.assign(m_particles.begin(), m_particles.end());
+	out.fade_particle = m_fade_particle;
+	out.fade_time = m_fade_time;
+}
+
 void Particles::draw(const mat3 &projection)
+{
+	draw_state state;
+	get_draw_state(state);
+	draw(projection, state);
+}
+
+void Particles::draw(const mat3 &projection, const draw_state &state)
 {
 	// set shaders
 	glUseProgram(effect.program);
@@ -160,8 +174,8 @@ void Particles::draw(const mat3 &projection)
 	float color[] = {0.4f, 0.4f, 0.4f};
 	glUniform3fv(color_uloc, 1, color);
 	glUniformMatrix3fv(projection_uloc, 1, GL_FALSE, (float *)&projection);
-	glUniform1iv(fade_particle_uloc, 1, &m_fade_particle);
-	glUniform1f(fade_timer_uloc, (m_fade_time > 0) ? (float)((glfwGetTime() - m_fade_time) * 20.0f) : -1);
+	glUniform1iv(fade_particle_uloc, 1, &state.fade_particle);
+	glUniform1f(fade_timer_uloc, (state.fade_time > 0) ? (float)((glfwGetTime() - state.fade_time) * 20.0f) : -1);
 
 	// draw the screen texture on the geometry
 	// set vertices
@@ -175,7 +189,7 @@ void Particles::draw(const mat3 &projection)
 
 	// load up particles into buffer
 	glBindBuffer(GL_ARRAY_BUFFER, m_instance_vbo);
-	glBufferData(GL_ARRAY_BUFFER, m_particles.size() * sizeof(Particle), m_particles.data(), GL_DYNAMIC_DRAW);
+	glBufferData(GL_ARRAY_BUFFER, state.particles.size() * sizeof(Particle), state.particles.data(), GL_DYNAMIC_DRAW);
 
 	// particle translations
 	// bind to attribute 1 (in_translate) as in vertex shader
@@ -190,7 +204,7 @@ void Particles::draw(const mat3 &projection)
 	glVertexAttribDivisor(2, 1);
 
 	// draw using instancing
-	glDrawArraysInstanced(GL_TRIANGLES, 0, NUM_SEGMENTS * 3, m_particles.size());
+	glDrawArraysInstanced(GL_TRIANGLES, 0, NUM_SEGMENTS * 3, state.particles.size());
 
 	// reset divisor
 	glVertexAttribDivisor(1, 0);
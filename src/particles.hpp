@@ -16,10 +16,23 @@ public:
 		float radius;
 	};
 
+	// what draw reads, copied into the render snapshot
+	struct draw_state
+	{
+		std::vector<Particle> particles;
+		int fade_particle;
+		float fade_time;
+	};
+
 	bool init();
 	void destroy();
 	void update(float ms);
 	void draw(const mat3 &projection) override;
+	// GL thread, from the render snapshot
+	void draw(const mat3 &projection, const draw_state &state);
+
+	// keeps out's capacity, the snapshot is refilled every tick
+	void get_draw_state(draw_state &out) const;
 
 	void spawn_particle(vec2 position, int direction);
 
@@ -5,68 +5,49 @@
 #include <algorithm>
 #include <cmath>
 
-Texture PauseScreen::pointer;
-Texture PauseScreen::game_paused;
-Texture PauseScreen::resume;
-Texture PauseScreen::restart;
-Texture PauseScreen::main_menu;
-Texture PauseScreen::quit;
-
 bool PauseScreen::init()
 {
 	// load shared texture
-	if (!pointer.is_valid())
+	pointer = TextureManager::load(textures_path("pointer.png"), "pause_screen");
+	if (!pointer)
 	{
-		if (!pointer.load_from_file(textures_path("pointer.png")))
-		{
-			fprintf(stderr, "Failed to load pointer texture!");
-			return false;
-		}
+		fprintf(stderr, "Failed to load pointer texture!");
+		return false;
 	}
 
-	if (!game_paused.is_valid())
+	game_paused = TextureManager::load(textures_path("game_paused.png"), "pause_screen");
+	if (!game_paused)
 	{
-		if (!game_paused.load_from_file(textures_path("game_paused.png")))
-		{
-			fprintf(stderr, "Failed to load game paused texture!");
-			return false;
-		}
+		fprintf(stderr, "Failed to load game paused texture!");
+		return false;
 	}
 
-	if (!main_menu.is_valid())
+	main_menu = TextureManager::load(textures_path("main_menu.png"), "pause_screen");
+	if (!main_menu)
 	{
-		if (!main_menu.load_from_file(textures_path("main_menu.png")))
-		{
-			fprintf(stderr, "Failed to load main menu texture!");
-			return false;
-		}
+		fprintf(stderr, "Failed to load main menu texture!");
+		return false;
 	}
 
-	if (!resume.is_valid())
+	resume = TextureManager::load(textures_path("resume.png"), "pause_screen");
+	if (!resume)
 	{
-		if (!resume.load_from_file(textures_path("resume.png")))
-		{
-			fprintf(stderr, "Failed to load resume texture!");
-			return false;
-		}
+		fprintf(stderr, "Failed to load resume texture!");
+		return false;
 	}
 
-	if (!restart.is_valid())
+	restart = TextureManager::load(textures_path("restart.png"), "pause_screen");
+	if (!restart)
 	{
-		if (!restart.load_from_file(textures_path("restart.png")))
-		{
-			fprintf(stderr, "Failed to load restart texture!");
-			return false;
-		}
+		fprintf(stderr, "Failed to load restart texture!");
+		return false;
 	}
 
-	if (!quit.is_valid())
+	quit = TextureManager::load(textures_path("quit.png"), "pause_screen");
+	if (!quit)
 	{
-		if (!quit.load_from_file(textures_path("quit.png")))
-		{
-			fprintf(stderr, "Failed to load quit texture!");
-			return false;
-		}
+		fprintf(stderr, "Failed to load quit texture!");
+		return false;
 	}
 
 	float wr = std::max(SCREEN_WIDTH, SCREEN_HEIGHT) * 0.5f;
@@ -141,34 +122,34 @@ void PauseScreen::update(unsigned int state)
 void PauseScreen::draw(const mat3 &projection)
 {
 	// pointer
-	vec2 pointer_scale = vec2({pointer.width / (8 * SCREEN_WIDTH), pointer.height / (8 * SCREEN_WIDTH)});
+	vec2 pointer_scale = vec2({pointer->width / (8 * SCREEN_WIDTH), pointer->height / (8 * SCREEN_WIDTH)});
 	//vec2 m_pointer_pos
-	draw_element(projection, pointer, pointer_pos, pointer_scale);
+	draw_element(projection, *pointer, pointer_pos, pointer_scale);
 
 	// game paused
 	vec2 game_paused_pos = vec2({SCREEN_WIDTH / 2.f, 1 * (SCREEN_HEIGHT / 6.f)});
-	vec2 game_paused_scale = vec2({game_paused.width / (2 * SCREEN_WIDTH), game_paused.height / (2 * SCREEN_WIDTH)});
-	draw_element(projection, game_paused, game_paused_pos, game_paused_scale);
+	vec2 game_paused_scale = vec2({game_paused->width / (2 * SCREEN_WIDTH), game_paused->height / (2 * SCREEN_WIDTH)});
+	draw_element(projection, *game_paused, game_paused_pos, game_paused_scale);
 
 	// resume
 	vec2 resume_pos = vec2({SCREEN_WIDTH / 2.f, 2 * (SCREEN_HEIGHT / 6.f)});
-	vec2 resume_scale = vec2({resume.width / (2 * SCREEN_WIDTH), resume.height / (2 * SCREEN_WIDTH)});
-	draw_element(projection, resume, resume_pos, resume_scale);
+	vec2 resume_scale = vec2({resume->width / (2 * SCREEN_WIDTH), resume->height / (2 * SCREEN_WIDTH)});
+	draw_element(projection, *resume, resume_pos, resume_scale);
 	
 	// restart
 	vec2 restart_pos = vec2({SCREEN_WIDTH / 2.f, 3 * (SCREEN_HEIGHT / 6.f)});
-	vec2 restart_scale = vec2({restart.width / (2 * SCREEN_WIDTH), restart.height / (2 * SCREEN_WIDTH)});
-	draw_element(projection, restart, restart_pos, restart_scale);
+	vec2 restart_scale = vec2({restart->width / (2 * SCREEN_WIDTH), restart->height / (2 * SCREEN_WIDTH)});
+	draw_element(projection, *restart, restart_pos, restart_scale);
 
 	// main menu
 	vec2 main_menu_pos = vec2({SCREEN_WIDTH / 2.f, 4 * (SCREEN_HEIGHT / 6.f)});
-	vec2 main_menu_scale = vec2({main_menu.width / (2 * SCREEN_WIDTH), main_menu.height / (2 * SCREEN_WIDTH)});
-	draw_element(projection, main_menu, main_menu_pos, main_menu_scale);
+	vec2 main_menu_scale = vec2({main_menu->width / (2 * SCREEN_WIDTH), main_menu->height / (2 * SCREEN_WIDTH)});
+	draw_element(projection, *main_menu, main_menu_pos, main_menu_scale);
 
 	// quit
 	vec2 quit_pos = vec2({SCREEN_WIDTH / 2.f, 5 * (SCREEN_HEIGHT / 6.f)});
-	vec2 quit_scale = vec2({quit.width / (2 * SCREEN_WIDTH), quit.height / (2 * SCREEN_WIDTH)});
-	draw_element(projection, quit, quit_pos, quit_scale);
+	vec2 quit_scale = vec2({quit->width / (2 * SCREEN_WIDTH), quit->height / (2 * SCREEN_WIDTH)});
+	draw_element(projection, *quit, quit_pos, quit_scale);
 }
 
 void PauseScreen::draw_element(const mat3& proj, const Texture& texture, vec2 pos, vec2 scale)
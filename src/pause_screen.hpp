@@ -3,17 +3,18 @@
 // internal
 #include "common.hpp"
 #include "constants.hpp"
+#include "texture_manager.hpp"
 
 // start screen
 class PauseScreen : public Entity
 {
 	// shared texture
-	static Texture pointer;
-	static Texture game_paused;
-	static Texture resume;
-	static Texture restart;
-	static Texture main_menu;
-	static Texture quit;
+	TextureHandle pointer;
+	TextureHandle game_paused;
+	TextureHandle resume;
+	TextureHandle restart;
+	TextureHandle main_menu;
+	TextureHandle quit;
 
 	vec2 pointer_pos;
 
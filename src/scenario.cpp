@@ -0,0 +1,354 @@
+// header
+#include "scenario.hpp"
+#include "level_grid.hpp"
+
+// stlib
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <random>
+
+namespace
+{
+// one room per cell of the generator grid, rooms never touch so walls stay between them
+const int CELL_SIZE = 20;
+const int MIN_ROOM_WIDTH = 6;
+const int MIN_ROOM_HEIGHT = 5;
+const int CORRIDOR_WIDTH = 3; // the char is wider than a tile
+
+// room floors, corridor floor weighted up like the shipped levels
+const char ROOM_FLOORS[] = {'C', 'C', 'R', 'G', 'B', 'Y'};
+
+const char FILE_MAGIC[] = "chameleon scenario 1";
+
+struct room
+{
+	int x0, y0, x1, y1; // inclusive
+
+	int center_x() const { return (x0 + x1) / 2; }
+	int center_y() const { return (y0 + y1) / 2; }
+};
+
+int random_int(std::mt19937 &rng, int min, int max)
+{
+	return std::uniform_int_distribution<int>(min, max)(rng);
+}
+
+// inside the room, not on its edge
+vec2 random_tile_in(const room &r, std::mt19937 &rng)
+{
+	return {(float)random_int(rng, r.x0 + 1, r.x1 - 1), (float)random_int(rng, r.y0 + 1, r.y1 - 1)};
+}
+
+bool read_position(FILE *file, int width, int height, vec2 &position)
+{
+	int x, y;
+	if (fscanf(file, "%d %d", &x, &y) != 2 || x < 0 || y < 0 || x >= width || y >= height)
+		return false;
+	position = {(float)x, (float)y};
+	return true;
+}
+} // namespace
+
+Scenario::Scenario() : m_width(0),
+					   m_height(0)
+{
+}
+
+////////////////////
+// GENERATION
+////////////////////
+
+bool Scenario::generate(const scenario_options &options)
+{
+	// room per cell, spawn and trophy need two
+	if (options.width <= 0 || options.height <= 0 || options.width > MAX_SIZE || options.height > MAX_SIZE)
+	{
+		fprintf(stderr, "Scenarios are at most %dx%d tiles\n", MAX_SIZE, MAX_SIZE);
+		return false;
+	}
+	if (options.guards < 0 || options.guards > MAX_GUARDS)
+	{
+		fprintf(stderr, "Scenarios have 0 to %d guards\n", MAX_GUARDS);
+		return false;
+	}
+
+	int cells_x = options.width / CELL_SIZE;
+	int cells_y = options.height / CELL_SIZE;
+	if (cells_x * cells_y < 2)
+	{
+		fprintf(stderr, "Scenarios are at least %dx%d tiles\n", 2 * CELL_SIZE, CELL_SIZE);
+		return false;
+	}
+
+	std::mt19937 rng(options.seed);
+	m_width = options.width;
+	m_height = options.height;
+	m_tiles.assign((size_t)m_width * m_height, 'S');
+	m_patrols.clear();
+	m_spotters.clear();
+	m_shooters.clear();
+
+	// rooms, row major over the cell grid
+	std::vector<room> rooms;
+	rooms.reserve(cells_x * cells_y);
+	for (int cy = 0; cy < cells_y; cy++)
+	{
+		for (int cx = 0; cx < cells_x; cx++)
+		{
+			int w = random_int(rng, MIN_ROOM_WIDTH, CELL_SIZE - 4);
+			int h = random_int(rng, MIN_ROOM_HEIGHT, CELL_SIZE - 4);
+			int x0 = cx * CELL_SIZE + random_int(rng, 2, CELL_SIZE - 2 - w);
+			int y0 = cy * CELL_SIZE + random_int(rng, 2, CELL_SIZE - 2 - h);
+			room r = {x0, y0, x0 + w - 1, y0 + h - 1};
+			carve(r.x0, r.y0, r.x1, r.y1, ROOM_FLOORS[random_int(rng, 0, sizeof(ROOM_FLOORS) - 1)]);
+			rooms.push_back(r);
+		}
+	}
+
+	// corridors: every room to its right neighbour, down links on the first column and
+	// half of the others, so the level is connected without being a plain lattice
+	int half = CORRIDOR_WIDTH / 2;
+	auto connect = [&](const room &a, const room &b) {
+		int ax = a.center_x(), ay = a.center_y();
+		int bx = b.center_x(), by = b.center_y();
+		carve(std::min(ax, bx) - half, ay - half, std::max(ax, bx) + half, ay + half, 'C');
+		carve(bx - half, std::min(ay, by) - half, bx + half, std::max(ay, by) + half, 'C');
+	};
+	for (int cy = 0; cy < cells_y; cy++)
+	{
+		for (int cx = 0; cx < cells_x; cx++)
+		{
+			const room &r = rooms[cy * cells_x + cx];
+			if (cx + 1 < cells_x)
+				connect(r, rooms[cy * cells_x + cx + 1]);
+			if (cy + 1 < cells_y && (cx == 0 || random_int(rng, 0, 1) == 0))
+				connect(r, rooms[(cy + 1) * cells_x + cx]);
+		}
+	}
+
+	// spawn in the first room, trophy in the last
+	const room &first = rooms.front();
+	const room &last = rooms.back();
+	m_tiles[index(first.center_x(), first.center_y())] = 'A';
+	m_tiles[index(last.center_x(), last.center_y())] = 'Z';
+
+	build_walls();
+
+	// guards stay out of the spawn room
+	int spotters = (int)std::lround(options.guards * SPOTTER_SHARE);
+	int shooters = (int)std::lround(options.guards * SHOOTER_SHARE);
+	int wanderers = options.guards - spotters - shooters;
+	auto random_room = [&]() -> int { return random_int(rng, 1, (int)rooms.size() - 1); };
+
+	for (int i = 0; i < spotters; i++)
+		m_spotters.push_back(random_tile_in(rooms[random_room()], rng));
+	for (int i = 0; i < shooters; i++)
+		m_shooters.push_back(random_tile_in(rooms[random_room()], rng));
+
+	// patrols visit the room and its neighbours, legs stay short on any map size
+	for (int i = 0; i < wanderers; i++)
+	{
+		int index = random_room();
+		int cx = index % cells_x;
+		int cy = index / cells_x;
+		std::vector<vec2> patrol;
+		int checkpoints = random_int(rng, 2, 4);
+		for (int c = 0; c < checkpoints; c++)
+		{
+			int nx = std::min(cells_x - 1, cx + (c % 2));
+			int ny = std::min(cells_y - 1, cy + (c / 2));
+			patrol.push_back(random_tile_in(rooms[ny * cells_x + nx], rng));
+		}
+		m_patrols.push_back(patrol);
+	}
+	return true;
+}
+
+void Scenario::carve(int x0, int y0, int x1, int y1, char tile)
+{
+	// the outermost ring stays solid
+	x0 = std::max(x0, 1);
+	y0 = std::max(y0, 1);
+	x1 = std::min(x1, m_width - 2);
+	y1 = std::min(y1, m_height - 2);
+	for (int y = y0; y <= y1; y++)
+		for (int x = x0; x <= x1; x++)
+			m_tiles[index(x, y)] = tile;
+}
+
+// solid tiles next to a floor become the lit wall face, the rest stay dark rock
+void Scenario::build_walls()
+{
+	for (int y = 0; y < m_height; y++)
+	{
+		for (int x = 0; x < m_width; x++)
+		{
+			if (m_tiles[index(x, y)] != 'S')
+				continue;
+
+			bool next_to_floor = false;
+			for (int dy = -1; dy <= 1 && !next_to_floor; dy++)
+			{
+				for (int dx = -1; dx <= 1 && !next_to_floor; dx++)
+				{
+					int nx = x + dx;
+					int ny = y + dy;
+					if (nx >= 0 && ny >= 0 && nx < m_width && ny < m_height)
+					{
+						char tile = m_tiles[index(nx, ny)];
+						next_to_floor = tile != 'S' && tile != 'W';
+					}
+				}
+			}
+			if (next_to_floor)
+				m_tiles[index(x, y)] = 'W';
+		}
+	}
+}
+
+////////////////////
+// FILE
+////////////////////
+
+bool Scenario::save(const char *path) const
+{
+	FILE *file = fopen(path, "w");
+	if (file == nullptr)
+	{
+		fprintf(stderr, "Failed to open %s\n", path);
+		return false;
+	}
+
+	fprintf(file, "%s\nsize %d %d\n", FILE_MAGIC, m_width, m_height);
+	for (int y = 0; y < m_height; y++)
+	{
+		fwrite(&m_tiles[index(0, y)], 1, m_width, file);
+		fputc('\n', file);
+	}
+	for (const std::vector<vec2> &patrol : m_patrols)
+	{
+		fprintf(file, "wanderer %d", (int)patrol.size());
+		for (vec2 checkpoint : patrol)
+			fprintf(file, " %d %d", (int)checkpoint.x, (int)checkpoint.y);
+		fputc('\n', file);
+	}
+	for (vec2 spotter : m_spotters)
+		fprintf(file, "spotter %d %d\n", (int)spotter.x, (int)spotter.y);
+	for (vec2 shooter : m_shooters)
+		fprintf(file, "shooter %d %d\n", (int)shooter.x, (int)shooter.y);
+
+	bool ok = ferror(file) == 0;
+	fclose(file);
+	if (!ok)
+		fprintf(stderr, "Failed to write %s\n", path);
+	return ok;
+}
+
+bool Scenario::load(const char *path)
+{
+	FILE *file = fopen(path, "r");
+	if (file == nullptr)
+	{
+		fprintf(stderr, "Failed to open %s\n", path);
+		return false;
+	}
+
+	auto fail = [&](const char *what) {
+		fprintf(stderr, "Invalid scenario %s: %s\n", path, what);
+		fclose(file);
+		return false;
+	};
+
+	char magic[sizeof(FILE_MAGIC)] = {};
+	if (fread(magic, 1, sizeof(FILE_MAGIC) - 1, file) != sizeof(FILE_MAGIC) - 1 || strcmp(magic, FILE_MAGIC) != 0)
+		return fail("not a scenario file");
+
+	int width, height;
+	if (fscanf(file, " size %d %d", &width, &height) != 2 || width <= 0 || height <= 0 || width > MAX_SIZE || height > MAX_SIZE)
+		return fail("bad size");
+
+	m_width = width;
+	m_height = height;
+	m_tiles.assign((size_t)m_width * m_height, 'S');
+	m_patrols.clear();
+	m_spotters.clear();
+	m_shooters.clear();
+
+	for (int y = 0; y < m_height; y++)
+	{
+		char *row = &m_tiles[index(0, y)];
+		if (fscanf(file, " ") == EOF || fread(row, 1, m_width, file) != (size_t)m_width)
+			return fail("missing tile rows");
+		if (std::any_of(row, row + m_width, [](char tile) { return tile == ' ' || tile == '\n' || tile == '\r'; }))
+			return fail("short tile row");
+	}
+
+	// guards have to stand on a floor
+	auto on_floor = [&](vec2 position) { return !LevelGrid::is_wall_glyph(get_tile((int)position.x, (int)position.y)); };
+
+	char kind[16];
+	while (fscanf(file, "%15s", kind) == 1)
+	{
+		if ((int)(m_patrols.size() + m_spotters.size() + m_shooters.size()) >= MAX_GUARDS)
+			return fail("too many guards");
+
+		vec2 position;
+		if (strcmp(kind, "wanderer") == 0)
+		{
+			int count;
+			if (fscanf(file, "%d", &count) != 1 || count < 2)
+				return fail("a patrol needs at least two checkpoints");
+			std::vector<vec2> patrol;
+			for (int i = 0; i < count; i++)
+			{
+				if (!read_position(file, m_width, m_height, position) || !on_floor(position))
+					return fail("bad checkpoint");
+				patrol.push_back(position);
+			}
+			m_patrols.push_back(patrol);
+		}
+		else if (strcmp(kind, "spotter") == 0 || strcmp(kind, "shooter") == 0)
+		{
+			if (!read_position(file, m_width, m_height, position) || !on_floor(position))
+				return fail("bad guard position");
+			if (strcmp(kind, "spotter") == 0)
+				m_spotters.push_back(position);
+			else
+				m_shooters.push_back(position);
+		}
+		else
+		{
+			return fail("unknown entry");
+		}
+	}
+
+	fclose(file);
+	return true;
+}
+
+int Scenario::get_width() const
+{
+	return m_width;
+}
+
+int Scenario::get_height() const
+{
+	return m_height;
+}
+
+const std::vector<std::vector<vec2>> &Scenario::get_patrols() const
+{
+	return m_patrols;
+}
+
+const std::vector<vec2> &Scenario::get_spotters() const
+{
+	return m_spotters;
+}
+
+const std::vector<vec2> &Scenario::get_shooters() const
+{
+	return m_shooters;
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+// internal
+#include "geometry.hpp"
+
+// stlib
+#include <cstddef>
+#include <vector>
+
+struct scenario_options
+{
+	int width = 256;      // tiles
+	int height = 256;     // tiles
+	int guards = 200;     // wanderers, spotters and shooters together
+	unsigned int seed = 1;
+};
+
+// generated stress level: room-and-corridor tiles in the map_level_* alphabet plus
+// guard placements, all positions in tile coordinates like the wanderer checkpoints
+//
+// text file, one tile row per line:
+//   chameleon scenario 1
+//   size <width> <height>
+//   <height rows of width tiles>
+//   wanderer <n> <x y> * n
+//   spotter <x y>
+//   shooter <x y>
+class Scenario
+{
+public:
+	// guard mix of a generated scenario
+	static constexpr float SPOTTER_SHARE = 0.15f;
+	static constexpr float SHOOTER_SHARE = 0.05f;
+
+	// limits of a generated or loaded scenario, a 4096x4096 level is already 16M tiles
+	static constexpr int MAX_SIZE = 4096;
+	static constexpr int MAX_GUARDS = 100000;
+
+private:
+	int m_width;
+	int m_height;
+	std::vector<char> m_tiles; // row major
+
+	std::vector<std::vector<vec2>> m_patrols; // checkpoints per wanderer, at least two
+	std::vector<vec2> m_spotters;
+	std::vector<vec2> m_shooters;
+
+private:
+	size_t index(int x, int y) const { return (size_t)y * m_width + x; }
+	void carve(int x0, int y0, int x1, int y1, char tile);
+	void build_walls();
+
+public:
+	Scenario();
+
+	// same options and seed, same scenario, false for sizes or guards past the limits
+	bool generate(const scenario_options &options);
+
+	// load applies the same limits, files past them are rejected
+	bool save(const char *path) const;
+	bool load(const char *path);
+
+	int get_width() const;
+	int get_height() const;
+
+	// level character at a tile, x and y must be inside the scenario
+	char get_tile(int x, int y) const { return m_tiles[index(x, y)]; }
+
+	const std::vector<std::vector<vec2>> &get_patrols() const;
+	const std::vector<vec2> &get_spotters() const;
+	const std::vector<vec2> &get_shooters() const;
+};
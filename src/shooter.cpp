@@ -6,24 +6,21 @@
 #include <iostream>
 
 // texture
-Texture Shooter::shooter_texture;
 using namespace std;
 
 bool Shooter::init()
 {
 	// load shared texture
-	if (!shooter_texture.is_valid())
+	shooter_texture = TextureManager::load(textures_path("survivor-idle_shotgun_0.png"), "shooter");
+	if (!shooter_texture)
 	{
-		if (!shooter_texture.load_from_file(textures_path("survivor-idle_shotgun_0.png")))
-		{
-			fprintf(stderr, "Failed to load Shooter texture!");
-			return false;
-		}
+		fprintf(stderr, "Failed to load Shooter texture!");
+		return false;
 	}
 
 	// the position corresponds to the center of the texture
-	float wr = shooter_texture.width * 0.5f;
-	float hr = shooter_texture.height * 0.5f;
+	float wr = shooter_texture->width * 0.5f;
+	float hr = shooter_texture->height * 0.5f;
 
 	TexturedVertex vertices[4];
 	vertices[0].position = { -wr, +hr, -0.0f };
@@ -85,12 +82,17 @@ void Shooter::update(float ms)
 }
 
 void Shooter::draw(const mat3 &projection)
+{
+	draw(projection, get_sprite_state());
+}
+
+void Shooter::draw(const mat3 &projection, const sprite_state &state)
 {
 	// transformation
 	transform.begin();
-	transform.translate(motion.position);
-	transform.rotate(motion.radians);
-	transform.scale(physics.scale);
+	transform.translate(state.position);
+	transform.rotate(state.radians);
+	transform.scale(state.scale);
 	transform.end();
 
 	// set shaders
@@ -123,7 +125,7 @@ void Shooter::draw(const mat3 &projection)
 
 	// enable and binding texture to slot 0
 	glActiveTexture(GL_TEXTURE0);
-	glBindTexture(GL_TEXTURE_2D, shooter_texture.id);
+	glBindTexture(GL_TEXTURE_2D, shooter_texture->id);
 
 	// set uniform values to the currently bound program
 	glUniformMatrix3fv(transform_uloc, 1, GL_FALSE, (float *)&transform.out);
@@ -171,5 +173,5 @@ bool Shooter::is_in_combat() const
 // collision
 vec2 Shooter::get_bounding_box() const
 {
-	return { std::fabs(physics.scale.x) * shooter_texture.width * 0.5f, std::fabs(physics.scale.y) * shooter_texture.height * 0.5f };
+	return { std::fabs(physics.scale.x) * shooter_texture->width * 0.5f, std::fabs(physics.scale.y) * shooter_texture->height * 0.5f };
 }
\ No newline at end of file
@@ -4,12 +4,13 @@
 #include "common.hpp"
 #include "char.hpp"
 #include "bullets.hpp"
+#include "texture_manager.hpp"
 
 // guard type 2 : spotter
 class Shooter : public Entity
 {
 	// shared texture
-	static Texture shooter_texture;
+	TextureHandle shooter_texture;
 
 private:
 	// config
@@ -26,6 +27,8 @@ public:
 	void destroy();
 	void update(float ms);
 	void draw(const mat3& projection) override;
+	// GL thread, from the render snapshot
+	void draw(const mat3& projection, const sprite_state& state);
 
 	// movement
 	void set_position(vec2 pos);
@@ -0,0 +1,145 @@
+// header
+#include "spatial_grid.hpp"
+
+// stlib
+#include <algorithm>
+#include <cmath>
+
+SpatialGrid::SpatialGrid() : m_width(MAP_WIDTH),
+							 m_height(MAP_HEIGHT),
+							 m_cells(MAP_WIDTH * MAP_HEIGHT),
+							 m_max_extent({0.f, 0.f}),
+							 m_count(0)
+{
+}
+
+void SpatialGrid::resize(int width, int height)
+{
+	if (width == m_width && height == m_height)
+		return;
+
+	clear();
+	m_width = width;
+	m_height = height;
+	m_cells.clear();
+	m_cells.resize((size_t)width * height);
+}
+
+// only touches the cells filled since the last clear
+void SpatialGrid::clear()
+{
+	for (int cell : m_used_cells)
+		m_cells[cell].clear();
+	m_used_cells.clear();
+	m_max_extent = {0.f, 0.f};
+	m_count = 0;
+}
+
+// drops one entry type, used to reinsert bullets after they moved
+// cells left empty leave the used list, insert adds them back when they refill
+void SpatialGrid::clear(int type)
+{
+	size_t used = 0;
+	for (int cell : m_used_cells)
+	{
+		std::vector<grid_entry> &entries = m_cells[cell];
+		size_t before = entries.size();
+		entries.erase(std::remove_if(entries.begin(), entries.end(), [type](const grid_entry &e) { return e.type == type; }), entries.end());
+		m_count -= (int)(before - entries.size());
+		if (!entries.empty())
+			m_used_cells[used++] = cell;
+	}
+	m_used_cells.resize(used);
+}
+
+void SpatialGrid::insert(int type, int index, int sub, vec2 position, vec2 half_extent)
+{
+	int cell = cell_y(position.y) * m_width + cell_x(position.x);
+	if (m_cells[cell].empty())
+		m_used_cells.push_back(cell);
+
+	m_cells[cell].push_back({type, index, sub, position, half_extent});
+	m_max_extent.x = std::max(m_max_extent.x, half_extent.x);
+	m_max_extent.y = std::max(m_max_extent.y, half_extent.y);
+	m_count++;
+}
+
+void SpatialGrid::query_aabb(vec2 center, vec2 half_extent, int type_mask, std::vector<grid_entry> &out) const
+{
+	out.clear();
+	vec2 min = {center.x - half_extent.x, center.y - half_extent.y};
+	vec2 max = {center.x + half_extent.x, center.y + half_extent.y};
+
+	gather(min, max, type_mask, m_candidates);
+	for (const grid_entry &e : m_candidates)
+	{
+		if (e.position.x + e.half_extent.x >= min.x && e.position.x - e.half_extent.x <= max.x &&
+			e.position.y + e.half_extent.y >= min.y && e.position.y - e.half_extent.y <= max.y)
+			out.push_back(e);
+	}
+	sort(out);
+}
+
+void SpatialGrid::query_radius(vec2 center, float radius, int type_mask, std::vector<grid_entry> &out) const
+{
+	out.clear();
+	vec2 min = {center.x - radius, center.y - radius};
+	vec2 max = {center.x + radius, center.y + radius};
+
+	gather(min, max, type_mask, m_candidates);
+	for (const grid_entry &e : m_candidates)
+	{
+		if (sq_len(sub(e.position, center)) < radius * radius)
+			out.push_back(e);
+	}
+	sort(out);
+}
+
+int SpatialGrid::size() const
+{
+	return m_count;
+}
+
+// out of level positions are clamped into the border cells, queries clamp the same way
+int SpatialGrid::cell_x(float x) const
+{
+	return std::min(std::max((int)std::floor(x / TILE_SIZE), 0), m_width - 1);
+}
+
+int SpatialGrid::cell_y(float y) const
+{
+	return std::min(std::max((int)std::floor(y / TILE_SIZE), 0), m_height - 1);
+}
+
+// callers rely on vector order for "first hit wins" loops
+void SpatialGrid::sort(std::vector<grid_entry> &out) const
+{
+	std::sort(out.begin(), out.end(), [](const grid_entry &l, const grid_entry &r) {
+		if (l.type != r.type)
+			return l.type < r.type;
+		if (l.index != r.index)
+			return l.index < r.index;
+		return l.sub < r.sub;
+	});
+}
+
+void SpatialGrid::gather(vec2 min, vec2 max, int type_mask, std::vector<grid_entry> &out) const
+{
+	out.clear();
+	int x0 = cell_x(min.x - m_max_extent.x);
+	int y0 = cell_y(min.y - m_max_extent.y);
+	int x1 = cell_x(max.x + m_max_extent.x);
+	int y1 = cell_y(max.y + m_max_extent.y);
+
+	for (int y = y0; y <= y1; y++)
+	{
+		for (int x = x0; x <= x1; x++)
+		{
+			for (const grid_entry &e : m_cells[y * m_width + x])
+			{
+				if (type_mask & (1 << e.type))
+					out.push_back(e);
+			}
+		}
+	}
+}
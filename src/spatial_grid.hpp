@@ -0,0 +1,68 @@
+#pragma once
+
+// internal
+#include "constants.hpp"
+#include "geometry.hpp"
+
+// stlib
+#include <vector>
+
+// broadphase entry, sub is used for bullets (index into the shooter's bullets)
+struct grid_entry
+{
+	int type;
+	int index;
+	int sub;
+	vec2 position;
+	vec2 half_extent;
+};
+
+// uniform grid keyed by level tile, rebuilt every tick
+// entries live in the tile of their center, queries grow by the largest extent inserted
+class SpatialGrid
+{
+public:
+	static constexpr int WANDERER = 0;
+	static constexpr int SPOTTER = 1;
+	static constexpr int SHOOTER = 2;
+	static constexpr int BULLET = 3;
+
+	static constexpr int MASK_GUARDS = (1 << WANDERER) | (1 << SPOTTER) | (1 << SHOOTER);
+	static constexpr int MASK_ALL = MASK_GUARDS | (1 << BULLET);
+
+private:
+	int m_width;
+	int m_height;
+	std::vector<std::vector<grid_entry>> m_cells;
+	std::vector<int> m_used_cells; // each non-empty cell once
+	vec2 m_max_extent;
+	int m_count;
+
+	// gather output reused by every query, queries come from one thread at a time
+	mutable std::vector<grid_entry> m_candidates;
+
+private:
+	int cell_x(float x) const;
+	int cell_y(float y) const;
+	void gather(vec2 min, vec2 max, int type_mask, std::vector<grid_entry> &out) const;
+	void sort(std::vector<grid_entry> &out) const;
+
+public:
+	SpatialGrid();
+
+	// one cell per level tile, drops every entry when the size changes
+	void resize(int width, int height);
+
+	void clear();
+	void clear(int type);
+	void insert(int type, int index, int sub, vec2 position, vec2 half_extent);
+
+	// results are sorted by type, index and sub
+	// entries whose box overlaps the query box (inclusive)
+	void query_aabb(vec2 center, vec2 half_extent, int type_mask, std::vector<grid_entry> &out) const;
+
+	// entries whose center lies strictly within radius
+	void query_radius(vec2 center, float radius, int type_mask, std::vector<grid_entry> &out) const;
+
+	int size() const;
+};
@@ -1,36 +1,49 @@
 // header
 #include "spotter.hpp"
 
+#include <algorithm>
 #include <cmath>
 #include <string> 
 #include <iostream>
 
 // texture
-Texture Spotter::spotter_texture;
 using namespace std;
 
-const float FOV_RADIANS = 0.39269908169;
-
 bool Spotter::init()
 {
 	// load shared texture
-	if (!spotter_texture.is_valid())
+	spotter_texture = TextureManager::load(textures_path("spotters/spotter.png"), "spotter");
+	if (!spotter_texture)
 	{
-		if (!spotter_texture.load_from_file(textures_path("spotters/spotter.png")))
-		{
-			fprintf(stderr, "Failed to load spotter texture!");
-			return false;
-		}
+		fprintf(stderr, "Failed to load spotter texture!");
+		return false;
 	}
+	m_sheet_size = { (float)spotter_texture->width, (float)spotter_texture->height };
+
+	SpotterSim::init();
+	if (!build_mesh(frameIndex_x, frameIndex_y))
+		return false;
+
+	// load shaders
+	if (!effect.load_from_file(shader_path("textured.vs.glsl"), shader_path("textured.fs.glsl")))
+		return false;
+
+	return true;
+}
+
+// quad for the current sprite frame
+bool Spotter::build_mesh(int frame_x, int frame_y)
+{
+	m_mesh_frame_x = frame_x;
+	m_mesh_frame_y = frame_y;
 
-	direction = vec2({ 0.f, -1.f });
 	// sprite sheet calculations
-	const float tw = spriteWidth / spotter_texture.width;
-	const float th = spriteHeight / spotter_texture.height;
-	const int numPerRow = spotter_texture.width / spriteWidth;
-	const int numPerCol = spotter_texture.height / spriteHeight;
-	const float tx = (frameIndex_x % numPerRow - 1) * tw;
-	const float ty = (frameIndex_y / numPerCol) * th;
+	const float tw = spriteWidth / spotter_texture->width;
+	const float th = spriteHeight / spotter_texture->height;
+	const int numPerRow = spotter_texture->width / spriteWidth;
+	const int numPerCol = spotter_texture->height / spriteHeight;
+	const float tx = (frame_x % numPerRow - 1) * tw;
+	const float ty = (frame_y / numPerCol) * th;
 
 	float posX = 0.f;
 	float posY = -35.f;
@@ -63,19 +76,7 @@ bool Spotter::init()
 
 	// vertex array (container for vertex + index buffer)
 	glGenVertexArrays(1, &mesh.vao);
-	if (gl_has_errors())
-		return false;
-
-	// load shaders
-	if (!effect.load_from_file(shader_path("textured.vs.glsl"), shader_path("textured.fs.glsl")))
-		return false;
-
-	motion.radians = 0.f;
-	motion.speed = 0.f;
-
-	physics.scale = { config_scale, config_scale };
-
-	return true;
+	return !gl_has_errors();
 }
 
 // release all graphics resources
@@ -88,42 +89,21 @@ void Spotter::destroy()
 	effect.release();
 }
 
-void Spotter::update(float ms)
+void Spotter::draw(const mat3 &projection)
 {
-	if (spotter_sprite_countdown > 0.f)
-		spotter_sprite_countdown -= ms;
-
-	vec2 directions[3] = { {0.f, -1.f}, {1.f, 0.f}, {-1.f, 0.f} };
-	// sprite change
-	if (spotter_sprite_countdown < 0) {
-
-		spotter_sprite_switch >= 3 ? spotter_sprite_switch = 1 : spotter_sprite_switch++;
-
-		if (frameIndex_x == 1) {
-			frameIndex_x = 2;
-		}
-		else if (frameIndex_x == 2) {
-			frameIndex_x = 7;
-			frameIndex_y = 0;
-		}
-		else if (frameIndex_x == 7) {
-			frameIndex_x = 1;
-			frameIndex_y = 1;
-		}
-
-		init();
-		direction = directions[spotter_sprite_switch - 1];
-		spotter_sprite_countdown = 1500.f;
-	}
+	draw(projection, get_sprite_state());
 }
 
-void Spotter::draw(const mat3 &projection)
+void Spotter::draw(const mat3 &projection, const sprite_state &state)
 {
+	if (state.frame_x != m_mesh_frame_x || state.frame_y != m_mesh_frame_y)
+		build_mesh(state.frame_x, state.frame_y);
+
 	// transformation
 	transform.begin();
-	transform.translate(motion.position);
-	transform.rotate(motion.radians);
-	transform.scale(physics.scale);
+	transform.translate(state.position);
+	transform.rotate(state.radians);
+	transform.scale(state.scale);
 	transform.end();
 
 	// set shaders
@@ -156,7 +136,7 @@ void Spotter::draw(const mat3 &projection)
 
 	// enable and binding texture to slot 0
 	glActiveTexture(GL_TEXTURE0);
-	glBindTexture(GL_TEXTURE_2D, spotter_texture.id);
+	glBindTexture(GL_TEXTURE_2D, spotter_texture->id);
 
 	// set uniform values to the currently bound program
 	glUniformMatrix3fv(transform_uloc, 1, GL_FALSE, (float *)&transform.out);
@@ -167,62 +147,3 @@ void Spotter::draw(const mat3 &projection)
 	// draw
 	glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_SHORT, nullptr);
 }
-
-// movement
-void Spotter::set_position(vec2 position)
-{
-	motion.position = position;
-}
-
-vec2 Spotter::get_position() const
-{
-	return motion.position;
-}
-
-// collision
-vec2 Spotter::get_bounding_box() const
-{
-	// adjusted to fit sprite sheet changes
-	return { std::fabs(physics.scale.x) * spotter_texture.width * 0.5f * 0.00125f, std::fabs(physics.scale.y) * spotter_texture.height * 0.5f * 0.0014285714285f };
-}
-
-// detection
-// TODO
-bool Spotter::is_in_sight(Char &m_char, Map& m)
-{
-	vec2 char_pos = m_char.get_position();
-	vec2 char_vector = vec2{ char_pos.x - motion.position.x, char_pos.y - motion.position.y };
-
-	float dot_product = dot(char_vector, vec2{ -direction.x, -direction.y});
-	float magnitude_char = sqrt(pow(char_vector.x, 2) + pow(char_vector.y, 2));
-
-	float angle = acos(dot_product / (magnitude_char));
-
-	bool in_fov = angle <= FOV_RADIANS;
-
-	bool is_wall = true;
-	if (magnitude_char <= radius && in_fov && !m_char.is_stealthed()) {
-		is_wall = m.check_wall(motion.position, m_char.get_position());
-	}
-
-	return (magnitude_char <= radius && in_fov && !(is_wall));
-}
-
-// alert
-void Spotter::set_alert_mode(bool val)
-{
-	m_alert_mode = val;
-}
-
-void Spotter::reset_direction() 
-{
-	direction = vec2({0.f, 1.f});
-}
-
-// a threshold to allow for some more fov collisions to happen
-float Spotter::check_sgn(float value) 
-{
-	if (value > 0 && value <= 40.f) return 1.0f;
-	if (value < 0 && value >= -40.f) return -1.0f;
-	else return 0.f;
-}
\ No newline at end of file
@@ -4,57 +4,32 @@
 #include "common.hpp"
 #include "map.hpp"
 #include "char.hpp"
+#include "spotter_sim.hpp"
+#include "texture_manager.hpp"
 
 class Map;
 class Char;
 
-// guard type 2 : spotter
-class Spotter : public Entity
+// draws SpotterSim with its sprite sheet
+class Spotter : public SpotterSim, public Renderable
 {
 	// shared texture
-	static Texture spotter_texture;
+	TextureHandle spotter_texture;
 
 private:
-	// config
-	const float config_scale = 0.25;
-
 	// animation
-	int spotter_sprite_switch = 1;
-	float spotter_sprite_countdown = 1500.f;
 	const float spriteWidth = 68.f;
 	const float spriteHeight = 67.f;
-	int frameIndex_x = 1;
-	int frameIndex_y = 1;
-
-	// detection
-	float radius = 70.f;
-
-	// alert
-	bool m_alert_mode;
+	int m_mesh_frame_x; // frame the mesh was built for
+	int m_mesh_frame_y;
 
 public:
 	bool init();
 	void destroy();
-	void update(float ms);
 	void draw(const mat3& projection) override;
-
-	// movement
-	void set_position(vec2 pos);
-	vec2 get_position() const;
-
-	// collision
-	vec2 get_bounding_box() const;
-
-	// detection
-	bool is_in_sight(Char &m_char, Map& m);
-
-	// alert
-	void set_alert_mode(bool val);
-
-	vec2 direction;
-	
-	void reset_direction();
+	// GL thread, from the render snapshot
+	void draw(const mat3& projection, const sprite_state& state);
 
 private:
-	float check_sgn(float value);
+	bool build_mesh(int frame_x, int frame_y);
 };
\ No newline at end of file
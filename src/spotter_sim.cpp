@@ -0,0 +1,176 @@
+// header
+#include "spotter_sim.hpp"
+#include "char_sim.hpp"
+#include "level_grid.hpp"
+
+// stlib
+#include <algorithm>
+#include <cmath>
+
+using namespace std;
+
+const float FOV_RADIANS = 0.39269908169;
+
+void SpotterSim::init()
+{
+	direction = vec2({ 0.f, -1.f });
+
+	motion.radians = 0.f;
+	motion.speed = 0.f;
+
+	physics.scale = { config_scale, config_scale };
+}
+
+// no GL here, Spotter builds the mesh for a new frame when it draws one
+void SpotterSim::update(float ms)
+{
+	advance_sprite(ms);
+}
+
+bool SpotterSim::advance_sprite(float ms)
+{
+	if (spotter_sprite_countdown > 0.f)
+		spotter_sprite_countdown -= ms;
+
+	vec2 directions[3] = { {0.f, -1.f}, {1.f, 0.f}, {-1.f, 0.f} };
+	// sprite change
+	if (spotter_sprite_countdown < 0) {
+
+		spotter_sprite_switch >= 3 ? spotter_sprite_switch = 1 : spotter_sprite_switch++;
+
+		if (frameIndex_x == 1) {
+			frameIndex_x = 2;
+		}
+		else if (frameIndex_x == 2) {
+			frameIndex_x = 7;
+			frameIndex_y = 0;
+		}
+		else if (frameIndex_x == 7) {
+			frameIndex_x = 1;
+			frameIndex_y = 1;
+		}
+
+		direction = directions[spotter_sprite_switch - 1];
+		spotter_sprite_countdown = 1500.f;
+		return true;
+	}
+	return false;
+}
+
+// movement
+void SpotterSim::set_position(vec2 position)
+{
+	motion.position = position;
+}
+
+vec2 SpotterSim::get_position() const
+{
+	return motion.position;
+}
+
+sprite_state SpotterSim::get_sprite_state() const
+{
+	return {motion.position, motion.radians, physics.scale, frameIndex_x, frameIndex_y};
+}
+
+// collision
+vec2 SpotterSim::get_bounding_box() const
+{
+	// adjusted to fit sprite sheet changes
+	return { std::fabs(physics.scale.x) * m_sheet_size.x * 0.5f * 0.00125f, std::fabs(physics.scale.y) * m_sheet_size.y * 0.5f * 0.0014285714285f };
+}
+
+// detection
+bool SpotterSim::is_in_sight(const CharSim &m_char, const LevelGrid &level)
+{
+	if (m_char.is_stealthed())
+		return false;
+
+	// spotters never move, so the cone only needs rebuilding when the walls change
+	if (m_visibility_revision != level.get_revision() ||
+		m_visibility_origin.x != motion.position.x || m_visibility_origin.y != motion.position.y)
+		compute_visibility(level);
+
+	vec2 tile = LevelGrid::get_grid_coords(m_char.get_position());
+	int x = (int)tile.x - m_window_x;
+	int y = (int)tile.y - m_window_y;
+	if (x < 0 || y < 0 || x >= m_window_width || y >= m_window_height)
+		return false;
+
+	int bit = y * m_window_width + x;
+	return (m_visibility[direction_index()][bit >> 6] >> (bit & 63)) & 1;
+}
+
+// marks every tile whose center is within radius, inside the fov and not occluded by a wall
+// only the tiles in reach are stored, the cost doesn't grow with the level
+void SpotterSim::compute_visibility(const LevelGrid &level)
+{
+	const vec2 directions[4] = { {0.f, -1.f}, {1.f, 0.f}, {-1.f, 0.f}, {0.f, 1.f} };
+
+	vec2 min_tile = LevelGrid::get_grid_coords({ motion.position.x - radius, motion.position.y - radius });
+	vec2 max_tile = LevelGrid::get_grid_coords({ motion.position.x + radius, motion.position.y + radius });
+	m_window_x = std::max((int)min_tile.x, 0);
+	m_window_y = std::max((int)min_tile.y, 0);
+	m_window_width = std::max(std::min((int)max_tile.x, level.get_width() - 1) - m_window_x + 1, 0);
+	m_window_height = std::max(std::min((int)max_tile.y, level.get_height() - 1) - m_window_y + 1, 0);
+
+	const size_t words = (m_window_width * m_window_height + 63) / 64;
+	for (int d = 0; d < 4; d++)
+		m_visibility[d].assign(words, 0);
+
+	m_visibility_revision = level.get_revision();
+	m_visibility_origin = motion.position;
+
+	for (int y = m_window_y; y < m_window_y + m_window_height; y++)
+	{
+		for (int x = m_window_x; x < m_window_x + m_window_width; x++)
+		{
+			vec2 center = LevelGrid::get_tile_center_coords({ (float)x, (float)y });
+			vec2 tile_vector = sub(center, motion.position);
+			float magnitude = len(tile_vector);
+			if (magnitude <= 0.f || magnitude > radius)
+				continue;
+
+			if (level.is_segment_blocked(motion.position, center))
+				continue;
+
+			int bit = (y - m_window_y) * m_window_width + (x - m_window_x);
+			for (int d = 0; d < 4; d++)
+			{
+				float angle = acos(dot(tile_vector, vec2{ -directions[d].x, -directions[d].y }) / magnitude);
+				if (angle <= FOV_RADIANS)
+					m_visibility[d][bit >> 6] |= (uint64_t)1 << (bit & 63);
+			}
+		}
+	}
+}
+
+// alert
+void SpotterSim::set_alert_mode(bool val)
+{
+	m_alert_mode = val;
+}
+
+void SpotterSim::reset_direction() 
+{
+	direction = vec2({0.f, 1.f});
+}
+
+int SpotterSim::direction_index() const
+{
+	if (direction.x > 0.f)
+		return 1;
+	if (direction.x < 0.f)
+		return 2;
+	if (direction.y > 0.f)
+		return 3;
+	return 0;
+}
+
+// a threshold to allow for some more fov collisions to happen
+float SpotterSim::check_sgn(float value) 
+{
+	if (value > 0 && value <= 40.f) return 1.0f;
+	if (value < 0 && value >= -40.f) return -1.0f;
+	else return 0.f;
+}
\ No newline at end of file
@@ -0,0 +1,73 @@
+#pragma once
+
+// internal
+#include "body.hpp"
+
+// stlib
+#include <cstdint>
+#include <vector>
+
+class CharSim;
+class LevelGrid;
+
+// guard type 2 : spotter, its facing and sight cone, no GL so it builds into chameleon_core
+// and runs headless, Spotter draws it
+class SpotterSim : public Body
+{
+protected:
+	// config
+	const float config_scale = 0.25;
+
+	// sheet the bounding box factors were fitted to, Spotter sets the loaded texture's size
+	vec2 m_sheet_size = {512.f, 448.f};
+
+	// animation
+	int spotter_sprite_switch = 1;
+	float spotter_sprite_countdown = 1500.f;
+	int frameIndex_x = 1;
+	int frameIndex_y = 1;
+
+private:
+	// detection
+	float radius = 70.f;
+
+	// visible tiles per facing direction, one bit per tile of the window around the spotter
+	std::vector<uint64_t> m_visibility[4];
+	int m_window_x = 0; // first tile of the window
+	int m_window_y = 0;
+	int m_window_width = 0;
+	int m_window_height = 0;
+	unsigned int m_visibility_revision = 0; // LevelGrid revision, 0 before the first compute
+	vec2 m_visibility_origin;
+
+	// alert
+	bool m_alert_mode;
+
+public:
+	void init();
+	void update(float ms);
+
+	// movement
+	void set_position(vec2 pos);
+	vec2 get_position() const;
+	sprite_state get_sprite_state() const;
+
+	// collision
+	vec2 get_bounding_box() const;
+
+	// detection
+	bool is_in_sight(const CharSim &m_char, const LevelGrid &level);
+	void compute_visibility(const LevelGrid &level);
+
+	// alert
+	void set_alert_mode(bool val);
+
+	vec2 direction;
+	
+	void reset_direction();
+
+private:
+	float check_sgn(float value);
+	bool advance_sprite(float ms);
+	int direction_index() const;
+};
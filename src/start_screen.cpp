@@ -5,68 +5,49 @@
 #include <algorithm>
 #include <cmath>
 
-Texture StartScreen::start_game;
-Texture StartScreen::controls;
-Texture StartScreen::levels;
-Texture StartScreen::quit;
-Texture StartScreen::game_title;
-Texture StartScreen::pointer;
-
 bool StartScreen::init()
 {
 	// load shared texture
-	if (!start_game.is_valid())
+	start_game = TextureManager::load(textures_path("start_game.png"), "start_screen");
+	if (!start_game)
 	{
-		if (!start_game.load_from_file(textures_path("start_game.png")))
-		{
-			fprintf(stderr, "Failed to load start texture!");
-			return false;
-		}
+		fprintf(stderr, "Failed to load start texture!");
+		return false;
 	}
 
-	if (!pointer.is_valid())
+	pointer = TextureManager::load(textures_path("pointer.png"), "start_screen");
+	if (!pointer)
 	{
-		if (!pointer.load_from_file(textures_path("pointer.png")))
-		{
-			fprintf(stderr, "Failed to load pointer texture!");
-			return false;
-		}
+		fprintf(stderr, "Failed to load pointer texture!");
+		return false;
 	}
 
-	if (!controls.is_valid())
+	controls = TextureManager::load(textures_path("controls.png"), "start_screen");
+	if (!controls)
 	{
-		if (!controls.load_from_file(textures_path("controls.png")))
-		{
-			fprintf(stderr, "Failed to load controls texture!");
-			return false;
-		}
+		fprintf(stderr, "Failed to load controls texture!");
+		return false;
 	}
 
-	if (!levels.is_valid())
+	levels = TextureManager::load(textures_path("levels.png"), "start_screen");
+	if (!levels)
 	{
-		if (!levels.load_from_file(textures_path("levels.png")))
-		{
-			fprintf(stderr, "Failed to load levels texture!");
-			return false;
-		}
+		fprintf(stderr, "Failed to load levels texture!");
+		return false;
 	}
 
-	if (!quit.is_valid())
+	quit = TextureManager::load(textures_path("quit.png"), "start_screen");
+	if (!quit)
 	{
-		if (!quit.load_from_file(textures_path("quit.png")))
-		{
-			fprintf(stderr, "Failed to load quit texture!");
-			return false;
-		}
+		fprintf(stderr, "Failed to load quit texture!");
+		return false;
 	}
 
-	if (!game_title.is_valid())
+	game_title = TextureManager::load(textures_path("game_title.png"), "start_screen");
+	if (!game_title)
 	{
-		if (!game_title.load_from_file(textures_path("game_title.png")))
-		{
-			fprintf(stderr, "Failed to load title texture!");
-			return false;
-		}
+		fprintf(stderr, "Failed to load title texture!");
+		return false;
 	}
 
 	float wr = std::max(SCREEN_WIDTH, SCREEN_HEIGHT) * 0.5f;
@@ -141,34 +122,34 @@ void StartScreen::update(unsigned int state)
 void StartScreen::draw(const mat3 &projection)
 {
 	// pointer
-	vec2 pointer_scale = vec2({pointer.width / (8 * SCREEN_WIDTH), pointer.height / (8 * SCREEN_WIDTH)});
+	vec2 pointer_scale = vec2({pointer->width / (8 * SCREEN_WIDTH), pointer->height / (8 * SCREEN_WIDTH)});
 	//vec2 pointer_pos
-	draw_element(projection, pointer, pointer_pos, pointer_scale);
+	draw_element(projection, *pointer, pointer_pos, pointer_scale);
 
 	// start
-	vec2 start_game_scale = vec2({start_game.width / (2 * SCREEN_WIDTH), start_game.height / (2 * SCREEN_WIDTH)});
+	vec2 start_game_scale = vec2({start_game->width / (2 * SCREEN_WIDTH), start_game->height / (2 * SCREEN_WIDTH)});
 	vec2 start_game_pos = vec2({850.f, 1 * (SCREEN_HEIGHT / 5.f)});
-	draw_element(projection, start_game, start_game_pos, start_game_scale);
+	draw_element(projection, *start_game, start_game_pos, start_game_scale);
 
 	// controls
-	vec2 controls_scale = vec2({controls.width / (2 * SCREEN_WIDTH), controls.height / (2 * SCREEN_WIDTH)});
+	vec2 controls_scale = vec2({controls->width / (2 * SCREEN_WIDTH), controls->height / (2 * SCREEN_WIDTH)});
 	vec2 controls_pos = vec2({850.f, 2 * (SCREEN_HEIGHT / 5.f)});
-	draw_element(projection, controls, controls_pos, controls_scale);
+	draw_element(projection, *controls, controls_pos, controls_scale);
 	
 	// levels
-	vec2 levels_scale = vec2({levels.width / (2 * SCREEN_WIDTH), levels.height / (2 * SCREEN_WIDTH)});
+	vec2 levels_scale = vec2({levels->width / (2 * SCREEN_WIDTH), levels->height / (2 * SCREEN_WIDTH)});
 	vec2 levels_pos = vec2({850.f, 3 * (SCREEN_HEIGHT / 5.f)});
-	draw_element(projection, levels, levels_pos, levels_scale);
+	draw_element(projection, *levels, levels_pos, levels_scale);
 
 	// quit
-	vec2 quit_scale = vec2({quit.width / (2 * SCREEN_WIDTH), quit.height / (2 * SCREEN_WIDTH)});
+	vec2 quit_scale = vec2({quit->width / (2 * SCREEN_WIDTH), quit->height / (2 * SCREEN_WIDTH)});
 	vec2 quit_pos = vec2({850.f, 4 * (SCREEN_HEIGHT / 5.f)});
-	draw_element(projection, quit, quit_pos, quit_scale);
+	draw_element(projection, *quit, quit_pos, quit_scale);
 
 	// game title
-	vec2 game_title_scale = vec2({game_title.width / SCREEN_WIDTH, game_title.height / SCREEN_WIDTH});
+	vec2 game_title_scale = vec2({game_title->width / SCREEN_WIDTH, game_title->height / SCREEN_WIDTH});
 	vec2 game_title_pos = vec2({350.f, SCREEN_HEIGHT / 2.f});
-	draw_element(projection, game_title, game_title_pos, game_title_scale);
+	draw_element(projection, *game_title, game_title_pos, game_title_scale);
 }
 
 void StartScreen::draw_element(const mat3& proj, const Texture& texture, vec2 pos, vec2 scale)
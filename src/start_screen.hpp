@@ -3,17 +3,18 @@
 // internal
 #include "common.hpp"
 #include "constants.hpp"
+#include "texture_manager.hpp"
 
 // start screen
 class StartScreen : public Entity
 {
 	// shared texture
-	static Texture pointer;
-	static Texture start_game;
-	static Texture controls;
-	static Texture levels;
-	static Texture quit;
-	static Texture game_title;
+	TextureHandle pointer;
+	TextureHandle start_game;
+	TextureHandle controls;
+	TextureHandle levels;
+	TextureHandle quit;
+	TextureHandle game_title;
 
 	vec2 pointer_pos;
 
@@ -0,0 +1,193 @@
+// header
+#include "texture_loader.hpp"
+#include "asset_archive.hpp"
+#include "job_system.hpp"
+
+#include "../ext/stb_image/stb_image.h"
+
+// stlib
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <thread>
+
+TextureLoader::TextureLoader() : m_jobs(nullptr),
+								 m_pending(0),
+								 m_next_pbo(0)
+{
+	m_pbos[0] = m_pbos[1] = 0;
+}
+
+bool TextureLoader::init(JobSystem &jobs)
+{
+	m_jobs = &jobs;
+	m_pending = 0;
+
+	gl_flush_errors();
+	glGenBuffers(2, m_pbos);
+	return !gl_has_errors();
+}
+
+void TextureLoader::destroy()
+{
+	if (m_jobs == nullptr)
+		return;
+
+	finish();
+	glDeleteBuffers(2, m_pbos);
+	m_pbos[0] = m_pbos[1] = 0;
+	m_jobs = nullptr;
+}
+
+bool TextureLoader::request(Texture &texture, const char *path)
+{
+	if (path == nullptr)
+		return false;
+
+	// the header is enough for the size, the decode is the slow part
+	int width, height;
+	if (!stbi_info(path, &width, &height, nullptr))
+		return false;
+
+	make_room();
+	if (!allocate(texture, width, height, 1))
+		return false;
+
+	Texture *target = &texture;
+	GLuint id = texture.id;
+	std::string file = path;
+	m_jobs->submit([this, target, id, file]() {
+		decoded d = {target, id, nullptr, 0, 0, 1, false};
+		d.pixels = stbi_load(file.c_str(), &d.width, &d.height, nullptr, 4);
+		if (d.pixels == nullptr)
+			fprintf(stderr, "Failed to decode texture %s\n", file.c_str());
+
+		// never full, request() keeps the pending count under the capacity
+		while (!m_decoded.push(d))
+			std::this_thread::yield();
+	});
+	return true;
+}
+
+// nothing to decode, queued as if a worker had finished it
+bool TextureLoader::request(Texture &texture, const archive_texture &packed)
+{
+	make_room();
+	if (!allocate(texture, packed.width, packed.height, packed.levels))
+		return false;
+
+	decoded d = {&texture, texture.id, packed.pixels, packed.width, packed.height, packed.levels, true};
+	while (!m_decoded.push(d))
+		std::this_thread::yield();
+	return true;
+}
+
+// a full queue would drop results
+void TextureLoader::make_room()
+{
+	while (m_pending >= MAX_PENDING)
+	{
+		if (upload() == 0 && !m_jobs->run_one())
+			std::this_thread::yield();
+	}
+}
+
+// storage now, undefined until the upload, so nothing waits on the texture id
+bool TextureLoader::allocate(Texture &texture, int width, int height, int levels)
+{
+	gl_flush_errors();
+	glGenTextures(1, &texture.id);
+	glBindTexture(GL_TEXTURE_2D, texture.id);
+	for (int level = 0; level < levels; level++)
+		glTexImage2D(GL_TEXTURE_2D, level, GL_RGBA, std::max(1, width >> level), std::max(1, height >> level), 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, levels - 1);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, levels > 1 ? GL_NEAREST_MIPMAP_NEAREST : GL_NEAREST);
+	if (gl_has_errors())
+		return false;
+
+	texture.width = width;
+	texture.height = height;
+	texture.pending = true;
+	m_pending++;
+	return true;
+}
+
+int TextureLoader::upload()
+{
+	int count = 0;
+	decoded d;
+	while (m_decoded.pop(d))
+	{
+		upload(d);
+		if (!d.packed)
+			stbi_image_free(const_cast<unsigned char *>(d.pixels));
+		m_pending--;
+		count++;
+	}
+	return count;
+}
+
+// the copy into the mapped buffer is the only CPU work, glTexSubImage2D reads from the
+// buffer and returns without waiting for the transfer
+void TextureLoader::upload(const decoded &d)
+{
+	Texture &texture = *d.texture;
+	texture.pending = false;
+	if (d.pixels == nullptr || texture.id != d.id)
+		return;
+	if (d.width != texture.width || d.height != texture.height)
+	{
+		fprintf(stderr, "Texture changed size while loading\n");
+		return;
+	}
+
+	GLsizeiptr size = (GLsizeiptr)AssetArchive::chain_bytes(d.width, d.height, d.levels);
+	GLuint pbo = m_pbos[m_next_pbo];
+	m_next_pbo = 1 - m_next_pbo;
+
+	gl_flush_errors();
+	glBindBuffer(GL_PIXEL_UNPACK_BUFFER, pbo);
+	// orphan the old storage instead of waiting for the driver to finish with it
+	glBufferData(GL_PIXEL_UNPACK_BUFFER, size, nullptr, GL_STREAM_DRAW);
+	void *mapped = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, size, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+	glBindTexture(GL_TEXTURE_2D, texture.id);
+	if (mapped != nullptr)
+	{
+		memcpy(mapped, d.pixels, (size_t)size);
+		glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+	}
+	else
+	{
+		// no mapping, a plain upload from client memory
+		glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+	}
+
+	// from the bound buffer the pixel pointer is an offset into it
+	size_t offset = 0;
+	for (int level = 0; level < d.levels; level++)
+	{
+		int w = std::max(1, d.width >> level);
+		int h = std::max(1, d.height >> level);
+		const void *pixels = mapped != nullptr ? (const void *)offset : (const void *)(d.pixels + offset);
+		glTexSubImage2D(GL_TEXTURE_2D, level, 0, 0, w, h, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+		offset += (size_t)w * h * 4;
+	}
+	glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+	gl_has_errors();
+}
+
+// the GL thread helps decoding instead of sleeping
+void TextureLoader::finish()
+{
+	while (m_pending > 0)
+	{
+		if (upload() == 0 && !m_jobs->run_one())
+			std::this_thread::yield();
+	}
+}
+
+int TextureLoader::get_pending() const
+{
+	return m_pending;
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+// internal
+#include "common.hpp"
+#include "frame_sync.hpp"
+
+class JobSystem;
+struct archive_texture;
+
+// decodes PNGs on the job system workers while the GL thread keeps going, the pool should be
+// its own: threads waiting in parallel_for or JobGraph::run execute whatever is queued
+// request() reads the size from the file header and allocates the texture right away,
+// so meshes can be built from width and height, the pixels follow in upload()
+// everything but the decode runs on the GL thread
+class TextureLoader
+{
+public:
+	static constexpr int MAX_PENDING = 256; // decodes in flight, request() waits past this
+
+private:
+	// a worker's decode, pixels are null if it failed
+	struct decoded
+	{
+		Texture *texture;
+		GLuint id; // the texture's id at request time, it may have been reloaded since
+		const unsigned char *pixels; // levels one after the other from the full size down
+		int width;
+		int height;
+		int levels;
+		bool packed; // pixels point into the archive mapping, nothing to free
+	};
+
+	JobSystem *m_jobs;
+	MpscQueue<decoded, MAX_PENDING> m_decoded;
+	int m_pending;
+
+	// two unpack buffers, one is filled while the driver may still read the other
+	GLuint m_pbos[2];
+	int m_next_pbo;
+
+private:
+	void make_room();
+	bool allocate(Texture &texture, int width, int height, int levels);
+	void upload(const decoded &d);
+
+public:
+	TextureLoader();
+
+	bool init(JobSystem &jobs);
+
+	// waits for every request, pixels still queued are dropped
+	void destroy();
+
+	// false if the file can't be read, the texture is pending until upload() gets to it
+	bool request(Texture &texture, const char *path);
+
+	// already decoded, upload() copies the level chain from the archive mapping, which has
+	// to stay open until then
+	bool request(Texture &texture, const archive_texture &packed);
+
+	// uploads every finished decode, returns how many
+	int upload();
+
+	// blocks until no request is pending
+	void finish();
+
+	int get_pending() const;
+};
@@ -0,0 +1,274 @@
+// header
+#include "texture_manager.hpp"
+#include "texture_loader.hpp"
+
+// stlib
+#include <algorithm>
+#include <map>
+
+TextureManager *TextureManager::active = nullptr;
+
+namespace
+{
+// one more handle for the owner, returns its index in the entry's owners
+int hold(texture_entry &entry, const char *owner)
+{
+	for (size_t i = 0; i < entry.owners.size(); i++)
+	{
+		if (entry.owners[i].name == owner)
+		{
+			entry.owners[i].handles++;
+			return (int)i;
+		}
+	}
+	entry.owners.push_back({owner, 1});
+	return (int)entry.owners.size() - 1;
+}
+} // namespace
+
+TextureHandle::TextureHandle(const TextureHandle &other) : m_entry(other.m_entry),
+														   m_owner(other.m_owner)
+{
+	if (m_entry)
+		m_entry->owners[m_owner].handles++;
+}
+
+TextureHandle::TextureHandle(TextureHandle &&other) noexcept : m_entry(std::move(other.m_entry)),
+															   m_owner(other.m_owner)
+{
+	other.m_owner = -1;
+}
+
+TextureHandle &TextureHandle::operator=(TextureHandle other) noexcept
+{
+	std::swap(m_entry, other.m_entry);
+	std::swap(m_owner, other.m_owner);
+	return *this;
+}
+
+TextureHandle::~TextureHandle()
+{
+	reset();
+}
+
+// the idle time and the budget order count from the last release
+void TextureHandle::reset()
+{
+	if (!m_entry)
+		return;
+
+	texture_owner &owner = m_entry->owners[m_owner];
+	owner.handles--;
+	m_entry->last_owner = owner.name;
+	m_entry->last_used = std::chrono::steady_clock::now();
+	m_entry.reset();
+	m_owner = -1;
+}
+
+TextureManager::TextureManager() : m_idle_seconds(DEFAULT_IDLE_SECONDS),
+								   m_unused_budget(DEFAULT_UNUSED_BUDGET),
+								   m_last_collect(Clock::now())
+{
+}
+
+std::shared_ptr<texture_entry> TextureManager::make_entry(const std::string &path)
+{
+	std::shared_ptr<texture_entry> entry = std::make_shared<texture_entry>();
+	entry->path = path;
+	if (!entry->texture.load_async(path.c_str()))
+		fprintf(stderr, "Failed to load texture %s\n", path.c_str());
+
+	entry->bytes = (size_t)entry->texture.width * entry->texture.height * 4;
+	entry->last_used = Clock::now();
+	return entry;
+}
+
+TextureHandle TextureManager::load(const std::string &path, const char *owner)
+{
+	if (active != nullptr)
+		return active->acquire(path, owner);
+
+	TextureHandle handle;
+	handle.m_entry = make_entry(path);
+	handle.m_owner = hold(*handle.m_entry, owner);
+	return handle;
+}
+
+// a failed load stays an entry with an invalid texture, so it's reported once
+TextureHandle TextureManager::acquire(const std::string &path, const char *owner)
+{
+	std::shared_ptr<texture_entry> &entry = m_entries[path];
+	if (!entry)
+		entry = make_entry(path);
+
+	entry->last_used = Clock::now();
+
+	TextureHandle handle;
+	handle.m_entry = entry;
+	handle.m_owner = hold(*entry, owner);
+	return handle;
+}
+
+void TextureManager::set_idle_time(float seconds)
+{
+	m_idle_seconds = seconds;
+}
+
+void TextureManager::set_unused_budget(size_t bytes)
+{
+	m_unused_budget = bytes;
+}
+
+// the manager's own reference is the last one when no handle is left
+int TextureManager::collect()
+{
+	Clock::time_point now = Clock::now();
+	if (std::chrono::duration<float>(now - m_last_collect).count() < COLLECT_INTERVAL_SECONDS)
+		return 0;
+	m_last_collect = now;
+
+	using Entry = decltype(m_entries)::iterator;
+	std::vector<Entry> unused;
+	size_t unused_bytes = 0;
+
+	int evicted = 0;
+	for (auto it = m_entries.begin(); it != m_entries.end();)
+	{
+		texture_entry &entry = *it->second;
+		if (it->second.use_count() > 1 || entry.texture.is_pending())
+		{
+			++it;
+			continue;
+		}
+
+		if (std::chrono::duration<float>(now - entry.last_used).count() >= m_idle_seconds)
+		{
+			it = m_entries.erase(it);
+			evicted++;
+			continue;
+		}
+
+		unused.push_back(it);
+		unused_bytes += entry.bytes;
+		++it;
+	}
+
+	// past the budget the least recently released go first
+	if (unused_bytes > m_unused_budget)
+	{
+		std::sort(unused.begin(), unused.end(), [](Entry a, Entry b) {
+			return a->second->last_used < b->second->last_used;
+		});
+		for (Entry it : unused)
+		{
+			if (unused_bytes <= m_unused_budget)
+				break;
+			unused_bytes -= it->second->bytes;
+			m_entries.erase(it);
+			evicted++;
+		}
+	}
+	return evicted;
+}
+
+// pending textures are left to collect(), the loader still writes to them
+int TextureManager::evict_unused(const char *owner)
+{
+	int evicted = 0;
+	for (auto it = m_entries.begin(); it != m_entries.end();)
+	{
+		texture_entry &entry = *it->second;
+		if (it->second.use_count() == 1 && !entry.texture.is_pending() && entry.last_owner == owner)
+		{
+			it = m_entries.erase(it);
+			evicted++;
+			continue;
+		}
+		++it;
+	}
+	return evicted;
+}
+
+// a worker may still hold a pending texture, its decode has to land first
+void TextureManager::destroy()
+{
+	if (Texture::loader != nullptr)
+		Texture::loader->finish();
+
+	for (auto &it : m_entries)
+	{
+		Texture &texture = it.second->texture;
+		if (texture.id != 0)
+			glDeleteTextures(1, &texture.id);
+		texture.id = 0;
+	}
+	m_entries.clear();
+}
+
+texture_residency TextureManager::get_residency() const
+{
+	texture_residency residency = {0, 0, 0, 0, {}};
+	std::map<std::string, owner_residency> owners;
+	for (const auto &it : m_entries)
+	{
+		const texture_entry &entry = *it.second;
+		residency.textures++;
+		residency.bytes += entry.bytes;
+		if (it.second.use_count() == 1)
+		{
+			residency.unused++;
+			residency.unused_bytes += entry.bytes;
+		}
+
+		for (const texture_owner &owner : entry.owners)
+		{
+			if (owner.handles == 0)
+				continue;
+			owner_residency &o = owners[owner.name];
+			o.owner = owner.name;
+			o.textures++;
+			o.bytes += entry.bytes;
+		}
+	}
+
+	for (const auto &it : owners)
+		residency.owners.push_back(it.second);
+	return residency;
+}
+
+// every texture largest first, then the totals per owner
+void TextureManager::print_residency(FILE *out) const
+{
+	std::vector<const std::shared_ptr<texture_entry> *> entries;
+	for (const auto &it : m_entries)
+		entries.push_back(&it.second);
+	std::sort(entries.begin(), entries.end(), [](const std::shared_ptr<texture_entry> *a, const std::shared_ptr<texture_entry> *b) {
+		return (*a)->bytes != (*b)->bytes ? (*a)->bytes > (*b)->bytes : (*a)->path < (*b)->path;
+	});
+
+	fprintf(out, "%8s %10s %5s  %s\n", "KB", "size", "refs", "path (owners)");
+	for (const std::shared_ptr<texture_entry> *entry : entries)
+	{
+		const texture_entry &e = **entry;
+		char size[32];
+		snprintf(size, sizeof(size), "%dx%d", e.texture.width, e.texture.height);
+		fprintf(out, "%8.1f %10s %5ld  %s (", e.bytes / 1024.0, size, entry->use_count() - 1, e.path.c_str());
+		bool first = true;
+		for (const texture_owner &owner : e.owners)
+		{
+			if (owner.handles == 0)
+				continue;
+			fprintf(out, first ? "%s" : ", %s", owner.name.c_str());
+			first = false;
+		}
+		if (first)
+			fprintf(out, "last %s", e.last_owner.c_str());
+		fprintf(out, ")%s\n", e.texture.is_pending() ? " pending" : "");
+	}
+
+	texture_residency residency = get_residency();
+	for (const owner_residency &owner : residency.owners)
+		fprintf(out, "%-16s %3d textures %8.1f KB\n", owner.owner.c_str(), owner.textures, owner.bytes / 1024.0);
+	fprintf(out, "total %d textures %.1f KB, %d unused %.1f KB\n", residency.textures, residency.bytes / 1024.0,
+			residency.unused, residency.unused_bytes / 1024.0);
+}
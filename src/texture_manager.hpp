@@ -0,0 +1,122 @@
+#pragma once
+
+// internal
+#include "common.hpp"
+
+// stlib
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// handles one owner holds on a texture
+struct texture_owner
+{
+	std::string name;
+	int handles;
+};
+
+// a texture shared by every handle to its path
+struct texture_entry
+{
+	Texture texture;
+	std::string path;
+	std::vector<texture_owner> owners; // everyone who asked for it in order, 0 handles once they let go
+	std::string last_owner;            // owner of the last handle released
+	size_t bytes = 0;                  // RGBA8 level 0
+	std::chrono::steady_clock::time_point last_used;
+};
+
+// reference to a shared texture, the texture stays loaded while a handle to it exists
+// copies count for the same owner
+class TextureHandle
+{
+	friend class TextureManager;
+	std::shared_ptr<texture_entry> m_entry;
+	int m_owner = -1; // index in the entry's owners
+
+public:
+	TextureHandle() = default;
+	TextureHandle(const TextureHandle &other);
+	TextureHandle(TextureHandle &&other) noexcept;
+	TextureHandle &operator=(TextureHandle other) noexcept;
+	~TextureHandle();
+
+	const Texture *get() const { return m_entry ? &m_entry->texture : nullptr; }
+	const Texture &operator*() const { return m_entry->texture; }
+	const Texture *operator->() const { return &m_entry->texture; }
+
+	// true once the texture has an id, its pixels may still be decoding
+	explicit operator bool() const { return m_entry && m_entry->texture.is_valid(); }
+
+	void reset();
+};
+
+// what the manager holds, shared textures count for each owner holding a handle
+struct owner_residency
+{
+	std::string owner;
+	int textures;
+	size_t bytes;
+};
+
+struct texture_residency
+{
+	int textures;
+	int unused; // no handle left, deleted once idle or past the budget
+	size_t bytes;
+	size_t unused_bytes;
+	std::vector<owner_residency> owners;
+};
+
+// textures by path, loaded once through Texture::load_async and handed out as handles
+// a texture nobody holds a handle to is deleted after the idle time, or sooner, least
+// recently used first, while the unused textures add up to more than the budget
+class TextureManager
+{
+public:
+	static constexpr float DEFAULT_IDLE_SECONDS = 30.f;
+	static constexpr float COLLECT_INTERVAL_SECONDS = 1.f;
+	static constexpr size_t DEFAULT_UNUSED_BUDGET = 16 << 20; // RGBA bytes
+
+	// the manager load() shares textures through, set by World
+	static TextureManager *active;
+
+private:
+	using Clock = std::chrono::steady_clock;
+
+	std::unordered_map<std::string, std::shared_ptr<texture_entry>> m_entries;
+	float m_idle_seconds;
+	size_t m_unused_budget;
+	Clock::time_point m_last_collect;
+
+private:
+	static std::shared_ptr<texture_entry> make_entry(const std::string &path);
+
+public:
+	TextureManager();
+
+	// from the active manager, without one every load is its own texture
+	static TextureHandle load(const std::string &path, const char *owner);
+
+	TextureHandle acquire(const std::string &path, const char *owner);
+
+	void set_idle_time(float seconds);
+	void set_unused_budget(size_t bytes);
+
+	// deletes idle textures and trims the unused ones to the budget, runs at most once
+	// per interval, returns how many went
+	int collect();
+
+	// deletes the unused textures an owner released last right away, returns how many went
+	int evict_unused(const char *owner);
+
+	// deletes every texture, handles still held afterwards see an invalid texture
+	void destroy();
+
+	texture_residency get_residency() const;
+	void print_residency(FILE *out) const;
+};
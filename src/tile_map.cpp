@@ -0,0 +1,120 @@
+// header
+#include "tile_map.hpp"
+#include "level_grid.hpp"
+
+// stlib
+#include <cstring>
+
+TileMap::TileMap() : m_width(0),
+					 m_height(0),
+					 m_chunks_x(0),
+					 m_chunks_y(0),
+					 m_revision(0)
+{
+}
+
+void TileMap::assign(int width, int height, const char *tiles, const unsigned char *classes)
+{
+	m_width = width;
+	m_height = height;
+	m_chunks_x = (width + CHUNK_MASK) >> CHUNK_SHIFT;
+	m_chunks_y = (height + CHUNK_MASK) >> CHUNK_SHIFT;
+	m_revision++;
+
+	// the part of an edge chunk past the map stays empty floor, is_wall checks bounds first
+	m_chunks.resize((size_t)m_chunks_x * m_chunks_y);
+	for (chunk &c : m_chunks)
+	{
+		memset(&c, 0, sizeof(c));
+		c.revision = m_revision;
+	}
+
+	for (int y = 0; y < height; y++)
+	{
+		for (int x = 0; x < width; x++)
+		{
+			size_t i = (size_t)y * width + x;
+			chunk &c = chunk_at(x, y);
+			c.tiles[local(x, y)] = tiles[i];
+			c.classes[local(x, y)] = classes[i];
+			if (classes[i] == LevelGrid::TILE_WALL)
+			{
+				c.wall_rows[y & CHUNK_MASK] |= uint32_t(1) << (x & CHUNK_MASK);
+				c.wall_count++;
+			}
+		}
+	}
+}
+
+bool TileMap::set_tile(int x, int y, char tile)
+{
+	if (!contains(x, y))
+		return false;
+
+	chunk &c = chunk_at(x, y);
+	bool was_wall = is_wall(x, y);
+	bool wall = LevelGrid::is_wall_glyph(tile);
+	uint32_t bit = uint32_t(1) << (x & CHUNK_MASK);
+
+	c.tiles[local(x, y)] = tile;
+	c.classes[local(x, y)] = (unsigned char)LevelGrid::get_tile_class(tile);
+	if (wall && !was_wall)
+	{
+		c.wall_rows[y & CHUNK_MASK] |= bit;
+		c.wall_count++;
+	}
+	else if (!wall && was_wall)
+	{
+		c.wall_rows[y & CHUNK_MASK] &= ~bit;
+		c.wall_count--;
+	}
+	c.revision = ++m_revision;
+	return true;
+}
+
+// one masked word per chunk, chunks without walls are skipped
+bool TileMap::any_wall_in_row(int y, int x0, int x1) const
+{
+	if (x0 > x1)
+		std::swap(x0, x1);
+	if (y < 0 || y >= m_height || x0 < 0 || x1 >= m_width)
+		return true;
+
+	for (int x = x0; x <= x1; x = (x | CHUNK_MASK) + 1)
+	{
+		const chunk &c = chunk_at(x, y);
+		if (c.wall_count == 0)
+			continue;
+
+		int first = x & CHUNK_MASK;
+		int last = std::min(x1 - (x & ~CHUNK_MASK), (int)CHUNK_MASK);
+		int width = last - first + 1;
+		uint32_t mask = (width >= 32 ? ~uint32_t(0) : ((uint32_t(1) << width) - 1)) << first;
+		if (c.wall_rows[y & CHUNK_MASK] & mask)
+			return true;
+	}
+	return false;
+}
+
+bool TileMap::any_wall_in_column(int x, int y0, int y1) const
+{
+	if (y0 > y1)
+		std::swap(y0, y1);
+	if (x < 0 || x >= m_width || y0 < 0 || y1 >= m_height)
+		return true;
+
+	uint32_t bit = uint32_t(1) << (x & CHUNK_MASK);
+	for (int y = y0; y <= y1; y++)
+	{
+		const chunk &c = chunk_at(x, y);
+		if (c.wall_count == 0)
+		{
+			// rest of this chunk's rows
+			y |= CHUNK_MASK;
+			continue;
+		}
+		if (c.wall_rows[y & CHUNK_MASK] & bit)
+			return true;
+	}
+	return false;
+}
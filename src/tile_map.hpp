@@ -0,0 +1,86 @@
+#pragma once
+
+// stlib
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+// level tiles of any size, stored in square chunks so collision and drawing only touch
+// the chunks a query or the camera overlaps
+// every accessor is bounds safe: outside the map there is no tile, its class is floor
+// and it counts as a wall
+class TileMap
+{
+public:
+	static constexpr int CHUNK_SHIFT = 5;
+	static constexpr int CHUNK_SIZE = 1 << CHUNK_SHIFT; // tiles per chunk side
+	static constexpr int CHUNK_MASK = CHUNK_SIZE - 1;
+
+	static constexpr char NO_TILE = '\0';
+
+	struct chunk
+	{
+		char tiles[CHUNK_SIZE * CHUNK_SIZE];          // row major inside the chunk
+		unsigned char classes[CHUNK_SIZE * CHUNK_SIZE]; // LevelGrid tile class per tile
+		uint32_t wall_rows[CHUNK_SIZE];               // bit x set when tile x of the row is a wall
+		int wall_count;
+		unsigned int revision; // map revision of the last change, renderers compare it to redraw
+	};
+
+private:
+	int m_width;
+	int m_height;
+	int m_chunks_x;
+	int m_chunks_y;
+	std::vector<chunk> m_chunks; // row major
+	unsigned int m_revision;
+
+private:
+	chunk &chunk_at(int x, int y) { return m_chunks[(y >> CHUNK_SHIFT) * m_chunks_x + (x >> CHUNK_SHIFT)]; }
+	const chunk &chunk_at(int x, int y) const { return m_chunks[(y >> CHUNK_SHIFT) * m_chunks_x + (x >> CHUNK_SHIFT)]; }
+	static int local(int x, int y) { return (y & CHUNK_MASK) * CHUNK_SIZE + (x & CHUNK_MASK); }
+
+public:
+	TileMap();
+
+	// copies row major tiles and their classes into the chunks and builds the wall bits,
+	// every chunk changes revision
+	void assign(int width, int height, const char *tiles, const unsigned char *classes);
+
+	// false outside the map
+	bool set_tile(int x, int y, char tile);
+
+	int get_width() const { return m_width; }
+	int get_height() const { return m_height; }
+	bool contains(int x, int y) const { return x >= 0 && y >= 0 && x < m_width && y < m_height; }
+
+	char get_tile(int x, int y) const { return contains(x, y) ? chunk_at(x, y).tiles[local(x, y)] : NO_TILE; }
+	int get_tile_class(int x, int y) const { return contains(x, y) ? chunk_at(x, y).classes[local(x, y)] : 0; }
+	bool is_wall(int x, int y) const
+	{
+		return !contains(x, y) || ((chunk_at(x, y).wall_rows[y & CHUNK_MASK] >> (x & CHUNK_MASK)) & 1);
+	}
+
+	// inclusive spans, any tile outside the map is a wall
+	bool any_wall_in_row(int y, int x0, int x1) const;
+	bool any_wall_in_column(int x, int y0, int y1) const;
+
+	// chunks
+	int get_chunks_x() const { return m_chunks_x; }
+	int get_chunks_y() const { return m_chunks_y; }
+	const chunk &get_chunk(int cx, int cy) const { return m_chunks[cy * m_chunks_x + cx]; }
+	unsigned int get_revision() const { return m_revision; }
+
+	// f(cx, cy, chunk) for every chunk overlapping the inclusive tile rect, clamped to the map
+	template <typename F>
+	void for_each_chunk(int x0, int y0, int x1, int y1, F f) const
+	{
+		int cx0 = std::max(x0, 0) >> CHUNK_SHIFT;
+		int cy0 = std::max(y0, 0) >> CHUNK_SHIFT;
+		int cx1 = std::min(x1 >> CHUNK_SHIFT, m_chunks_x - 1);
+		int cy1 = std::min(y1 >> CHUNK_SHIFT, m_chunks_y - 1);
+		for (int cy = cy0; cy <= cy1; cy++)
+			for (int cx = cx0; cx <= cx1; cx++)
+				f(cx, cy, m_chunks[cy * m_chunks_x + cx]);
+	}
+};
@@ -56,7 +56,17 @@ bool Timer::is_game_over()
     return false;
 }
 
+Timer::draw_state Timer::get_draw_state() const
+{
+    return {minutes, seconds};
+}
+
 void Timer::draw(const mat3 &projection)
+{
+    draw(projection, get_draw_state());
+}
+
+void Timer::draw(const mat3 &projection, const draw_state &state)
 {
     FT_Library ft_lib{nullptr};
     FT_Face face{nullptr};
@@ -115,15 +125,15 @@ void Timer::draw(const mat3 &projection)
 
     FT_Set_Pixel_Sizes(face, 0, 50);
     std::string secs;
-    if (seconds < 10)
-        secs = "0" + std::to_string(seconds);
-    else if (seconds >= 10)
-        secs = std::to_string(seconds);
+    if (state.seconds < 10)
+        secs = "0" + std::to_string(state.seconds);
+    else if (state.seconds >= 10)
+        secs = std::to_string(state.seconds);
     std::string mins;
-    if (minutes < 10)
-        mins = "0" + std::to_string(minutes);
-    else if (seconds >= 10)
-        mins = std::to_string(minutes);
+    if (state.minutes < 10)
+        mins = "0" + std::to_string(state.minutes);
+    else if (state.seconds >= 10)
+        mins = std::to_string(state.minutes);
 
     render_text(mins + ":" + secs, face, -0.2, 0.85, SCALEX, SCALEY);
 
@@ -13,10 +13,20 @@
 class Timer : public Entity
 {
 public:
+	// the countdown update shows, copied into the render snapshot
+	struct draw_state
+	{
+		int minutes;
+		int seconds;
+	};
+
 	bool init();
 	void destroy();
 	void update(float ms);
 	void draw(const mat3 &projection) override;
+	// GL thread, from the render snapshot
+	void draw(const mat3 &projection, const draw_state &state);
+	draw_state get_draw_state() const;
 	void render_text(const std::string &str, FT_Face face, float x, float y, float sx, float sy);
 	bool is_game_over();
 
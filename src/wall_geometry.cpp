@@ -0,0 +1,267 @@
+// header
+#include "wall_geometry.hpp"
+#include "constants.hpp"
+#include "tile_map.hpp"
+
+// stlib
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+// a moving point with its reciprocal, tested against many boxes
+struct segment
+{
+	vec2 origin;
+	vec2 delta;
+	vec2 inv;
+	vec2 min; // bounds of the move from t_from to t_to
+	vec2 max;
+};
+
+segment make_segment(vec2 origin, vec2 delta, float t_from, float t_to)
+{
+	vec2 from = add(origin, mul(delta, t_from));
+	vec2 to = add(origin, mul(delta, t_to));
+
+	segment s;
+	s.origin = origin;
+	s.delta = delta;
+	s.inv = {delta.x != 0.f ? 1.f / delta.x : 0.f, delta.y != 0.f ? 1.f / delta.y : 0.f};
+	s.min = {std::min(from.x, to.x), std::min(from.y, to.y)};
+	s.max = {std::max(from.x, to.x), std::max(from.y, to.y)};
+	return s;
+}
+
+// entry and exit times of the point through the open box, clipped to [t_enter, t_exit]
+// the bounds check rejects most boxes without a multiply and covers the axes the point
+// doesn't move along
+bool clip(const segment &s, vec2 min, vec2 max, float &t_enter, float &t_exit)
+{
+	if (s.max.x <= min.x || s.min.x >= max.x || s.max.y <= min.y || s.min.y >= max.y)
+		return false;
+
+	if (s.delta.x != 0.f)
+	{
+		float a = (min.x - s.origin.x) * s.inv.x;
+		float b = (max.x - s.origin.x) * s.inv.x;
+		t_enter = std::max(t_enter, std::min(a, b));
+		t_exit = std::min(t_exit, std::max(a, b));
+	}
+	if (s.delta.y != 0.f)
+	{
+		float a = (min.y - s.origin.y) * s.inv.y;
+		float b = (max.y - s.origin.y) * s.inv.y;
+		t_enter = std::max(t_enter, std::min(a, b));
+		t_exit = std::min(t_exit, std::max(a, b));
+	}
+	return t_enter < t_exit;
+}
+} // namespace
+
+void WallGeometry::build(const TileMap &tiles)
+{
+	vec2 size = {tiles.get_width() * TILE_SIZE, tiles.get_height() * TILE_SIZE};
+	m_rects.clear();
+	m_nodes.clear();
+
+	merge_tiles(tiles);
+
+	// the border, corners belong to the top and bottom rectangles
+	m_rects.push_back({{-TILE_SIZE, -TILE_SIZE}, {size.x + TILE_SIZE, 0.f}});
+	m_rects.push_back({{-TILE_SIZE, size.y}, {size.x + TILE_SIZE, size.y + TILE_SIZE}});
+	m_rects.push_back({{-TILE_SIZE, 0.f}, {0.f, size.y}});
+	m_rects.push_back({{size.x, 0.f}, {size.x + TILE_SIZE, size.y}});
+
+	build_tree();
+}
+
+// a new wall is a rectangle of its own, a removed one splits the rectangle that covered it
+// into the rows above and below and the parts of its row left and right of it
+void WallGeometry::update(const TileMap &tiles, int x, int y)
+{
+	vec2 min = {x * TILE_SIZE, y * TILE_SIZE};
+	vec2 max = {min.x + TILE_SIZE, min.y + TILE_SIZE};
+
+	if (tiles.is_wall(x, y))
+	{
+		m_rects.push_back({min, max});
+	}
+	else
+	{
+		vec2 center = {min.x + TILE_SIZE / 2, min.y + TILE_SIZE / 2};
+		for (size_t i = 0; i < m_rects.size(); i++)
+		{
+			wall_rect r = m_rects[i];
+			if (center.x < r.min.x || center.x > r.max.x || center.y < r.min.y || center.y > r.max.y)
+				continue;
+
+			m_rects[i] = m_rects.back();
+			m_rects.pop_back();
+			if (r.min.y < min.y)
+				m_rects.push_back({r.min, {r.max.x, min.y}});
+			if (max.y < r.max.y)
+				m_rects.push_back({{r.min.x, max.y}, r.max});
+			if (r.min.x < min.x)
+				m_rects.push_back({{r.min.x, min.y}, {min.x, max.y}});
+			if (max.x < r.max.x)
+				m_rects.push_back({{max.x, min.y}, {r.max.x, max.y}});
+			break;
+		}
+	}
+
+	build_tree();
+}
+
+void WallGeometry::build_tree()
+{
+	m_nodes.clear();
+	m_nodes.reserve(2 * m_rects.size() / LEAF_SIZE + 1);
+	m_nodes.push_back(bvh_node());
+	build_node(0, 0, (int)m_rects.size());
+}
+
+// greedy: each unmerged wall tile grows right along its row, then down while every
+// tile below the run is an unmerged wall
+void WallGeometry::merge_tiles(const TileMap &tiles)
+{
+	int width = tiles.get_width();
+	int height = tiles.get_height();
+	std::vector<bool> merged((size_t)width * height, false);
+
+	for (int y = 0; y < height; y++)
+	{
+		// rows without walls are skipped
+		if (!tiles.any_wall_in_row(y, 0, width - 1))
+			continue;
+
+		for (int x = 0; x < width; x++)
+		{
+			if (!tiles.is_wall(x, y) || merged[y * width + x])
+				continue;
+
+			int x1 = x;
+			while (x1 + 1 < width && tiles.is_wall(x1 + 1, y) && !merged[y * width + x1 + 1])
+				x1++;
+
+			int y1 = y;
+			while (y1 + 1 < height)
+			{
+				bool full = true;
+				for (int i = x; i <= x1 && full; i++)
+					full = tiles.is_wall(i, y1 + 1) && !merged[(y1 + 1) * width + i];
+				if (!full)
+					break;
+				y1++;
+			}
+
+			for (int j = y; j <= y1; j++)
+				for (int i = x; i <= x1; i++)
+					merged[j * width + i] = true;
+
+			m_rects.push_back({{x * TILE_SIZE, y * TILE_SIZE}, {(x1 + 1) * TILE_SIZE, (y1 + 1) * TILE_SIZE}});
+			x = x1;
+		}
+	}
+}
+
+// median split of the rectangle centers along the longer side of the node
+void WallGeometry::build_node(int node, int first, int count)
+{
+	vec2 min = m_rects[first].min;
+	vec2 max = m_rects[first].max;
+	for (int i = first + 1; i < first + count; i++)
+	{
+		min.x = std::min(min.x, m_rects[i].min.x);
+		min.y = std::min(min.y, m_rects[i].min.y);
+		max.x = std::max(max.x, m_rects[i].max.x);
+		max.y = std::max(max.y, m_rects[i].max.y);
+	}
+	m_nodes[node].min = min;
+	m_nodes[node].max = max;
+
+	if (count <= LEAF_SIZE)
+	{
+		m_nodes[node].first = first;
+		m_nodes[node].count = count;
+		return;
+	}
+
+	bool split_x = max.x - min.x >= max.y - min.y;
+	auto begin = m_rects.begin() + first;
+	std::nth_element(begin, begin + count / 2, begin + count, [split_x](const wall_rect &a, const wall_rect &b) {
+		return split_x ? a.min.x + a.max.x < b.min.x + b.max.x : a.min.y + a.max.y < b.min.y + b.max.y;
+	});
+
+	// children are allocated together, m_nodes may move
+	int left = (int)m_nodes.size();
+	m_nodes.resize(m_nodes.size() + 2);
+	m_nodes[node].first = left;
+	m_nodes[node].count = 0;
+	build_node(left, first, count / 2);
+	build_node(left + 1, first + count / 2, count - count / 2);
+}
+
+const std::vector<wall_rect> &WallGeometry::get_rects() const
+{
+	return m_rects;
+}
+
+int WallGeometry::get_node_count() const
+{
+	return (int)m_nodes.size();
+}
+
+// the center moves through every rectangle grown by the box's half extent
+bool WallGeometry::sweep(vec2 center, vec2 half_extent, vec2 delta, wall_hit &hit) const
+{
+	float length = len(delta);
+	if (length == 0.f)
+		return false;
+
+	// earliest accepted hit, slightly behind the start for boxes resting in a wall
+	float min_t = -CONTACT_SLOP / length;
+	bool found = false;
+	hit.t = 1.f;
+	hit.normal = {0.f, 0.f};
+
+	segment s = make_segment(center, delta, min_t, 1.f);
+	int stack[MAX_DEPTH];
+	int top = 0;
+	stack[top++] = 0;
+	while (top > 0)
+	{
+		const bvh_node &node = m_nodes[stack[--top]];
+		float node_enter = min_t;
+		float node_exit = hit.t;
+		if (!clip(s, sub(node.min, half_extent), add(node.max, half_extent), node_enter, node_exit))
+			continue;
+
+		if (node.count == 0)
+		{
+			stack[top++] = node.first;
+			stack[top++] = node.first + 1;
+			continue;
+		}
+		for (int i = node.first; i < node.first + node.count; i++)
+		{
+			vec2 min = sub(m_rects[i].min, half_extent);
+			vec2 max = add(m_rects[i].max, half_extent);
+			float t_enter = -INFINITY;
+			float t_exit = INFINITY;
+			// moving out of a wall or past it
+			if (!clip(s, min, max, t_enter, t_exit) || t_exit <= 0.f || t_enter < min_t || t_enter >= hit.t)
+				continue;
+
+			// the face crossed last is the one hit
+			float x_enter = delta.x != 0.f ? std::min((min.x - center.x) * s.inv.x, (max.x - center.x) * s.inv.x) : -INFINITY;
+			found = true;
+			hit.t = t_enter;
+			if (x_enter == t_enter)
+				hit.normal = {delta.x > 0.f ? -1.f : 1.f, 0.f};
+			else
+				hit.normal = {0.f, delta.y > 0.f ? -1.f : 1.f};
+		}
+	}
+	return found;
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+// internal
+#include "geometry.hpp"
+
+// stlib
+#include <vector>
+
+class TileMap;
+
+// wall tiles merged into rectangles, in pixels
+struct wall_rect
+{
+	vec2 min;
+	vec2 max;
+};
+
+// where a swept box first touches a wall, t is the fraction of the move
+// negative when the box already rests slightly inside the wall
+struct wall_hit
+{
+	float t;
+	vec2 normal; // points out of the wall, against the move
+};
+
+// the walls of a level as few axis aligned rectangles in a small BVH, built once per load and
+// patched per tile edit
+// rectangles are greedy: as wide as the wall run, then as tall as the rows below allow
+// four one tile thick rectangles around the level keep boxes inside like the tile queries do
+// touching a wall's edge never counts, only crossing into it
+class WallGeometry
+{
+public:
+	static constexpr int LEAF_SIZE = 4; // rectangles per leaf
+	static constexpr int MAX_DEPTH = 64; // traversal stack, far more than a median split needs
+
+	// a resting box may sink this far into a wall through float error and still collide
+	static constexpr float CONTACT_SLOP = 0.5f;
+
+private:
+	// leaf when count > 0: rectangles [first, first + count)
+	// otherwise children are nodes first and first + 1
+	struct bvh_node
+	{
+		vec2 min;
+		vec2 max;
+		int first;
+		int count;
+	};
+
+	std::vector<wall_rect> m_rects;
+	std::vector<bvh_node> m_nodes;
+
+private:
+	void merge_tiles(const TileMap &tiles);
+	void build_tree();
+	void build_node(int node, int first, int count);
+
+public:
+	void build(const TileMap &tiles);
+
+	// the tile at x, y became a wall or stopped being one, only the rectangle there changes
+	// and the BVH is rebuilt over the rectangles, tiles aren't merged again
+	void update(const TileMap &tiles, int x, int y);
+
+	const std::vector<wall_rect> &get_rects() const;
+	int get_node_count() const;
+
+	// the box moving by delta, false if it doesn't run into a wall
+	// otherwise the earliest hit, walls the box moves away from are ignored
+	bool sweep(vec2 center, vec2 half_extent, vec2 delta, wall_hit &hit) const;
+};
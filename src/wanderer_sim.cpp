@@ -0,0 +1,455 @@
+// header
+#include "wanderer_sim.hpp"
+#include "char_sim.hpp"
+#include "level_grid.hpp"
+
+// stlib
+#include <cmath>
+#include <cstdlib>
+
+// CONSTANTS
+const int CHASE_REFRESH_MS = 5000;
+const int CHASE_MAX_EXPANSIONS = 600;
+const int CHASE_MAX_PATH_LENGTH = 200;
+
+using namespace std;
+
+void WandererSim::init(vector<vec2> path, const LevelGrid &level, const CharSim &player)
+{
+	// Pathing AI init
+	m_level = &level;
+	m_player = &player;
+	m_path = path;
+	m_chase_planner.init(level);
+	m_chase_goal = {-1.f, -1.f};
+	set_position(LevelGrid::get_tile_center_coords(m_path[0]));
+	current_goal_index = 1;
+	current_immediate_goal_index = 1;
+	calculate_immediate_path(m_path[current_goal_index], 0);
+
+	motion.speed = config_speed;
+	physics.scale = {config_scale, config_scale};
+}
+
+void WandererSim::update(float ms)
+{
+	update_ai(ms);
+	update_animation(ms);
+}
+
+// pathing and movement only, safe to run off the main thread (no GL)
+void WandererSim::update_ai(float ms)
+{
+	if (!m_player->is_alive())
+	{
+		return;
+	}
+	if (alert_mode)
+	{
+		chase_refresh_timer -= ms;
+		vec2 player_tile = LevelGrid::get_grid_coords(m_player->get_position());
+		if (current_immediate_goal_index < immediate_path.size() && check_goal_arrival(LevelGrid::get_tile_center_coords(immediate_path[current_immediate_goal_index])) && !check_goal_arrival(player_tile))
+		{
+			current_immediate_goal_index++;
+		}
+		// the planner keeps its search between frames, so repairing on every goal tile change is cheap
+		bool goal_moved = player_tile.x != m_chase_goal.x || player_tile.y != m_chase_goal.y;
+		if (goal_moved || chase_refresh_timer < 0 || current_immediate_goal_index == immediate_path.size())
+		{
+			chase_refresh_timer = CHASE_REFRESH_MS;
+			calculate_chase_path(player_tile);
+		}
+	}
+	else
+	{
+		if (check_goal_arrival(LevelGrid::get_tile_center_coords(m_path[current_goal_index])))
+		{
+			current_goal_index = (current_goal_index + 1) % m_path.size();
+			start_patrol_leg();
+		}
+		else if (check_goal_arrival(LevelGrid::get_tile_center_coords(immediate_path[current_immediate_goal_index])))
+		{
+			current_immediate_goal_index++;
+		}
+	}
+	// ms may be accumulated over several ticks, the time left at a waypoint carries on to the next one
+	while (ms > 0.f && current_immediate_goal_index < immediate_path.size())
+	{
+		ms = move_towards_goal(LevelGrid::get_tile_center_coords(immediate_path[current_immediate_goal_index]), ms);
+		if (ms <= 0.f)
+			break;
+		current_immediate_goal_index++;
+		if (!alert_mode && current_immediate_goal_index >= immediate_path.size())
+		{
+			if (!check_goal_arrival(LevelGrid::get_tile_center_coords(m_path[current_goal_index])))
+				break;
+			current_goal_index = (current_goal_index + 1) % m_path.size();
+			start_patrol_leg();
+		}
+	}
+}
+
+// advances the sprite frame, Wanderer rebuilds the mesh on its next draw (GL thread)
+void WandererSim::update_animation(float ms)
+{
+	if (!m_player->is_alive())
+	{
+		return;
+	}
+
+	// sprite change
+	if (sprite_countdown > 0.f)
+		sprite_countdown -= ms * 2;
+
+	if (sprite_countdown < 0) {
+		if (frameIndex_x == 0) {
+			frameIndex_x = 1;
+		}
+		else if (frameIndex_x == 1) {
+			frameIndex_x = 2;
+			frameIndex_y = 10;
+		}
+		else if (frameIndex_x == 2) {
+			frameIndex_x = 0;
+			frameIndex_y = 11;
+
+		}
+		sprite_countdown = 200.f;
+	}
+}
+
+// far from the char: walks the patrol without searching or animating, ms may cover several tiles
+void WandererSim::update_coarse(float ms)
+{
+	if (alert_mode)
+	{
+		update_ai(ms);
+		return;
+	}
+	if (!m_player->is_alive())
+	{
+		return;
+	}
+
+	float distance = motion.speed * (ms / 1000);
+	while (distance > 0.f)
+	{
+		if (current_immediate_goal_index >= immediate_path.size())
+		{
+			if (!check_goal_arrival(LevelGrid::get_tile_center_coords(m_path[current_goal_index])))
+				break;
+			current_goal_index = (current_goal_index + 1) % m_path.size();
+			start_patrol_leg();
+			if (immediate_path.size() < 2)
+				break;
+		}
+
+		vec2 goal = LevelGrid::get_tile_center_coords(immediate_path[current_immediate_goal_index]);
+		vec2 delta = sub(goal, motion.position);
+		float d = len(delta);
+		if (d > distance)
+		{
+			motion.position = add(motion.position, mul(delta, distance / d));
+			break;
+		}
+		motion.position = goal;
+		distance -= d;
+		current_immediate_goal_index++;
+	}
+}
+
+// movement
+void WandererSim::set_position(vec2 position)
+{
+	motion.position = position;
+}
+
+vec2 WandererSim::get_position() const
+{
+	return motion.position;
+}
+
+sprite_state WandererSim::get_sprite_state() const
+{
+	return {motion.position, motion.radians, physics.scale, frameIndex_x, frameIndex_y};
+}
+
+// collision
+vec2 WandererSim::get_bounding_box() const
+{
+	return { std::fabs(physics.scale.x) * m_sheet_size.x * 0.5f * 0.00175f, std::fabs(physics.scale.y) * m_sheet_size.y * 0.5f * 0.24911032f };
+}
+
+// alert
+void WandererSim::set_alert_mode(bool val)
+{
+	if (!alert_mode && val)
+	{
+		motion.speed += 10.f;
+		alert_mode = val;
+		calculate_chase_path(LevelGrid::get_grid_coords(m_player->get_position()));
+		chase_refresh_timer = CHASE_REFRESH_MS;
+	}
+	else if (alert_mode && !val)
+	{
+		motion.speed = config_speed;
+		alert_mode = val;
+		current_immediate_goal_index = 0;
+		calculate_immediate_path(m_path[current_goal_index], 0);
+	}
+}
+
+bool WandererSim::get_alert_mode() const
+{
+	return alert_mode;
+}
+
+const chase_stats &WandererSim::get_chase_stats() const
+{
+	return m_chase_planner.get_stats();
+}
+
+// ai
+int WandererSim::calculate_immediate_path(vec2 goal, int limit_search)
+{
+	bool limit_set = limit_search != 0;
+	if (!limit_set)
+	{
+		limit_search = 1;
+	}
+
+	immediate_path.clear();
+	int expanded = 0;
+
+	vec2 grid_position = LevelGrid::get_grid_coords(motion.position);
+
+	vector<path_construction> paths_in_progress;
+	path_construction beginning;
+
+	beginning.path = {{grid_position}};
+	vector<vec2> visited_nodes = {{grid_position}};
+
+	beginning.heuristic = abs(grid_position.x - goal.x) + abs(grid_position.y - goal.y);
+	beginning.expected_total = beginning.heuristic;
+
+	paths_in_progress.push_back(beginning);
+
+	while (paths_in_progress[0].heuristic != 0 && limit_search > 0)
+	{
+		vector<path_construction> new_paths = find_paths_from(paths_in_progress[0], goal, visited_nodes);
+		expanded++;
+
+		for (path_construction path_const : new_paths)
+		{
+			visited_nodes.push_back(path_const.path[path_const.path.size() - 1]);
+		}
+
+		paths_in_progress.erase(paths_in_progress.begin());
+		paths_in_progress = merge_in_order(paths_in_progress, new_paths);
+
+		if (limit_set)
+		{
+			limit_search--;
+		}
+	}
+
+	immediate_path = paths_in_progress[0].path;
+	return expanded;
+}
+
+// patrol legs always start on a checkpoint tile, so the search result is reused every lap
+// until the level's walls change
+void WandererSim::start_patrol_leg()
+{
+	if (m_patrol_legs.size() != m_path.size() || m_patrol_revision != m_level->get_revision())
+	{
+		m_patrol_legs.assign(m_path.size(), {});
+		m_patrol_revision = m_level->get_revision();
+	}
+
+	vec2 tile = LevelGrid::get_grid_coords(motion.position);
+	std::vector<vec2> &leg = m_patrol_legs[current_goal_index];
+	if (!leg.empty() && leg[0].x == tile.x && leg[0].y == tile.y)
+	{
+		immediate_path = leg;
+	}
+	else
+	{
+		calculate_immediate_path(m_path[current_goal_index], 0);
+		leg = immediate_path;
+	}
+	current_immediate_goal_index = 1;
+}
+
+// incremental chase, falls back to the bounded search when the planner has no path yet
+void WandererSim::calculate_chase_path(vec2 goal)
+{
+	m_chase_goal = goal;
+	vec2 grid_position = LevelGrid::get_grid_coords(motion.position);
+
+	if (m_chase_planner.plan(grid_position, goal, CHASE_MAX_EXPANSIONS))
+	{
+		immediate_path = m_chase_planner.get_path(CHASE_MAX_PATH_LENGTH);
+	}
+	else
+	{
+		// only this fallback counts, patrol legs use the same search
+		chase_stats &stats = m_chase_planner.get_stats();
+		stats.full_replans++;
+		stats.full_replan_expanded += calculate_immediate_path(goal, 40);
+	}
+
+	current_immediate_goal_index = immediate_path.size() > 1 ? 1 : 0;
+}
+
+bool WandererSim::check_goal_arrival(vec2 goal)
+{
+	return fabs(goal.x - motion.position.x) < 5 && fabs(goal.y - motion.position.y) < 5;
+}
+
+// returns the ms left over once the goal is reached, 0 if it wasn't
+float WandererSim::move_towards_goal(vec2 goal, float ms)
+{
+	float step = -1.0 * motion.speed * (ms / 1000);
+	vec2 motionVector = {motion.position.x - goal.x, motion.position.y - goal.y};
+	float magnitude = std::sqrt((motionVector.x * motionVector.x) + (motionVector.y * motionVector.y));
+
+	// don't overshoot when ms was accumulated over several ticks
+	if (magnitude <= -step)
+	{
+		motion.position = goal;
+		if (motion.speed <= 0.f)
+			return 0.f;
+		return ms - magnitude / motion.speed * 1000;
+	}
+	motion.position.y += step * (motionVector.y / magnitude);
+	motion.position.x += step * (motionVector.x / magnitude);
+	return 0.f;
+}
+
+vector<path_construction> WandererSim::find_paths_from(path_construction origin, vec2 goal, vector<vec2> already_visited_nodes)
+{
+	vec2 point_of_origin = origin.path[origin.path.size() - 1];
+	vector<path_construction> return_list;
+	for (int x = 1; x > -2; x--)
+	{
+		for (int y = 1; y > -2; y--)
+		{
+			if (x == 0 && y == 0)
+			{
+				continue;
+			}
+
+			if (x != 0 && y != 0) // is diagonal from origin
+			{
+				if (!tile_is_accessible(point_of_origin, x, y))
+				{
+					continue;
+				}
+			}
+
+			path_construction new_path;
+			new_path.path = origin.path;
+			vec2 new_point = {point_of_origin.x + x, point_of_origin.y + y};
+			if (is_wall(new_point) || path_would_contain_cycles(new_path.path, new_point) || new_point_has_been_visited(already_visited_nodes, new_point))
+			{
+				continue;
+			}
+
+			new_path.path.push_back(new_point);
+			new_path.heuristic = abs(new_point.x - goal.x) + abs(new_point.y - goal.y);
+			new_path.expected_total = new_path.heuristic + origin.path.size();
+
+			if (return_list.empty())
+			{
+				return_list.insert(return_list.begin(), new_path);
+			}
+			else
+			{
+				int insertion_index = 0;
+				for (path_construction construction : return_list)
+				{
+					if (construction.expected_total > new_path.expected_total)
+					{
+						break;
+					}
+					else
+					{
+						insertion_index++;
+					}
+				}
+				return_list.insert(return_list.begin() + insertion_index, new_path);
+			}
+		}
+	}
+	return return_list;
+}
+
+vector<path_construction> WandererSim::merge_in_order(vector<path_construction> p1, vector<path_construction> p2)
+{
+	if (p1.empty())
+	{
+		return p2;
+	}
+	else if (p2.empty())
+	{
+		return p1;
+	}
+	int p1_index = 0;
+	int p2_index = 0;
+	vector<path_construction> return_list;
+
+	for (int i = 0; i < p1.size() + p2.size(); i++)
+	{
+		if (p1_index == p1.size())
+		{
+			return_list.push_back(p2[p2_index++]);
+		}
+		else if (p2_index == p2.size())
+		{
+			return_list.push_back(p1[p1_index++]);
+		}
+		else if (p1[p1_index].expected_total < p2[p2_index].expected_total)
+		{
+			return_list.push_back(p1[p1_index++]);
+		}
+		else
+		{
+			return_list.push_back(p2[p2_index++]);
+		}
+	}
+	return return_list;
+}
+
+bool WandererSim::tile_is_accessible(vec2 origin, int x_delta, int y_delta)
+{
+	return !is_wall({origin.x, origin.y + y_delta}) && !is_wall({origin.x + x_delta, origin.y});
+}
+
+bool WandererSim::is_wall(vec2 grid_coords) const
+{
+	return m_level->is_wall_tile((int)grid_coords.x, (int)grid_coords.y);
+}
+
+bool WandererSim::point_collection_contains_point(std::vector<vec2> collection, vec2 point)
+{
+	for (vec2 collection_point : collection)
+	{
+		if (collection_point.x == point.x && collection_point.y == point.y)
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+bool WandererSim::path_would_contain_cycles(std::vector<vec2> path, vec2 new_point)
+{
+	return point_collection_contains_point(path, new_point);
+}
+
+bool WandererSim::new_point_has_been_visited(std::vector<vec2> visited_nodes, vec2 new_point)
+{
+	return point_collection_contains_point(visited_nodes, new_point);
+}
+
@@ -0,0 +1,92 @@
+#pragma once
+
+// internal
+#include "body.hpp"
+#include "chase_planner.hpp"
+
+// stlib
+#include <vector>
+
+class CharSim;
+class LevelGrid;
+
+struct path_construction
+{
+	std::vector<vec2> path;
+	int heuristic;
+	int expected_total;
+};
+
+// guard type 1 : wanderer, patrol and chase pathing, no GL so it builds into chameleon_core
+// and runs headless, Wanderer draws it
+class WandererSim : public Body
+{
+protected:
+	// config
+	const float config_scale = 0.30f;
+	const float config_speed = 50.f;
+
+	// sheet the bounding box factors were fitted to, Wanderer sets the loaded texture's size
+	vec2 m_sheet_size = {240.f, 281.f};
+
+	// animation
+	float sprite_countdown = 200.f;
+	int frameIndex_x = 0;
+	int frameIndex_y = 11;
+
+private:
+	// pathing ai
+	const LevelGrid *m_level;
+	const CharSim *m_player;
+	std::vector<vec2> m_path;
+	std::vector<vec2> immediate_path;
+	int current_goal_index;
+	int current_immediate_goal_index;
+	bool alert_mode = false;
+	int chase_refresh_timer;
+	ChasePlanner m_chase_planner;
+	vec2 m_chase_goal;
+	std::vector<std::vector<vec2>> m_patrol_legs; // immediate path per checkpoint
+	unsigned int m_patrol_revision = 0; // LevelGrid revision the legs were searched on
+
+private:
+	// pathing ai
+	void calculate_chase_path(vec2 goal);
+	void start_patrol_leg();
+	bool check_goal_arrival(vec2 goal);
+	float move_towards_goal(vec2 goal, float ms);
+	std::vector<path_construction> find_paths_from(path_construction origin, vec2 goal, std::vector<vec2> already_visited_nodes);
+	std::vector<path_construction> merge_in_order(std::vector<path_construction> p1, std::vector<path_construction> p2);
+	bool tile_is_accessible(vec2 origin, int x_delta, int y_delta);
+	bool is_wall(vec2 grid_coords) const;
+	bool point_collection_contains_point(std::vector<vec2> collection, vec2 point);
+	bool path_would_contain_cycles(std::vector<vec2> path, vec2 new_point);
+	bool new_point_has_been_visited(std::vector<vec2> visited_nodes, vec2 new_point);
+
+public:
+	// path is the patrol checkpoints in tiles, the first one is the spawn
+	void init(std::vector<vec2> path, const LevelGrid &level, const CharSim &player);
+	void update(float ms);
+	void update_ai(float ms);
+	void update_animation(float ms);
+	void update_coarse(float ms);
+
+	// movement
+	void set_position(vec2 position);
+	vec2 get_position() const;
+	sprite_state get_sprite_state() const;
+
+	// collision
+	vec2 get_bounding_box() const;
+
+	// alert
+	void set_alert_mode(bool val);
+	bool get_alert_mode() const;
+
+	// pathing stats
+	const chase_stats &get_chase_stats() const;
+
+	// best-first search towards a tile, limit_search 0 runs to the goal, returns the nodes expanded
+	// public so chameleon_microbench can time it
+	int calculate_immediate_path(vec2 goal, int limit_search);
+};
@@ -3,16 +3,14 @@
 
 // stlib
 #include <string.h>
+#include <algorithm>
 #include <cassert>
+#include <chrono>
 #include <sstream>
 #include <iostream>
 
 namespace
 {
-// TODO -- need to remove
-const size_t MAX_SPOTTERS = 5;
-const size_t MAX_SHOOTERS = 5;
-
 const size_t MAX_COOLDOWN = 50;
 const size_t MAX_ALERT_MODE_COOLDOWN = 100;
 
@@ -20,10 +18,11 @@ const float FADE_TIME = 0.7;
 const float FLASH_TIME = 1.5;
 float pause_time = 0.f;
 
-// TODO -- need to remove after settings locs
-vector<vec2> spotter_loc;
-vector<vec2> spotter_loc_level_2;
-vec2 shooter_loc[5];
+// further than this in one update is a teleport (spawn, reset), not movement
+const float MAX_BLEND_DISTANCE = 2 * TILE_SIZE;
+
+// texture decodes get their own pool, the tick's waits would pick them up from m_jobs
+const int DECODE_WORKERS = 2;
 
 namespace
 {
@@ -31,17 +30,37 @@ void glfw_err_cb(int error, const char *desc)
 {
 	fprintf(stderr, "%d: %s", error, desc);
 }
+
+vec2 blend_position(vec2 previous, vec2 current, float alpha)
+{
+	vec2 delta = sub(current, previous);
+	if (sq_len(delta) > MAX_BLEND_DISTANCE * MAX_BLEND_DISTANCE)
+		return current;
+	return add(previous, mul(delta, alpha));
+}
 } // namespace
 } // namespace
 
-World::World() : m_control(0),
+World::World() : m_wanderer_reach(0.f),
+				 m_grid_guard_revision(0),
+				 m_grid_level_revision(0),
+				 m_prev_char_position({0.f, 0.f}),
+				 m_redraw_requested(true),
+				 m_drawn_state(QUIT),
+				 m_threaded(false),
+				 m_on_sim_thread(false),
+				 m_reset_pending(false),
+				 m_sim_tick(0),
+				 m_drawn_tick(0),
+				 m_sim_running(false),
+				 m_control(0),
+				 m_game_state(START_SCREEN),
 				 m_current_game_state(0),
 				 m_current_level_state(0),
 				 m_current_pause_state(0),
 				 m_current_game_won_state(2),
 				 m_current_game_over_state(1),
-				 m_paused(false),
-				 m_game_state(START_SCREEN)
+				 m_paused(false)
 {
 	// send rng with random device
 	m_rng = std::default_random_engine(std::random_device()());
@@ -52,29 +71,10 @@ World::~World()
 }
 
 // initialization
-bool World::init()
+bool World::init(bool visible)
 {
-	// TODO -- need static spawn of spotters per level
-	//spotter_loc[0] = m_map.get_tile_center_coords(vec2{ 1, 3 });
-	spotter_loc.push_back({100, 100});
-	spotter_loc.push_back({SCREEN_WIDTH - 100, 100});
-	spotter_loc.push_back({100, SCREEN_HEIGHT - 100});
-	spotter_loc.push_back({SCREEN_WIDTH - 100, SCREEN_HEIGHT - 100});
-	spotter_loc.push_back({800, 500});
-
-	// Level 2
-	spotter_loc_level_2.push_back({ (15 * 20) + 10, (13 * 20) + 10 });
-	spotter_loc_level_2.push_back({ (47 * 20) + 10, (15 * 20) + 10 });
-	spotter_loc_level_2.push_back({ (29 * 20) + 10, (17 * 20) + 10 });
-	spotter_loc_level_2.push_back({ (18 * 20) + 10, (26 * 20) + 10 });
-	spotter_loc_level_2.push_back({ (38 * 20) + 10, (26 * 20) + 10 });
-
-	// TODO
-	shooter_loc[0] = {100 + 100, 100 + 50};
-	shooter_loc[1] = {SCREEN_WIDTH - 50, 100 + 50};
-	shooter_loc[2] = {150, SCREEN_HEIGHT - 150};
-	shooter_loc[3] = {SCREEN_WIDTH - 50, SCREEN_HEIGHT - 50};
-	shooter_loc[4] = {850, 550};
+	m_jobs.init();
+	m_decode_jobs.init(DECODE_WORKERS);
 
 	// GLFW / OGL Initialization
 	// Core Opengl 3.
@@ -93,24 +93,56 @@ bool World::init()
 	glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
 #endif
 	glfwWindowHint(GLFW_RESIZABLE, 0);
+	glfwWindowHint(GLFW_VISIBLE, visible ? 1 : 0);
 	m_window = glfwCreateWindow((int)SCREEN_WIDTH, (int)SCREEN_HEIGHT, "The Chameleon", nullptr, nullptr);
 	if (m_window == nullptr)
 		return false;
 
 	glfwMakeContextCurrent(m_window);
-	glfwSwapInterval(1); // vsync
+	set_vsync(true);
 
 	// load OpenGL function pointers
 	gl3w_init();
 
+	// from here on textures decode on the workers
+	if (!m_texture_loader.init(m_decode_jobs))
+	{
+		fprintf(stderr, "Failed to initialize the texture loader");
+		return false;
+	}
+	Texture::loader = &m_texture_loader;
+	TextureManager::active = &m_textures;
+
+	// packed textures skip the decode altogether
+	if (m_texture_archive.open(data_path "/textures.pak"))
+		Texture::archive = &m_texture_archive;
+
 	// set callbacks to member functions (that's why the redirect is needed)
 	// input is handled using GLFW, for more info see
 	// http://www.glfw.org/docs/latest/input_guide.html
+	// in threaded mode events are queued for the simulation thread instead
 	glfwSetWindowUserPointer(m_window, this);
-	auto key_redirect = [](GLFWwindow *wnd, int _0, int _1, int _2, int _3) { ((World *)glfwGetWindowUserPointer(wnd))->on_key(wnd, _0, _1, _2, _3); };
-	auto cursor_pos_redirect = [](GLFWwindow *wnd, double _0, double _1) { ((World *)glfwGetWindowUserPointer(wnd))->on_mouse_move(wnd, _0, _1); };
+	auto key_redirect = [](GLFWwindow *wnd, int _0, int _1, int _2, int _3) {
+		World *world = (World *)glfwGetWindowUserPointer(wnd);
+		if (!world->m_threaded)
+		{
+			world->on_key(wnd, _0, _1, _2, _3);
+			world->m_redraw_requested = true;
+		}
+		else if (!world->m_input_queue.push({true, _0, _2, _3, 0.0, 0.0}))
+			fprintf(stderr, "Input queue full, key dropped\n");
+	};
+	auto cursor_pos_redirect = [](GLFWwindow *wnd, double _0, double _1) {
+		World *world = (World *)glfwGetWindowUserPointer(wnd);
+		if (!world->m_threaded)
+			world->on_mouse_move(wnd, _0, _1);
+		else
+			world->m_input_queue.push({false, 0, 0, 0, _0, _1});
+	};
+	auto refresh_redirect = [](GLFWwindow *wnd) { ((World *)glfwGetWindowUserPointer(wnd))->m_redraw_requested = true; };
 	glfwSetKeyCallback(m_window, key_redirect);
 	glfwSetCursorPosCallback(m_window, cursor_pos_redirect);
+	glfwSetWindowRefreshCallback(m_window, refresh_redirect);
 
 	// create a frame buffer
 	m_frame_buffer = 0;
@@ -122,6 +154,7 @@ bool World::init()
 	int fb_width, fb_height;
 	glfwGetFramebufferSize(m_window, &fb_width, &fb_height);
 	m_screen_scale = static_cast<float>(fb_width) / SCREEN_WIDTH;
+	m_framebuffer_size = {(float)fb_width, (float)fb_height};
 
 	// initialize the screen texture
 	m_screen_tex.create_from_screen(m_window);
@@ -186,6 +219,15 @@ bool World::init()
 // release all the associated resources
 void World::destroy()
 {
+	stop_simulation();
+	m_texture_loader.destroy();
+	Texture::loader = nullptr;
+	m_textures.destroy();
+	TextureManager::active = nullptr;
+	Texture::archive = nullptr;
+	m_texture_archive.close();
+	m_decode_jobs.destroy();
+	m_jobs.destroy();
 	glDeleteFramebuffers(1, &m_frame_buffer);
 
 	if (m_background_music != nullptr)
@@ -229,21 +271,26 @@ void World::destroy()
 // update our game world
 bool World::update(float ms)
 {
-	int w, h;
-	glfwGetFramebufferSize(m_window, &w, &h);
+	store_previous_positions();
+	if (!simulate(ms))
+		return true;
+	return sync_level();
+}
 
-	m_start_screen.update(m_current_game_state);
-	m_level_screen.update(m_current_level_state);
-	m_complete_screen.update(m_current_game_won_state);
-	m_gameover_screen.update(m_current_game_over_state);
+// gameplay for one tick, makes no GL calls so it can run on the simulation thread
+// returns false when the tick ended early (trophy picked up)
+bool World::simulate(float ms)
+{
 	m_cutscene.update();
-	m_pause_screen.update(m_current_pause_state);
 
 	//////////////////////
 	// COOLDOWN
 	//////////////////////
 	if (!m_paused)
 	{
+		if (grid_is_stale())
+			rebuild_grid();
+
 		if (m_alert_mode_cooldown < MAX_ALERT_MODE_COOLDOWN)
 		{
 			m_alert_mode_cooldown++;
@@ -258,12 +305,19 @@ bool World::update(float ms)
 			// unalert spotters
 			for (auto &spotter : m_spotters)
 				spotter.set_alert_mode(false);
-			// unalert wanderers
-			for (auto &wanderer : m_wanderers)
+			// unalert wanderers, only the ones near the char can keep the alert
+			if (m_alert_mode)
 			{
-				if (m_alert_mode)
+				m_grid.query_radius(m_char.get_position(), m_wanderer_reach * 5.f, 1 << SpatialGrid::WANDERER, m_grid_hits);
+				size_t hit = 0;
+				for (size_t i = 0; i < m_wanderers.size(); i++)
 				{
-					if (m_char.is_in_range(wanderer, m_map))
+					Wanderer &wanderer = m_wanderers[i];
+					bool candidate = hit < m_grid_hits.size() && m_grid_hits[hit].index == (int)i;
+					if (candidate)
+						hit++;
+
+					if (candidate && m_char.is_in_range(wanderer))
 					{
 						// fprintf(stderr, "alert mode active and in range \n");
 						stay_alert = true;
@@ -305,12 +359,17 @@ bool World::update(float ms)
 		//////////////////////
 
 		// collision, char-wall
-		m_map.check_wall(m_char, ms);
+		m_char.check_wall(ms);
+
+		// collision, char-guards, only overlapping grid entries are tested
+		m_grid.query_aabb(m_char.get_position(), m_char.get_bounding_box(), SpatialGrid::MASK_GUARDS, m_grid_hits);
 
 		// collision, char-wanderer
-		for (const auto &wanderer : m_wanderers)
+		for (const grid_entry &e : m_grid_hits)
 		{
-			if (m_char.is_colliding(wanderer) && is_char_detectable())
+			if (e.type != SpatialGrid::WANDERER)
+				continue;
+			if (m_char.is_colliding(m_wanderers[e.index]) && is_char_detectable())
 			{
 				if (m_char.is_alive())
 				{
@@ -330,15 +389,17 @@ bool World::update(float ms)
 				Mix_PlayChannel(-1, m_sfx_get_trophy, 0);
 				advance_to_cutscene();
 				m_char.kill();
-				return true;
+				return false;
 			}
 			m_char.kill();
 		}
 
 		// collision, char-spotter
-		for (const auto &spotter : m_spotters)
+		for (const grid_entry &e : m_grid_hits)
 		{
-			if (m_char.is_colliding(spotter) && is_char_detectable())
+			if (e.type != SpatialGrid::SPOTTER)
+				continue;
+			if (m_char.is_colliding(m_spotters[e.index]) && is_char_detectable())
 			{
 				if (m_char.is_alive())
 				{
@@ -350,8 +411,11 @@ bool World::update(float ms)
 		}
 
 		// proximity, char-shooter
-		for (auto &shooter : m_shooters)
+		for (const grid_entry &e : m_grid_hits)
 		{
+			if (e.type != SpatialGrid::SHOOTER)
+				continue;
+			Shooter &shooter = m_shooters[e.index];
 			if (m_char.is_colliding(shooter) && is_char_detectable())
 			{
 				if (m_char.is_alive())
@@ -381,7 +445,7 @@ bool World::update(float ms)
 		// proximity, spotter
 		for (auto &spotter : m_spotters)
 		{
-			if (spotter.is_in_sight(m_char, m_map) && is_char_detectable())
+			if (spotter.is_in_sight(m_char, m_map.get_level_grid()) && is_char_detectable())
 			{
 				if (m_char.is_alive())
 				{
@@ -403,104 +467,157 @@ bool World::update(float ms)
 			m_timer.update(ms);
 		// update char
 		m_char.update(ms);
-		m_hud.update(m_game_state, m_char.get_position());
 
-		// update wanderers
-		for (auto &wanderer : m_wanderers)
+		// guards away from the char tick less often, alert mode puts everyone back on full rate
+		m_ai_scheduler.begin_tick(m_char.get_position(), m_screen_point, m_screen_size);
+
+		// scheduling stays on this thread, the scheduler keeps per guard state
+		m_wanderer_runs.resize(m_wanderers.size());
+		m_wanderer_ms.resize(m_wanderers.size());
+		for (size_t i = 0; i < m_wanderers.size(); i++)
 		{
-			wanderer.update(ms * m_current_speed);
-			if (m_alert_mode)
-			{
-				if (m_char.is_in_alert_mode_range(wanderer))
-				{
-					// fprintf(stderr, "alert mode active and in range \n");
-					wanderer.set_alert_mode(true);
-				}
-				else
-				{
-					wanderer.set_alert_mode(false);
-				}
-			}
-			else
-			{
-				if (m_char.is_in_range(wanderer, m_map) && is_char_detectable() && !(m_char.is_dashing()))
-				{
-					// fprintf(stderr, "alert mode active and in range \n");
-					wanderer.set_alert_mode(true);
-				}
-				else
-				{
-					wanderer.set_alert_mode(false);
-				}
-			}
+			m_wanderer_ms[i] = ms * m_current_speed;
+			int row = m_broadphase_cache.find(SpatialGrid::WANDERER, (int)i);
+			m_wanderer_runs[i] = m_ai_scheduler.schedule(SpatialGrid::WANDERER, (int)i, m_broadphase_cache.position[row], m_alert_mode || m_broadphase_cache.alert[row], m_wanderer_ms[i]);
 		}
 
 		// update spotters
-		for (auto &spotter : m_spotters)
+		for (size_t i = 0; i < m_spotters.size(); i++)
 		{
-			spotter.update(ms * m_current_speed);
+			Spotter &spotter = m_spotters[i];
+			float spotter_ms = ms * m_current_speed;
+			// spotters only animate, a coarse run is the same update over the accumulated time
+			if (m_ai_scheduler.schedule(SpatialGrid::SPOTTER, (int)i, spotter.get_position(), m_alert_mode, spotter_ms) != AiScheduler::RUN_SKIP)
+				spotter.update(spotter_ms);
 		}
 
 		// update shooter
-		for (auto &shooter : m_shooters)
+		for (size_t i = 0; i < m_shooters.size(); i++)
 		{
+			Shooter &shooter = m_shooters[i];
+
 			// TODO -- wrong location for proper code flow
 			shooter.set_alert_mode(m_alert_mode);
 
 			// TODO
-			shooter.update(ms * m_current_speed);
-			// angle to shooter, alternative solution to save bullet angle as part of bullet struct
+			float shooter_ms = ms * m_current_speed;
+			if (m_ai_scheduler.schedule(SpatialGrid::SHOOTER, (int)i, shooter.get_position(), m_alert_mode || shooter.is_in_combat(), shooter_ms) != AiScheduler::RUN_SKIP)
+				shooter.update(shooter_ms);
+		}
 
-			// TODO
-			float angle = atan2((m_char.get_position().y - shooter.get_position().y), (m_char.get_position().x - shooter.get_position().x));
+		// wanderer pathing, wanderer perception and bullet integration run on the job system,
+		// alert changes are applied below in index order
+		float bullet_ms = ms * m_current_speed;
+		bool char_detectable = is_char_detectable() && !(m_char.is_dashing());
+		m_wanderer_seen.assign(m_wanderers.size(), 0);
 
-			// TODO -- wrong location for collision and code flow
-			if (shooter.is_in_combat())
+		m_tick_graph.clear();
+		int wanderer_ai = m_tick_graph.add("wanderer_ai", [this] {
+			m_jobs.parallel_for((int)m_wanderers.size(), 4, [this](int begin, int end) {
+				for (int i = begin; i < end; i++)
+				{
+					if (m_wanderer_runs[i] == AiScheduler::RUN_FULL)
+						m_wanderers[i].update_ai(m_wanderer_ms[i]);
+					else if (m_wanderer_runs[i] == AiScheduler::RUN_COARSE)
+						m_wanderers[i].update_coarse(m_wanderer_ms[i]);
+				}
+			});
+		});
+		int wanderer_animation = m_tick_graph.add("wanderer_animation", [this] {
+			for (size_t i = 0; i < m_wanderers.size(); i++)
 			{
-				shooter.bullets.update(ms * m_current_speed);
-				if (m_char.is_colliding(shooter.bullets))
+				if (m_wanderer_runs[i] == AiScheduler::RUN_FULL)
+					m_wanderers[i].update_animation(m_wanderer_ms[i]);
+			}
+		});
+		// wanderers outside the largest range can't see the char
+		int wanderer_perception = m_tick_graph.add("wanderer_perception", [this, char_detectable] {
+			insert_wanderers();
+			m_grid.query_radius(m_char.get_position(), m_wanderer_reach * (m_alert_mode ? 12.f : 5.f), 1 << SpatialGrid::WANDERER, m_grid_hits);
+			m_jobs.parallel_for((int)m_grid_hits.size(), 4, [this, char_detectable](int begin, int end) {
+				for (int h = begin; h < end; h++)
+				{
+					Wanderer &wanderer = m_wanderers[m_grid_hits[h].index];
+					if (m_alert_mode)
+						m_wanderer_seen[m_grid_hits[h].index] = m_char.is_in_alert_mode_range(wanderer);
+					else
+						m_wanderer_seen[m_grid_hits[h].index] = char_detectable && m_char.is_in_range(wanderer);
+				}
+			});
+		});
+		m_tick_graph.add("bullet_integration", [this, bullet_ms] {
+			m_jobs.parallel_for((int)m_shooters.size(), 1, [this, bullet_ms](int begin, int end) {
+				for (int i = begin; i < end; i++)
 				{
-					m_char.set_color(0);
-					m_cooldown = 0;
-					// m_char.change_position({15.f * cos(angle), 15.f * sin(angle)});
-					if ((angle >= -M_PI / 4) && (angle <= M_PI / 4))
-								{
-									m_char.change_direction(2);
-									m_char.set_direction('R', true);
-
-								}
-							else if ((angle > M_PI / 4) && (angle <= 3* M_PI / 4))
-								{
-									m_char.change_direction(1);
-									m_char.set_direction('D', true);
-								}
-							else if ((angle > 3 * M_PI / 4) || (angle <= 3 * -M_PI / 4))
-								{
-									m_char.change_direction(3);
-									m_char.set_direction('L', true);
-								}
-							else if ((angle > 3 * -M_PI / 4) && (angle < -M_PI/4))
-								{
-									m_char.change_direction(0);
-									m_char.set_direction('U', true);
-								}
-							m_char.set_dash(true);
+					if (m_shooters[i].is_in_combat())
+						m_shooters[i].bullets.update(bullet_ms);
 				}
+			});
+		});
+		m_tick_graph.depend(wanderer_animation, wanderer_ai);
+		m_tick_graph.depend(wanderer_perception, wanderer_ai);
+		m_tick_graph.run(m_jobs);
+
+		// merge
+		for (size_t i = 0; i < m_wanderers.size(); i++)
+			m_wanderers[i].set_alert_mode(m_wanderer_seen[i] != 0);
+
+		// collision, char-bullet, at most one hit per shooter
+		m_grid.clear(SpatialGrid::BULLET);
+		for (size_t i = 0; i < m_shooters.size(); i++)
+		{
+			if (!m_shooters[i].is_in_combat())
+				continue;
+			std::vector<Bullets::Bullet> &bullets = m_shooters[i].bullets.m_bullets;
+			for (size_t j = 0; j < bullets.size(); j++)
+				m_grid.insert(SpatialGrid::BULLET, (int)i, (int)j, bullets[j].position, {bullets[j].radius, bullets[j].radius});
+		}
+
+		m_grid.query_aabb(m_char.get_position(), m_char.get_bounding_box(), 1 << SpatialGrid::BULLET, m_grid_hits);
+		int last_shooter = -1;
+		for (const grid_entry &e : m_grid_hits)
+		{
+			if (e.index == last_shooter)
+				continue;
+
+			Shooter &shooter = m_shooters[e.index];
+			if (!m_char.is_colliding(shooter.bullets.m_bullets[e.sub]))
+				continue;
+			last_shooter = e.index;
+
+			// angle to shooter, alternative solution to save bullet angle as part of bullet struct
+			float angle = atan2((m_char.get_position().y - shooter.get_position().y), (m_char.get_position().x - shooter.get_position().x));
+
+			m_char.set_color(0);
+			m_cooldown = 0;
+			// m_char.change_position({15.f * cos(angle), 15.f * sin(angle)});
+			if ((angle >= -M_PI / 4) && (angle <= M_PI / 4))
+			{
+				m_char.change_direction(2);
+				m_char.set_direction('R', true);
+			}
+			else if ((angle > M_PI / 4) && (angle <= 3 * M_PI / 4))
+			{
+				m_char.change_direction(1);
+				m_char.set_direction('D', true);
+			}
+			else if ((angle > 3 * M_PI / 4) || (angle <= 3 * -M_PI / 4))
+			{
+				m_char.change_direction(3);
+				m_char.set_direction('L', true);
+			}
+			else if ((angle > 3 * -M_PI / 4) && (angle < -M_PI / 4))
+			{
+				m_char.change_direction(0);
+				m_char.set_direction('U', true);
 			}
+			m_char.set_dash(true);
 		}
 
 		//////////////////////
 		// DYNAMIC SPAWN
 		//////////////////////
 
-		if (m_particles_emitter.get_fade_time() > FADE_TIME)
-		{
-			m_particles_emitter.reset_fade_time();
-			m_particles_emitter.set_fade(0);
-			m_particles_emitter.destroy();
-			m_particles_emitter.init();
-		}
-
 		if (m_char.is_dashing())
 		{
 			if (m_char.is_wall_collision())
@@ -557,182 +674,233 @@ bool World::update(float ms)
 				m_char.set_dash(false);
 	}
 
-	//////////////////////
-	// RESET LEVEL
-	//////////////////////
 	if (m_game_state == LEVEL_1 || m_game_state == LEVEL_2 || m_game_state == LEVEL_3 || m_game_state == LEVEL_4 || m_game_state == LEVEL_5)
 		if (m_timer.is_game_over())
 			m_game_state = LOSE_SCREEN;
 
-	if (!m_char.is_alive() && m_map.get_char_dead_time() > 2)
+	return true;
+}
+
+// level upkeep that creates or frees GL objects, runs on the render thread
+bool World::sync_level()
+{
+	// faded particles get fresh buffers
+	if (!m_paused && m_particles_emitter.get_fade_time() > FADE_TIME)
 	{
-		reset_game();
+		m_particles_emitter.reset_fade_time();
+		m_particles_emitter.set_fade(0);
+		m_particles_emitter.destroy();
+		m_particles_emitter.init();
 	}
 
-	if (m_game_state == LEVEL_1)
+	//////////////////////
+	// RESET LEVEL
+	//////////////////////
+	if (m_reset_pending || (!m_char.is_alive() && m_map.get_char_dead_time() > 2))
 	{
-
-		//////////////////////
-		// DYNAMIC SPAWN
-		//////////////////////
-		if (!m_paused)
-		{
-			// spawn wanderer
-			while (m_wanderers.size() < wanderer_paths_level_1.size())
-			{
-				if (!spawn_wanderer(wanderer_paths_level_1[m_wanderers.size()]))
-					return false;
-
-				Wanderer& new_wanderer = m_wanderers.back();
-			}
-		}
+		m_reset_pending = false;
+		reset_game();
 	}
-	else if (m_game_state == LEVEL_2)
-	{
-
-		//////////////////////
-		// DYNAMIC SPAWN
-		//////////////////////
-
-		if (!m_paused)
-		{
-			// spawn spotter
-			// TODO -- need static spawns of spotters
-			while (m_spotters.size() < spotter_loc_level_2.size())
-			{
-				if (!spawn_spotter())
-					return false;
-
-				Spotter& new_spotter = m_spotters.back();
-
-				new_spotter.set_position(spotter_loc_level_2[m_spotters.size() - 1]);
 
-				if (m_spotters.size() == spotter_loc_level_2.size())
-				{
-					m_map.set_spotter_list(m_spotters);
-				}
-			}
+	//////////////////////
+	// TEXTURES
+	//////////////////////
+	// panels and tile sets picked during a tick are loaded here
+	m_cutscene.sync();
 
-			// spawn wanderer
-			while (m_wanderers.size() < wanderer_paths_level_2.size())
-			{
-				if (!spawn_wanderer(wanderer_paths_level_2[m_wanderers.size()]))
-					return false;
+	// the level's tiles are swapped in here, the next level's load while its cutscene plays
+	m_map.sync_theme();
+	if (m_game_state == STORY_SCREEN)
+		m_map.prefetch_theme(LEVEL_TUTORIAL);
+	else if (m_game_state % 1000 == 500)
+		m_map.prefetch_theme(m_game_state - 500);
 
-				Wanderer& new_wanderer = m_wanderers.back();
-			}
-		}
-	}
-	else if (m_game_state == LEVEL_3)
+	//////////////////////
+	// DYNAMIC SPAWN
+	//////////////////////
+	if (!m_paused && (m_game_state == LEVEL_1 || m_game_state == LEVEL_2 || m_game_state == LEVEL_3 || m_game_state == LEVEL_4 || m_game_state == LEVEL_5))
 	{
+		if (!spawn_level_guards())
+			return false;
+	}
 
-		//////////////////////
-		// DYNAMIC SPAWN
-		//////////////////////
+	return true;
+}
 
-		if (!m_paused)
-		{
-			// spawn wanderer
-			while (m_wanderers.size() < wanderer_paths.size())
-			{
-				if (!spawn_wanderer(wanderer_paths[m_wanderers.size()]))
-					return false;
+void World::set_vsync(bool enabled)
+{
+	glfwSwapInterval(enabled ? 1 : 0);
+}
 
-				Wanderer &new_wanderer = m_wanderers.back();
-			}
-		}
-	}
-	else if (m_game_state == LEVEL_4)
+bool World::start_level(unsigned int level)
+{
+	if (level != LEVEL_1 && level != LEVEL_2 && level != LEVEL_3 && level != LEVEL_4 && level != LEVEL_5)
 	{
+		fprintf(stderr, "Not a playable level: %u\n", level);
+		return false;
+	}
 
-		//////////////////////
-		// DYNAMIC SPAWN
-		//////////////////////
-
-		if (!m_paused)
-		{
-			// spawn spotter
-			// TODO -- need static spawns of spotters
-			if (m_spotters.size() < spotter_loc.size())
-			{
-				if (!spawn_spotter())
-					return false;
-
-				Spotter &new_spotter = m_spotters.back();
+	reset_game();
+	m_paused = false;
+	m_game_state = level;
+	m_level = level;
+	m_map.set_current_map(level);
+	m_char.set_position(m_map.get_spawn_pos());
+	return true;
+}
 
-				new_spotter.set_position(spotter_loc[m_spotters.size() - 1]);
+bool World::start_scenario(const Scenario &scenario)
+{
+	reset_game();
+	if (!m_map.load_scenario(scenario))
+		return false;
 
-				if (m_spotters.size() == spotter_loc.size())
-				{
-					m_map.set_spotter_list(m_spotters);
-				}
-			}
+	m_paused = false;
+	m_game_state = LEVEL_1;
+	m_level = LEVEL_1;
+	m_char.set_position(m_map.get_spawn_pos());
+	return true;
+}
 
-			// spawn wanderer
-			while (m_wanderers.size() < wanderer_paths_2.size())
-			{
-				if (!spawn_wanderer(wanderer_paths_2[m_wanderers.size()]))
-					return false;
+void World::inject_key(int key, int action, int mod)
+{
+	on_key(m_window, key, 0, action, mod);
+}
 
-				Wanderer &new_wanderer = m_wanderers.back();
-			}
-		}
-	}
-	else if (m_game_state == LEVEL_5)
+bool World::is_static_screen() const
+{
+	switch (m_game_state)
 	{
-		//////////////////////
-		// DYNAMIC SPAWN
-		//////////////////////
+	case START_SCREEN:
+	case CONTROL_SCREEN:
+	case LEVEL_SCREEN:
+	case STORY_SCREEN:
+	case PAUSE_SCREEN:
+	case WIN_SCREEN:
+	case LOSE_SCREEN:
+		return true;
+	default:
+		// LEVEL_N_CUTSCENE
+		return m_game_state % 1000 == 500;
+	}
+}
 
-		if (!m_paused)
-		{
-			// spawn spotter
-			// TODO -- need static spawn of spotters per level
-			if (m_spotters.size() < spotter_loc.size())
-			{
-				if (!spawn_spotter())
-					return false;
+bool World::needs_redraw() const
+{
+	return !is_static_screen() || m_redraw_requested || m_game_state != m_drawn_state || m_texture_loader.get_pending() > 0;
+}
 
-				Spotter &new_spotter = m_spotters.back();
+int World::get_pending_textures() const
+{
+	return m_texture_loader.get_pending();
+}
 
-				new_spotter.set_position(spotter_loc[m_spotters.size() - 1]);
+int World::get_packed_textures() const
+{
+	return m_texture_archive.get_count();
+}
 
-				if (m_spotters.size() == spotter_loc.size())
-				{
-					m_map.set_spotter_list(m_spotters);
-				}
-			}
+texture_residency World::get_texture_residency() const
+{
+	return m_textures.get_residency();
+}
 
-			// spawn shooter
-			if (m_shooters.size() < MAX_SHOOTERS)
-			{
-				if (!spawn_shooter())
-					return false;
-				Shooter &new_shooter = m_shooters.back();
+void World::set_texture_idle_time(float seconds)
+{
+	m_textures.set_idle_time(seconds);
+}
 
-				new_shooter.set_position(shooter_loc[m_shooters.size() - 1]);
-			}
+void World::set_texture_budget(size_t bytes)
+{
+	m_textures.set_unused_budget(bytes);
+}
 
-			// spawn wanderer
-			while (m_wanderers.size() < wanderer_paths_3.size())
-			{
-				if (!spawn_wanderer(wanderer_paths_3[m_wanderers.size()]))
-					return false;
+// render
+void World::draw(float alpha)
+{
+	// update runs on this thread, the snapshot is taken right before it's drawn
+	publish_snapshot(alpha);
+	m_snapshots.acquire();
+	draw_frame(m_snapshots.read_slot());
 
-				Wanderer &new_wanderer = m_wanderers.back();
-			}
+	// present
+	glfwSwapBuffers(m_window);
+}
+
+// copies what draw_frame reads, movers are put between their last two positions by alpha
+// and guards off camera are left out, the margin covers sprites larger than their box
+void World::publish_snapshot(float alpha)
+{
+	render_snapshot &frame = m_snapshots.write_slot();
+	frame.game_state = m_game_state;
+	frame.current_game_state = m_current_game_state;
+	frame.current_level_state = m_current_level_state;
+	frame.current_pause_state = m_current_pause_state;
+	frame.current_game_won_state = m_current_game_won_state;
+	frame.current_game_over_state = m_current_game_over_state;
+
+	bool blend = alpha < 1.f;
+	frame.char_state = m_char.get_draw_state();
+	if (blend)
+		frame.char_state.sprite.position = blend_position(m_prev_char_position, frame.char_state.sprite.position, alpha);
+
+	update_view(frame.char_state.sprite.position);
+	frame.view_point = m_screen_point;
+	frame.view_size = m_screen_size;
+
+	vec2 view_margin = {2 * TILE_SIZE, 2 * TILE_SIZE};
+	m_broadphase_cache.cull(sub(m_screen_point, view_margin), add(add(m_screen_point, m_screen_size), view_margin));
+	collect_guards(SpatialGrid::WANDERER, frame.wanderers);
+	collect_guards(SpatialGrid::SPOTTER, frame.spotters);
+	collect_guards(SpatialGrid::SHOOTER, frame.shooters);
+	if (blend)
+	{
+		for (guard_sprite &guard : frame.wanderers)
+		{
+			if (guard.index < (int)m_prev_wanderer_positions.size())
+				guard.sprite.position = blend_position(m_prev_wanderer_positions[guard.index], guard.sprite.position, alpha);
 		}
 	}
 
-	return true;
+	// bullets can travel off the shooter's screen area
+	size_t batches = 0;
+	for (size_t i = 0; i < m_shooters.size(); i++)
+	{
+		if (!m_shooters[i].is_in_combat())
+			continue;
+		if (batches == frame.bullets.size())
+			frame.bullets.emplace_back();
+		const std::vector<BulletsSim::Bullet> &bullets = m_shooters[i].bullets.m_bullets;
+		frame.bullets[batches].shooter = (int)i;
+		frame.bullets[batches].bullets.assign(bullets.begin(), bullets.end());
+		batches++;
+	}
+	frame.bullets.resize(batches);
+
+	m_particles_emitter.get_draw_state(frame.particles);
+	m_map.get_draw_state(frame.map);
+	frame.overlay = m_overlay.get_draw_state();
+	frame.timer = m_timer.get_draw_state();
+
+	m_snapshots.publish();
 }
 
-// render
+void World::store_previous_positions()
+{
+	m_prev_char_position = m_char.get_position();
+	m_prev_wanderer_positions.resize(m_wanderers.size());
+	for (size_t i = 0; i < m_wanderers.size(); i++)
+		m_prev_wanderer_positions[i] = m_wanderers[i].get_position();
+}
+
+// records the frame without presenting it
 // http://www.opengl-tutorial.org/intermediate-tutorials/tutorial-14-render-to-texture/
-void World::draw()
+void World::draw_frame(const render_snapshot &frame)
 {
+	// pixels decoded since the last frame
+	m_texture_loader.upload();
+	m_textures.collect();
 
-	// fprintf(stderr, "Timer - %f", glfwGetTime());
 	// clear error buffer
 	gl_flush_errors();
 
@@ -756,10 +924,19 @@ void World::draw()
 	glClearDepth(1.f);
 	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
-	mat3 projection_2D = calculateProjectionMatrix(w, h);
+	mat3 projection_2D = calculateProjectionMatrix(frame.view_point, frame.view_size);
+	m_map.set_view(frame.view_point, add(frame.view_point, frame.view_size));
+
+	// menus and the hud only depend on the snapshot, they're laid out here
+	m_start_screen.update(frame.current_game_state);
+	m_level_screen.update(frame.current_level_state);
+	m_complete_screen.update(frame.current_game_won_state);
+	m_gameover_screen.update(frame.current_game_over_state);
+	m_pause_screen.update(frame.current_pause_state);
+	m_hud.update(frame.game_state, frame.char_state.sprite.position);
 
 	// game state
-	switch (m_game_state)
+	switch (frame.game_state)
 	{
 	case START_SCREEN:
 		m_start_screen.draw(projection_2D);
@@ -771,17 +948,17 @@ void World::draw()
 		m_level_screen.draw(projection_2D);
 		break;
 	case STORY_SCREEN:
-		m_cutscene.draw(projection_2D, m_screen_size, m_screen_point);
+		m_cutscene.draw(projection_2D, frame.view_size, frame.view_point);
 		break;
 	case LEVEL_TUTORIAL:
 		// draw map
-		m_map.draw(projection_2D);
-		m_cutscene.draw(projection_2D, m_screen_size, m_screen_point);
+		m_map.draw(projection_2D, frame.map);
+		m_cutscene.draw(projection_2D, frame.view_size, frame.view_point);
 
-		if (m_map.get_flash() == 0)
+		if (frame.map.flash == 0)
 		{
-			m_char.draw(projection_2D);
-			m_particles_emitter.draw(projection_2D);
+			m_char.draw(projection_2D, frame.char_state);
+			m_particles_emitter.draw(projection_2D, frame.particles);
 		}
 
 		m_hud.draw(projection_2D);
@@ -794,32 +971,31 @@ void World::draw()
 		glBindTexture(GL_TEXTURE_2D, m_screen_tex.id);
 		break;
 	case LEVEL_1_CUTSCENE:
-		m_cutscene.draw(projection_2D, m_screen_size, m_screen_point);
+		m_cutscene.draw(projection_2D, frame.view_size, frame.view_point);
 		break;
 	case LEVEL_2_CUTSCENE:
-		m_cutscene.draw(projection_2D, m_screen_size, m_screen_point);
+		m_cutscene.draw(projection_2D, frame.view_size, frame.view_point);
 		break;
 	case LEVEL_3_CUTSCENE:
-		m_cutscene.draw(projection_2D, m_screen_size, m_screen_point);
+		m_cutscene.draw(projection_2D, frame.view_size, frame.view_point);
 		break;
 	case LEVEL_1:
 		// draw map
-		m_map.draw(projection_2D);
-		if (m_map.get_flash() == 0)
+		m_map.draw(projection_2D, frame.map);
+		if (frame.map.flash == 0)
 		{
 			// draw entities
-			for (auto& wanderer : m_wanderers)
-				wanderer.draw(projection_2D);
+			draw_guards(SpatialGrid::WANDERER, frame, projection_2D);
 			// draw entities
-			m_char.draw(projection_2D);
-			m_particles_emitter.draw(projection_2D);
+			m_char.draw(projection_2D, frame.char_state);
+			m_particles_emitter.draw(projection_2D, frame.particles);
 		}
 
-		m_overlay.draw(projection_2D);
+		m_overlay.draw(projection_2D, frame.overlay);
 		m_hud.draw(projection_2D);
 //m_hud.draw(projection_2D, m_screen_size, m_screen_point);
 		// draw timer
-		m_timer.draw(projection_2D);
+		m_timer.draw(projection_2D, frame.timer);
 
 		// bind our texture in Texture Unit 0
 		glActiveTexture(GL_TEXTURE0);
@@ -827,23 +1003,21 @@ void World::draw()
 		break;
 	case LEVEL_2:
 		// draw map
-		m_map.draw(projection_2D);
-		if (m_map.get_flash() == 0)
+		m_map.draw(projection_2D, frame.map);
+		if (frame.map.flash == 0)
 		{
 			// draw entities
-			for (auto& wanderer : m_wanderers)
-				wanderer.draw(projection_2D);
-			for (auto& spotter : m_spotters)
-				spotter.draw(projection_2D);
-			m_char.draw(projection_2D);
-			m_particles_emitter.draw(projection_2D);
+			draw_guards(SpatialGrid::WANDERER, frame, projection_2D);
+			draw_guards(SpatialGrid::SPOTTER, frame, projection_2D);
+			m_char.draw(projection_2D, frame.char_state);
+			m_particles_emitter.draw(projection_2D, frame.particles);
 		}
 
-		m_overlay.draw(projection_2D);
+		m_overlay.draw(projection_2D, frame.overlay);
 		m_hud.draw(projection_2D);
 //m_hud.draw(projection_2D, m_screen_size, m_screen_point);
 		// draw timer
-		m_timer.draw(projection_2D);
+		m_timer.draw(projection_2D, frame.timer);
 
 		// bind our texture in Texture Unit 0
 		glActiveTexture(GL_TEXTURE0);
@@ -851,21 +1025,20 @@ void World::draw()
 		break;
 	case LEVEL_3:
 		// draw map
-		m_map.draw(projection_2D);
-		if (m_map.get_flash() == 0)
+		m_map.draw(projection_2D, frame.map);
+		if (frame.map.flash == 0)
 		{
 			// draw entities
-			for (auto &wanderer : m_wanderers)
-				wanderer.draw(projection_2D);
-			m_char.draw(projection_2D);
-			m_particles_emitter.draw(projection_2D);
+			draw_guards(SpatialGrid::WANDERER, frame, projection_2D);
+			m_char.draw(projection_2D, frame.char_state);
+			m_particles_emitter.draw(projection_2D, frame.particles);
 		}
 
-		m_overlay.draw(projection_2D);
+		m_overlay.draw(projection_2D, frame.overlay);
 		m_hud.draw(projection_2D);
 //m_hud.draw(projection_2D, m_screen_size, m_screen_point);
 		// draw timer
-		m_timer.draw(projection_2D);
+		m_timer.draw(projection_2D, frame.timer);
 
 		// bind our texture in Texture Unit 0
 		glActiveTexture(GL_TEXTURE0);
@@ -873,24 +1046,22 @@ void World::draw()
 		break;
 	case LEVEL_4:
 		// draw map
-		m_map.draw(projection_2D);
+		m_map.draw(projection_2D, frame.map);
 
-		if (m_map.get_flash() == 0)
+		if (frame.map.flash == 0)
 		{
 			// draw entities
-			for (auto &spotter : m_spotters)
-				spotter.draw(projection_2D);
-			for (auto &wanderer : m_wanderers)
-				wanderer.draw(projection_2D);
-			m_char.draw(projection_2D);
-			m_particles_emitter.draw(projection_2D);
+			draw_guards(SpatialGrid::SPOTTER, frame, projection_2D);
+			draw_guards(SpatialGrid::WANDERER, frame, projection_2D);
+			m_char.draw(projection_2D, frame.char_state);
+			m_particles_emitter.draw(projection_2D, frame.particles);
 		}
 
-		m_overlay.draw(projection_2D);
+		m_overlay.draw(projection_2D, frame.overlay);
 		m_hud.draw(projection_2D);
 //m_hud.draw(projection_2D, m_screen_size, m_screen_point);
 		// draw timer
-		m_timer.draw(projection_2D);
+		m_timer.draw(projection_2D, frame.timer);
 
 		// bind our texture in Texture Unit 0
 		glActiveTexture(GL_TEXTURE0);
@@ -898,32 +1069,27 @@ void World::draw()
 		break;
 	case LEVEL_5:
 		// draw map
-		m_map.draw(projection_2D);
+		m_map.draw(projection_2D, frame.map);
 
-		if (m_map.get_flash() == 0)
+		if (frame.map.flash == 0)
 		{
 			// draw entities
-			for (auto &spotter : m_spotters)
-				spotter.draw(projection_2D);
-			for (auto &wanderer : m_wanderers)
-				wanderer.draw(projection_2D);
-			for (auto &shooter : m_shooters)
-			{
-				shooter.draw(projection_2D);
-				if (shooter.is_in_combat())
-				{
-					shooter.bullets.draw(projection_2D);
-				}
-			}
-			m_char.draw(projection_2D);
-			m_particles_emitter.draw(projection_2D);
+			draw_guards(SpatialGrid::SPOTTER, frame, projection_2D);
+			draw_guards(SpatialGrid::WANDERER, frame, projection_2D);
+			draw_guards(SpatialGrid::SHOOTER, frame, projection_2D);
+
+			// bullets can travel off the shooter's screen area
+			for (const shooter_bullets &batch : frame.bullets)
+				m_shooters[batch.shooter].bullets.draw(projection_2D, batch.bullets);
+			m_char.draw(projection_2D, frame.char_state);
+			m_particles_emitter.draw(projection_2D, frame.particles);
 		}
 
-		m_overlay.draw(projection_2D);
+		m_overlay.draw(projection_2D, frame.overlay);
 		m_hud.draw(projection_2D);
 //m_hud.draw(projection_2D, m_screen_size, m_screen_point);
 		// draw timer
-		m_timer.draw(projection_2D);
+		m_timer.draw(projection_2D, frame.timer);
 
 		// bind our texture in Texture Unit 0
 		glActiveTexture(GL_TEXTURE0);
@@ -943,12 +1109,14 @@ void World::draw()
 		exit(0);
 	}
 
-	// present
-	glfwSwapBuffers(m_window);
+	m_redraw_requested = false;
+	m_drawn_state = frame.game_state;
 }
 
-mat3 World::calculateProjectionMatrix(int width, int height)
+void World::update_view(vec2 char_position)
 {
+	float width = m_framebuffer_size.x;
+	float height = m_framebuffer_size.y;
 	float left = 0.f; // *-0.5;
 	float top = 0.f;  // (float)h * -0.5;
 	float right = 0.f;
@@ -956,20 +1124,28 @@ mat3 World::calculateProjectionMatrix(int width, int height)
 
 	if (m_game_state != START_SCREEN && m_game_state % 1000 == 0)
 	{
-		left = m_char.get_position().x - ((float)width / (PROJECTION_SCALE * m_screen_scale));
-		top = m_char.get_position().y - ((float)height / (PROJECTION_SCALE * m_screen_scale));
-		right = m_char.get_position().x + ((float)width / (PROJECTION_SCALE * m_screen_scale));
-		bottom = m_char.get_position().y + ((float)height / (PROJECTION_SCALE * m_screen_scale));
+		left = char_position.x - (width / (PROJECTION_SCALE * m_screen_scale));
+		top = char_position.y - (height / (PROJECTION_SCALE * m_screen_scale));
+		right = char_position.x + (width / (PROJECTION_SCALE * m_screen_scale));
+		bottom = char_position.y + (height / (PROJECTION_SCALE * m_screen_scale));
 	}
 	else
 	{
-		right = (float)width / m_screen_scale;   // *0.5;
-		bottom = (float)height / m_screen_scale; // *0.5;
+		right = width / m_screen_scale;   // *0.5;
+		bottom = height / m_screen_scale; // *0.5;
 	}
 
 	// overlay reference info
 	m_screen_size = vec2({right - left, bottom - top});
 	m_screen_point = vec2({left, top});
+}
+
+mat3 World::calculateProjectionMatrix(vec2 view_point, vec2 view_size) const
+{
+	float left = view_point.x;
+	float top = view_point.y;
+	float right = view_point.x + view_size.x;
+	float bottom = view_point.y + view_size.y;
 
 	float sx = 2.f / (right - left);
 	float sy = 2.f / (top - bottom);
@@ -984,12 +1160,14 @@ bool World::is_over() const
 }
 
 // spawn spotter
-bool World::spawn_spotter()
+bool World::spawn_spotter(vec2 position)
 {
 	Spotter spotter;
 	if (spotter.init())
 	{
+		spotter.set_position(position);
 		m_spotters.emplace_back(spotter);
+		m_broadphase_cache.create(SpatialGrid::SPOTTER, (int)m_spotters.size() - 1, position, spotter.get_bounding_box());
 		return true;
 	}
 	fprintf(stderr, "Failed to spawn spotter");
@@ -997,13 +1175,15 @@ bool World::spawn_spotter()
 }
 
 // spawn spotter
-bool World::spawn_shooter()
+bool World::spawn_shooter(vec2 position)
 {
 	Shooter shooter;
 	if (shooter.init())
 	{
 		shooter.bullets.init();
+		shooter.set_position(position);
 		m_shooters.emplace_back(shooter);
+		m_broadphase_cache.create(SpatialGrid::SHOOTER, (int)m_shooters.size() - 1, position, shooter.get_bounding_box());
 		return true;
 	}
 	fprintf(stderr, "Failed to spawn spotter");
@@ -1017,12 +1197,45 @@ bool World::spawn_wanderer(std::vector<vec2> path)
 	if (wanderer.init(path, m_map, m_char))
 	{
 		m_wanderers.emplace_back(wanderer);
+		m_broadphase_cache.create(SpatialGrid::WANDERER, (int)m_wanderers.size() - 1, wanderer.get_position(), wanderer.get_bounding_box());
 		return true;
 	}
 	fprintf(stderr, "Failed to spawn wanderer");
 	return false;
 }
 
+// every guard the level file places, missing ones are respawned
+bool World::spawn_level_guards()
+{
+	const LevelGrid &grid = m_map.get_level_grid();
+
+	level_span<vec2> spotters = grid.get_spotters();
+	while ((int)m_spotters.size() < spotters.count)
+	{
+		if (!spawn_spotter(spotters.data[m_spotters.size()]))
+			return false;
+
+		m_spotters.back().compute_visibility(m_map.get_level_grid());
+
+		if ((int)m_spotters.size() == spotters.count)
+			m_map.set_spotter_list(m_spotters);
+	}
+
+	level_span<vec2> shooters = grid.get_shooters();
+	while ((int)m_shooters.size() < shooters.count)
+	{
+		if (!spawn_shooter(shooters.data[m_shooters.size()]))
+			return false;
+	}
+
+	while ((int)m_wanderers.size() < grid.get_patrol_count())
+	{
+		if (!spawn_wanderer(grid.get_patrol((int)m_wanderers.size())))
+			return false;
+	}
+	return true;
+}
+
 // key callback function
 void World::on_key(GLFWwindow *, int key, int, int action, int mod)
 {
@@ -1464,6 +1677,10 @@ void World::on_key(GLFWwindow *, int key, int, int action, int mod)
 		m_current_speed += 0.1f;
 
 	m_current_speed = fmax(0.f, m_current_speed);
+
+	// texture residency
+	if (action == GLFW_RELEASE && (mod & GLFW_MOD_SHIFT) && key == GLFW_KEY_T)
+		m_textures.print_residency(stdout);
 }
 
 void World::on_mouse_move(GLFWwindow *window, double xpos, double ypos)
@@ -1555,6 +1772,206 @@ void World::on_mouse_move(GLFWwindow *window, double xpos, double ypos)
 	}
 }
 
+void World::set_ai_budget(const lod_budget &budget)
+{
+	m_ai_scheduler.set_budget(budget);
+}
+
+const lod_stats &World::get_ai_stats() const
+{
+	return m_ai_scheduler.get_stats();
+}
+
+const std::vector<job_timing> &World::get_job_timings() const
+{
+	return m_tick_graph.get_timings();
+}
+
+void World::start_simulation(float tick_ms)
+{
+	if (m_threaded)
+		return;
+
+	m_threaded = true;
+	m_sim_running = true;
+	m_sim_thread = std::thread(&World::simulation_loop, this, tick_ms);
+}
+
+void World::stop_simulation()
+{
+	if (!m_threaded)
+		return;
+
+	m_sim_running = false;
+	m_sim_thread.join();
+	m_threaded = false;
+}
+
+// draws only when the simulation finished a new tick, from the snapshot it published,
+// drawing and presenting (vsync) happen outside the world lock and overlap the next tick
+bool World::render_frame()
+{
+	int tick = m_sim_tick.load();
+	if (tick == m_drawn_tick)
+		return true;
+	m_drawn_tick = tick;
+
+	{
+		std::unique_lock<std::mutex> lock(m_world_mutex);
+		if (m_game_state == QUIT)
+		{
+			lock.unlock();
+			destroy();
+			exit(0);
+		}
+
+		// spawns and resets change the guard vectors the snapshot indexes, a fresh one
+		// replaces it before anything is drawn
+		unsigned int guards = m_broadphase_cache.get_revision();
+		if (!sync_level())
+			return false;
+		if (m_broadphase_cache.get_revision() != guards)
+			publish_snapshot();
+		if (!needs_redraw())
+			return true;
+	}
+
+	m_snapshots.acquire();
+	const render_snapshot &frame = m_snapshots.read_slot();
+	// a quit published after the check above is handled under the lock on the next call
+	if (frame.game_state == QUIT)
+		return true;
+	draw_frame(frame);
+
+	glfwSwapBuffers(m_window);
+	return true;
+}
+
+// fixed rate ticks, a tick that runs late pushes the schedule back instead of bursting to catch up
+void World::simulation_loop(float tick_ms)
+{
+	using Clock = std::chrono::steady_clock;
+	const Clock::duration tick = std::chrono::microseconds((long long)(tick_ms * 1000.f));
+	Clock::time_point next = Clock::now();
+
+	while (m_sim_running)
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_world_mutex);
+			m_on_sim_thread = true;
+
+			input_event e;
+			bool had_input = false;
+			while (m_input_queue.pop(e))
+			{
+				had_input = true;
+				if (e.is_key)
+					on_key(m_window, e.key, 0, e.action, e.mod);
+				else
+					on_mouse_move(m_window, e.x, e.y);
+			}
+			if (had_input)
+				m_redraw_requested = true;
+
+			// the render thread finishes a requested reset before the next tick,
+			// static screens only change on input
+			if (!m_reset_pending && m_game_state != QUIT && (had_input || !is_static_screen()))
+				simulate(tick_ms);
+
+			m_on_sim_thread = false;
+			publish_snapshot();
+		}
+		m_sim_tick++;
+
+		next += tick;
+		Clock::time_point now = Clock::now();
+		if (next < now)
+			next = now;
+		else
+			std::this_thread::sleep_until(next);
+	}
+}
+
+// wanderers are the only guards that move or change alert state on their own, spotters
+// and shooters keep the row they were registered with at spawn
+void World::sync_wanderers()
+{
+	for (size_t i = 0; i < m_wanderers.size(); i++)
+	{
+		int row = m_broadphase_cache.find(SpatialGrid::WANDERER, (int)i);
+		m_broadphase_cache.position[row] = m_wanderers[i].get_position();
+		m_broadphase_cache.alert[row] = m_wanderers[i].get_alert_mode();
+	}
+}
+
+// guards left in view by the last cull
+void World::collect_guards(int guard_type, std::vector<guard_sprite> &out)
+{
+	m_broadphase_cache.collect_visible(guard_type, m_draw_list);
+	out.clear();
+	for (int i : m_draw_list)
+	{
+		if (guard_type == SpatialGrid::WANDERER)
+			out.push_back({i, m_wanderers[i].get_sprite_state()});
+		else if (guard_type == SpatialGrid::SPOTTER)
+			out.push_back({i, m_spotters[i].get_sprite_state()});
+		else if (guard_type == SpatialGrid::SHOOTER)
+			out.push_back({i, m_shooters[i].get_sprite_state()});
+	}
+}
+
+void World::draw_guards(int guard_type, const render_snapshot &frame, const mat3 &projection)
+{
+	if (guard_type == SpatialGrid::WANDERER)
+	{
+		for (const guard_sprite &guard : frame.wanderers)
+			m_wanderers[guard.index].draw(projection, guard.sprite);
+	}
+	else if (guard_type == SpatialGrid::SPOTTER)
+	{
+		for (const guard_sprite &guard : frame.spotters)
+			m_spotters[guard.index].draw(projection, guard.sprite);
+	}
+	else if (guard_type == SpatialGrid::SHOOTER)
+	{
+		for (const guard_sprite &guard : frame.shooters)
+			m_shooters[guard.index].draw(projection, guard.sprite);
+	}
+}
+
+// wanderers are kept current by the perception job, so only spawns, resets and level
+// loads need the whole grid again
+bool World::grid_is_stale() const
+{
+	return m_grid_guard_revision != m_broadphase_cache.get_revision() || m_grid_level_revision != m_map.get_level_grid().get_revision();
+}
+
+// guards are inserted with their collision box, wanderers are reinserted after they move
+void World::rebuild_grid()
+{
+	const LevelGrid &level = m_map.get_level_grid();
+	m_grid.resize(level.get_width(), level.get_height());
+	m_grid.clear();
+	m_broadphase_cache.submit(m_grid, (1 << SpatialGrid::SPOTTER) | (1 << SpatialGrid::SHOOTER));
+	insert_wanderers();
+	m_grid_guard_revision = m_broadphase_cache.get_revision();
+	m_grid_level_revision = level.get_revision();
+}
+
+void World::insert_wanderers()
+{
+	sync_wanderers();
+	m_grid.clear(SpatialGrid::WANDERER);
+	m_broadphase_cache.submit(m_grid, 1 << SpatialGrid::WANDERER);
+
+	m_wanderer_reach = 0.f;
+	for (int row = 0; row < m_broadphase_cache.size(); row++)
+	{
+		if (m_broadphase_cache.type[row] == SpatialGrid::WANDERER)
+			m_wanderer_reach = std::max(m_wanderer_reach, m_char.get_range(m_broadphase_cache.half_extent[row], 1.f));
+	}
+}
+
 bool World::is_char_detectable()
 {
 	return m_alert_mode || !(!m_char.is_moving() && (m_map.get_tile_type(m_char.get_position()) == m_char.get_color() + 1));
@@ -1596,12 +2013,21 @@ void World::advance_to_cutscene()
 
 void World::reset_game()
 {
+	// recreates GL objects, a tick asks the render thread to do it
+	if (m_on_sim_thread)
+	{
+		m_reset_pending = true;
+		return;
+	}
+
 	m_char.destroy();
 	m_char.init(m_map.get_spawn_pos(), m_map);
 	m_char.reset_stealth();
 	m_spotters.clear();
 	m_wanderers.clear();
 	m_shooters.clear();
+	m_broadphase_cache.clear();
+	m_ai_scheduler.reset();
 	m_map.reset_char_dead_time();
 	m_current_speed = 1.f;
 	m_overlay.destroy();
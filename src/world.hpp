@@ -1,40 +1,106 @@
 #pragma once
 
 // internal
+#include "ai_scheduler.hpp"
+#include "asset_archive.hpp"
 #include "common.hpp"
 #include "constants.hpp"
 
 #include "char.hpp"
 #include "complete_screen.hpp"
 #include "control_screen.hpp"
+#include "broadphase_cache.hpp"
 #include "cutscene.hpp"
+#include "frame_sync.hpp"
 #include "hud.hpp"
+#include "job_system.hpp"
 #include "level_screen.hpp"
 #include "map.hpp"
 #include "overlay.hpp"
 #include "particles.hpp"
+#include "scenario.hpp"
 #include "shooter.hpp"
+#include "spatial_grid.hpp"
 #include "spotter.hpp"
 #include "start_screen.hpp"
+#include "texture_loader.hpp"
+#include "texture_manager.hpp"
 #include "wanderer.hpp"
 #include "pause_screen.hpp"
 #include "gameover_screen.hpp"
 #include "timer.hpp"
 
 // stlib
-#include <vector>
+#include <atomic>
+#include <mutex>
 #include <random>
+#include <thread>
+#include <vector>
 
 #define SDL_MAIN_HANDLED
 #include <SDL.h>
 #include <SDL_mixer.h>
 
+// input captured by the GLFW callbacks, replayed on the simulation thread
+struct input_event
+{
+	bool is_key; // otherwise a cursor move
+	int key;
+	int action;
+	int mod;
+	double x;
+	double y;
+};
+
+// a guard on screen when the snapshot was taken, index into World's vector of its type
+struct guard_sprite
+{
+	int index;
+	sprite_state sprite;
+};
+
+// the bullets of a shooter in combat
+struct shooter_bullets
+{
+	int shooter;
+	std::vector<BulletsSim::Bullet> bullets;
+};
+
+// everything draw_frame reads of the simulation, the tick publishes it into a triple buffer
+// and frames are drawn from it without the world lock, vectors keep their capacity
+struct render_snapshot
+{
+	unsigned int game_state = START_SCREEN;
+
+	// menu selections
+	unsigned int current_game_state = 0;
+	unsigned int current_level_state = 0;
+	unsigned int current_pause_state = 0;
+	unsigned int current_game_won_state = 2;
+	unsigned int current_game_over_state = 1;
+
+	// camera, in pixels
+	vec2 view_point = {0.f, 0.f};
+	vec2 view_size = {0.f, 0.f};
+
+	CharSim::draw_state char_state = {};
+	std::vector<guard_sprite> wanderers;
+	std::vector<guard_sprite> spotters;
+	std::vector<guard_sprite> shooters;
+	std::vector<shooter_bullets> bullets;
+	Particles::draw_state particles = {};
+	Map::draw_state map = {};
+	Overlay::draw_state overlay = {};
+	Timer::draw_state timer = {};
+};
+
 class World
 {
 private:
 	// screen handle
 	GLFWwindow *m_window;
 	float m_screen_scale;
+	vec2 m_framebuffer_size; // the window isn't resizable, the view is computed from it
 	vec2 m_screen_size;
 	vec2 m_screen_point;
 
@@ -42,6 +108,15 @@ private:
 	GLuint m_frame_buffer;
 	Texture m_screen_tex;
 
+	// textures requested with load_async, decoded on m_decode_jobs and uploaded by draw_frame,
+	// a separate pool so parallel_for and the tick graph never run a decode while they wait
+	JobSystem m_decode_jobs;
+	TextureLoader m_texture_loader;
+	// data/textures.pak from chameleon_asset_pack, optional
+	AssetArchive m_texture_archive;
+	// every entity's textures, shared by path and deleted once idle
+	TextureManager m_textures;
+
 	// sound
 	Mix_Music *m_background_music;
 	Mix_Chunk *m_sfx_alert;
@@ -74,6 +149,48 @@ private:
 	std::vector<Spotter> m_spotters;
 	std::vector<Wanderer> m_wanderers;
 
+	// cache of guard boxes for the broadphase, scheduler and culling, the guards own the state
+	BroadphaseCache m_broadphase_cache;
+	std::vector<int> m_draw_list;
+
+	// broadphase, guards stay inserted between ticks, wanderers and bullets are reinserted
+	SpatialGrid m_grid;
+	std::vector<grid_entry> m_grid_hits;
+	float m_wanderer_reach; // largest Char::get_range(w, 1.f)
+	unsigned int m_grid_guard_revision; // BroadphaseCache revision the grid was built from
+	unsigned int m_grid_level_revision; // LevelGrid revision the grid was sized for
+
+	// guard update rate by distance
+	AiScheduler m_ai_scheduler;
+
+	// parallel simulation phases, per wanderer results are merged in index order
+	JobSystem m_jobs;
+	JobGraph m_tick_graph;
+	std::vector<int> m_wanderer_runs;
+	std::vector<float> m_wanderer_ms;
+	std::vector<char> m_wanderer_seen;
+
+	// positions before the last update, draw(alpha) blends them with the current ones
+	vec2 m_prev_char_position;
+	std::vector<vec2> m_prev_wanderer_positions;
+
+	// on-demand rendering of the static screens
+	std::atomic<bool> m_redraw_requested; // also set by the expose callback while a tick runs
+	unsigned int m_drawn_state;
+
+	// threaded mode, the world lock is held for a whole tick and for sync_level, frames are
+	// drawn from the last published snapshot while the next tick runs
+	bool m_threaded;
+	bool m_on_sim_thread; // set while the simulation thread runs a tick
+	bool m_reset_pending; // reset requested during a tick, done on the render thread
+	std::atomic<int> m_sim_tick; // ticks published by the simulation thread
+	int m_drawn_tick;
+	std::thread m_sim_thread;
+	std::atomic<bool> m_sim_running;
+	std::mutex m_world_mutex;
+	SpscQueue<input_event, 256> m_input_queue;
+	TripleBuffer<render_snapshot> m_snapshots; // published under the world lock, read by the GL thread
+
 	// movement control
 	unsigned int m_control; // 0: wasd, 1: arrow keys
 
@@ -105,142 +222,88 @@ private:
 	bool m_spawn_particles;
 	bool m_paused;
 
-	// wanderer checkpoint level 1
-	vector<vector<vec2>> wanderer_paths_level_1 =
-	{
-	{{3,6}, {5,6}, {5,12}, {3,12}},
-	{{7,6}, {9,6}, {9,12}, {7,12}},
-	{{6,6}, {6,36}},
-	{{18,6}, {18,36}},
-	{{30,6}, {30,36}},
-	{{3,9}, {33,9}},
-	{{3,21}, {33,21}},
-	{{33,33}, {3,33}},
-	{{15,6}, {17,6}, {17,12}, {15,12}},
-	{{19,6}, {21,6}, {21,12}, {19,12}},
-	{{27,6}, {29,6}, {29,12}, {27,12}},
-	{{31,6}, {33,6}, {33,12}, {31,12}},
-	{{3,18}, {5,18}, {5,24}, {3,24}},
-	{{7,18}, {9,18}, {9,24}, {7,24}},
-	{{15,18}, {17,18}, {17,24}, {15,24}},
-	{{19,18}, {21,18}, {21,24}, {19,24}},
-	{{27,18}, {29,18}, {29,24}, {27,24}},
-	{{31,18}, {33,18}, {33,24}, {31,24}},
-	{{15,30}, {17,30}, {17,36}, {15,36}},
-	{{19,30}, {21,30}, {21,36}, {19,36}},
-	{{27,30}, {29,30}, {29,36}, {27,36}},
-	{{31,30}, {33,30}, {33,36}, {31,36}},
-	};
-
-	// wanderer checkpoint level 2
-	vector<vector<vec2>> wanderer_paths_level_2 =
-	{
-	{{10,7}, {49,7}, {49,32}, {10,32}},
-	{{49,7}, {49,32}, {10,32}, {10,7}},
-	{{49,32}, {10,32}, {10,7}, {49,7}},
-	{{10,25}, {10,7}, {49,7}, {49,32}, {10,32}},
-	{{19,7}, {19,27}},
-	{{25,7}, {25,24}},
-	{{31,7}, {31,32}},
-	{{43,7}, {43,16}},
-	{{43,20}, {43,32}},
-	{{16,12}, {25,12}, {25,15}, {16,15}},
-	{{16,24}, {24,24}, {24,27}, {16,27}},
-	{{31,25}, {38,25}, {38,32}, {31,32}},
-	{{42,14}, {49,14}, {49,20}, {42,20}},
-	{{43,24}, {49,24}, {49,32}, {43,32}}
-	};
-
-	// wanderer checkpoint
-	vector<vector<vec2>> wanderer_paths =
-	{ {{6,6}, {6,2}, {1,2}, {1,6}},
-	{{8,6}, {8,2}, {16,2}, {16,6}},
-	{{6,11}, {1,11}, {1,9}, {6,9}},
-	{{8,11}, {8,9}, {13,9}, {13,11}},
-	{{1,14}, {16,14}},
-	{{1,17}, {12,18}},
-	{{20,18}, {31,25}, {41,16}, {32,25}},
-	{{18,22}, {31,28}, {34,28}, {42,20}, {34,28}, {30,28}},
-	{{19,38}, {19,27}, {11,27}, {11,38}},
-	{{22,38}, {58,37}},
-	{{45,26}, {45,18}, {52,18}, {52,26}},
-	{{19,2}, {19,15}},
-	{{23,2}, {48,3}},
-	{{39,15}, {39,7}, {51,7}, {51,15}},
-	{{35,12}, {23,12}, {23,15}, {29,20}, {33,20}, {36,15}} };
-
-	vector<vector<vec2>> wanderer_paths_2 =
-	{
-		{{1,8}, {10,8}},
-		{{1,11}, {10,11}},
-		{{1,14}, {10,14}},
-		{{1,17}, {10,17}},
-		{{1,20}, {10,20}},
-		{{1,23}, {10,23}},
-		{{1,26}, {10,26}},
-		{{1,29}, {10,29}},
-		{{1,32}, {10,32}},
-		{{1,35}, {10,35}},
-		{{12,9}, {22,9}},
-		{{12,12}, {22,12}},
-		{{12,15}, {22,15}},
-		{{12,18}, {22,18}},
-		{{12,21}, {22,21}},
-		{{12,24}, {22,24}},
-		{{12,27}, {22,27}},
-		{{12,30}, {22,30}},
-		{{12,33}, {22,33}},
-		{{23,36}, {23,38}, {16,38}, {16,36}},
-		{{24,2}, {24,16}},
-		{{34,8}, {26,8}, {26,6}, {34,6}},
-		{{24,17}, {32,17}, {32,23}, {24,23}},
-		{{41,27}, {41,32}},
-		{{43, 8}, {43, 14}},
-		{{45,36}, {53,36}, {53,38}, {45,38}},
-		{{58,36}, {58,10}},
-		{{38,2}, {46,2}, {46,11}, {49,11}, {49,16}, {49,11}, {46,11}, {46,2}}
-	};
-
-	vector<vector<vec2>> wanderer_paths_3 =
-	{ { {1, 6}, { 12,7 }},
-	{{1,10}, {10,11}, {11,17}, {10,11}},
-	{{1,18}, {1,23}, {8,23}, {8,18}},
-	{{14,2}, {14,10}, {18,10}, {18,2}},
-	{{20,10}, {21,3}},
-	{{30,5}, {42,2}},
-	{{44,2}, {56,3}},
-	{{40,14}, {41,7}, {58,6}, {41,7}},
-	{{55,28}, {55,19}, {58,19}, {58,28}},
-	{{45,35}, {58,38}, {58,35}, {52,35}},
-	{{27,38}, {41,37}},
-	{{24,30}, {41,29}},
-	{{24,25}, {35,26}},
-	{{19,22}, {33,21}, {34,17}, {33,21}},
-	{{15,25}, {15,29}, {22,29}, {22,25}},
-	{{4,35}, {14,37}, {16,33}, {19,32}, {16,33}, {14,37}} };
-
 public:
 	World();
 	~World();
 
-	bool init();
+	// a hidden window still gets a full GL context, used by the headless benchmark
+	bool init(bool visible = true);
 	void destroy();
 	bool update(float ms);
-	void draw();
+	void set_vsync(bool enabled);
+	// seconds a texture without handles stays loaded
+	void set_texture_idle_time(float seconds);
+	// RGBA bytes of textures without handles kept loaded, least recently used go first
+	void set_texture_budget(size_t bytes);
+
+	// alpha: 0..1 between the previous and the last update, movers are drawn in between
+	void draw(float alpha = 1.f);
+
+	// scripted play: straight into LEVEL_1..LEVEL_5 (spawns follow on the next update) and key input
+	bool start_level(unsigned int level);
+	void inject_key(int key, int action, int mod = 0);
+
+	// plays a generated scenario with the rules of LEVEL_1, false if it doesn't fit the map
+	bool start_scenario(const Scenario &scenario);
+
+	// menus, pause, cutscenes and end screens: nothing animates, only input changes them
+	bool is_static_screen() const;
+	// a static screen only needs a new frame after input, a state change or an expose
+	bool needs_redraw() const;
 	bool is_over() const;
 
+	// textures still decoding, static screens keep redrawing until they're all in
+	int get_pending_textures() const;
+	// textures in data/textures.pak, 0 without one
+	int get_packed_textures() const;
+	texture_residency get_texture_residency() const;
+
+	// ai level of detail
+	void set_ai_budget(const lod_budget &budget);
+	const lod_stats &get_ai_stats() const;
+
+	// per-job wall time of the last simulated tick
+	const std::vector<job_timing> &get_job_timings() const;
+
+	// threaded mode: the simulation ticks on its own thread every tick_ms and the
+	// caller's thread (GL) only calls render_frame, update() and draw() are not used
+	// everything that creates or deletes GL objects waits for sync_level on this thread
+	void start_simulation(float tick_ms);
+	void stop_simulation();
+	bool render_frame();
+
 private:
-	bool spawn_spotter();
-	bool spawn_shooter();
+	bool simulate(float ms);
+	bool sync_level();
+	void draw_frame(const render_snapshot &frame);
+	void publish_snapshot(float alpha = 1.f);
+	void store_previous_positions();
+	void simulation_loop(float tick_ms);
+
+	bool spawn_spotter(vec2 position);
+	bool spawn_shooter(vec2 position);
 
 	bool spawn_wanderer(std::vector<vec2> path);
+	bool spawn_level_guards();
 
 	void on_key(GLFWwindow *, int key, int, int action, int mod);
 	void on_mouse_move(GLFWwindow *window, double xpos, double ypos);
 
 	bool is_char_detectable();
 
-	mat3 calculateProjectionMatrix(int width, int height);
+	// broadphase cache systems
+	void sync_wanderers();
+	void collect_guards(int guard_type, std::vector<guard_sprite> &out);
+	void draw_guards(int guard_type, const render_snapshot &frame, const mat3 &projection);
+
+	// broadphase, the whole grid only when guards or the level change, wanderers every tick
+	bool grid_is_stale() const;
+	void rebuild_grid();
+	void insert_wanderers();
+
+	// the camera follows the char in levels, the ai scheduler reads it too
+	void update_view(vec2 char_position);
+	mat3 calculateProjectionMatrix(vec2 view_point, vec2 view_size) const;
 
 	// cutscene caller
 	void advance_to_cutscene();
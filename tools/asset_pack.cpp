@@ -0,0 +1,80 @@
+// packs textures into one archive of decoded RGBA8, Texture::load_from_file reads
+// names from it before falling back to the PNG files
+//
+// chameleon_asset_pack [--mips] --root dir --out file name...
+//
+// names are relative to the root, e.g.
+// chameleon_asset_pack --root data/textures --out data/textures.pak char.png cutscenes/story/1.png
+//
+// the archive wins over the PNGs, repack after editing a texture (the chameleon_assets
+// target does)
+
+// internal
+#include "asset_archive.hpp"
+
+#define STB_IMAGE_IMPLEMENTATION
+#include "../ext/stb_image/stb_image.h"
+
+// stdlib
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+int main(int argc, char *argv[])
+{
+	bool mips = false;
+	const char *root = nullptr;
+	const char *out = nullptr;
+	std::vector<const char *> names;
+	for (int i = 1; i < argc; i++)
+	{
+		bool has_value = i + 1 < argc;
+		if (strcmp(argv[i], "--mips") == 0)
+			mips = true;
+		else if (strcmp(argv[i], "--root") == 0 && has_value)
+			root = argv[++i];
+		else if (strcmp(argv[i], "--out") == 0 && has_value)
+			out = argv[++i];
+		else if (strncmp(argv[i], "--", 2) == 0)
+		{
+			fprintf(stderr, "Unknown argument %s\n", argv[i]);
+			return EXIT_FAILURE;
+		}
+		else
+			names.push_back(argv[i]);
+	}
+
+	if (root == nullptr || out == nullptr)
+	{
+		fprintf(stderr, "usage: chameleon_asset_pack [--mips] --root dir --out file name...\n");
+		return EXIT_FAILURE;
+	}
+
+	std::vector<archive_source> sources(names.size());
+	size_t bytes = 0;
+	for (size_t i = 0; i < names.size(); i++)
+	{
+		archive_source &source = sources[i];
+		source.name = names[i];
+		std::string path = std::string(root) + "/" + source.name;
+
+		stbi_uc *pixels = stbi_load(path.c_str(), &source.width, &source.height, nullptr, 4);
+		if (pixels == nullptr)
+		{
+			fprintf(stderr, "Failed to decode %s\n", path.c_str());
+			return EXIT_FAILURE;
+		}
+		source.pixels.assign(pixels, pixels + (size_t)source.width * source.height * 4);
+		stbi_image_free(pixels);
+		bytes += source.pixels.size();
+	}
+
+	if (!AssetArchive::write(out, sources, mips))
+		return EXIT_FAILURE;
+
+	printf("%s: %d textures, %.1f MB of RGBA%s\n", out, (int)sources.size(), bytes / (1024.0 * 1024.0),
+		   mips ? " before mips" : "");
+	return EXIT_SUCCESS;
+}
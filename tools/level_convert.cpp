@@ -0,0 +1,37 @@
+// exports the built-in levels as binary level files, LevelGrid maps them from data/levels
+//
+// chameleon_level_convert [out_dir]
+//
+// edit builtin_levels.cpp or the exported files directly, the game picks up the files
+// without a rebuild
+
+// internal
+#include "builtin_levels.hpp"
+#include "constants.hpp"
+#include "project_path.hpp"
+
+// stdlib
+#include <cstdio>
+#include <cstdlib>
+
+int main(int argc, char *argv[])
+{
+	const char *out_dir = argc > 1 ? argv[1] : PROJECT_SOURCE_DIR "./data/levels";
+	const unsigned int levels[] = {LEVEL_TUTORIAL, LEVEL_1, LEVEL_2, LEVEL_3, LEVEL_4, LEVEL_5};
+
+	for (unsigned int level : levels)
+	{
+		level_source source;
+		if (!builtin_level((int)level, source))
+			return EXIT_FAILURE;
+
+		char path[1024];
+		snprintf(path, sizeof(path), "%s/%u.lvl", out_dir, level);
+		if (!LevelFile::write(path, source))
+			return EXIT_FAILURE;
+
+		printf("%s: %dx%d, %d spotters, %d shooters, %d wanderers\n", path, source.width, source.height,
+			   (int)source.spotters.size(), (int)source.shooters.size(), (int)source.patrols.size());
+	}
+	return EXIT_SUCCESS;
+}
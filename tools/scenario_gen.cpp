@@ -0,0 +1,79 @@
+// writes a procedurally generated stress scenario for chameleon and chameleon_bench --scenario
+//
+// chameleon_scenario_gen [--width tiles] [--height tiles] [--guards N] [--seed N] --out file
+//
+// width and height are 1..Scenario::MAX_SIZE (4096), guards 0..Scenario::MAX_GUARDS (100000)
+//
+// e.g. chameleon_scenario_gen --width 1024 --height 1024 --guards 4000 --out big.scenario
+
+// internal
+#include "scenario.hpp"
+
+// stdlib
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+// whole argument as a number in [min, max]
+bool parse_int(const char *arg, int min, int max, int &out)
+{
+	char *end;
+	long value = strtol(arg, &end, 10);
+	if (end == arg || *end != '\0' || value < min || value > max)
+		return false;
+	out = (int)value;
+	return true;
+}
+
+void print_usage(const char *program)
+{
+	fprintf(stderr, "Usage: %s [--width 1-%d] [--height 1-%d] [--guards 0-%d] [--seed N] --out file\n", program,
+			Scenario::MAX_SIZE, Scenario::MAX_SIZE, Scenario::MAX_GUARDS);
+}
+
+int main(int argc, char *argv[])
+{
+	scenario_options options;
+	const char *out = nullptr;
+	for (int i = 1; i < argc; i++)
+	{
+		bool has_value = i + 1 < argc;
+		bool valid = true;
+		if (strcmp(argv[i], "--width") == 0 && has_value)
+			valid = parse_int(argv[++i], 1, Scenario::MAX_SIZE, options.width);
+		else if (strcmp(argv[i], "--height") == 0 && has_value)
+			valid = parse_int(argv[++i], 1, Scenario::MAX_SIZE, options.height);
+		else if (strcmp(argv[i], "--guards") == 0 && has_value)
+			valid = parse_int(argv[++i], 0, Scenario::MAX_GUARDS, options.guards);
+		else if (strcmp(argv[i], "--seed") == 0 && has_value)
+			options.seed = (unsigned int)strtoul(argv[++i], nullptr, 10);
+		else if (strcmp(argv[i], "--out") == 0 && has_value)
+			out = argv[++i];
+		else
+		{
+			fprintf(stderr, "Unknown argument %s\n", argv[i]);
+			return EXIT_FAILURE;
+		}
+
+		if (!valid)
+		{
+			fprintf(stderr, "Bad value for %s: %s\n", argv[i - 1], argv[i]);
+			print_usage(argv[0]);
+			return EXIT_FAILURE;
+		}
+	}
+
+	if (out == nullptr)
+	{
+		print_usage(argv[0]);
+		return EXIT_FAILURE;
+	}
+
+	Scenario scenario;
+	if (!scenario.generate(options) || !scenario.save(out))
+		return EXIT_FAILURE;
+
+	printf("%s: %dx%d tiles, %d wanderers, %d spotters, %d shooters\n", out, scenario.get_width(), scenario.get_height(),
+		   (int)scenario.get_patrols().size(), (int)scenario.get_spotters().size(), (int)scenario.get_shooters().size());
+	return EXIT_SUCCESS;
+}